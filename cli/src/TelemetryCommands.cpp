@@ -0,0 +1,161 @@
+/*
+ * TelemetryCommands.cpp - implementation of TelemetryCommands class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLocalSocket>
+
+#include "TelemetryCommands.h"
+#include "VariantArrayMessage.h"
+
+
+TelemetryCommands::TelemetryCommands( QObject* parent ) :
+	QObject( parent ),
+	m_commands( {
+		{ QStringLiteral("dump"), tr( "Dump the VNC connection telemetry of the running %1 Master of the current user "
+									  "as JSON to the console or to a file. Arguments: [OUTPUT-FILE]" ).
+									  arg( VeyonCore::applicationName() ) },
+		{ QStringLiteral("enable"), tr( "Enable collecting VNC connection telemetry in the running %1 Master "
+										"of the current user" ).arg( VeyonCore::applicationName() ) },
+		{ QStringLiteral("disable"), tr( "Disable collecting VNC connection telemetry in the running %1 Master "
+										 "of the current user" ).arg( VeyonCore::applicationName() ) },
+		} )
+{
+}
+
+
+
+QStringList TelemetryCommands::commands() const
+{
+	return m_commands.keys();
+}
+
+
+
+QString TelemetryCommands::commandHelp( const QString& command ) const
+{
+	return m_commands.value( command );
+}
+
+
+
+CommandLinePluginInterface::RunResult TelemetryCommands::handle_dump( const QStringList& arguments )
+{
+	bool enabled = false;
+	QByteArray dump;
+
+	if( sendCommand( VncConnectionTelemetry::IpcCommand::Dump, &enabled, &dump ) == false )
+	{
+		return Failed;
+	}
+
+	if( enabled == false )
+	{
+		warning( tr( "Telemetry collection is disabled - the dumped counters are not updated." ) );
+	}
+
+	if( arguments.isEmpty() )
+	{
+		print( QString::fromUtf8( dump ) );
+		return Successful;
+	}
+
+	QFile outputFile( arguments.first() );
+	if( outputFile.open( QFile::WriteOnly | QFile::Truncate ) == false ||
+		outputFile.write( dump ) != dump.size() )
+	{
+		error( tr( "Could not write file \"%1\"!" ).arg( outputFile.fileName() ) );
+		return Failed;
+	}
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TelemetryCommands::handle_enable( const QStringList& arguments )
+{
+	Q_UNUSED(arguments)
+
+	bool enabled = false;
+
+	return ( sendCommand( VncConnectionTelemetry::IpcCommand::Enable, &enabled, nullptr ) && enabled ) ? Successful : Failed;
+}
+
+
+
+CommandLinePluginInterface::RunResult TelemetryCommands::handle_disable( const QStringList& arguments )
+{
+	Q_UNUSED(arguments)
+
+	bool enabled = true;
+
+	return ( sendCommand( VncConnectionTelemetry::IpcCommand::Disable, &enabled, nullptr ) && enabled == false ) ? Successful : Failed;
+}
+
+
+
+bool TelemetryCommands::sendCommand( VncConnectionTelemetry::IpcCommand command, bool* enabled, QByteArray* dump )
+{
+	QLocalSocket socket;
+	socket.connectToServer( VncConnectionTelemetry::ipcServerName() );
+
+	if( socket.waitForConnected( ConnectTimeout ) == false )
+	{
+		error( tr( "Could not connect to a running %1 Master of the current user!" ).arg( VeyonCore::applicationName() ) );
+		return false;
+	}
+
+	VariantArrayMessage request( &socket );
+	request.write( static_cast<int>( command ) );
+	request.send();
+	socket.flush();
+
+	QElapsedTimer responseTimer;
+	responseTimer.start();
+
+	VariantArrayMessage response( &socket );
+	while( response.isReadyForReceive() == false &&
+		   responseTimer.elapsed() < ResponseTimeout &&
+		   socket.state() == QLocalSocket::ConnectedState )
+	{
+		socket.waitForReadyRead( ConnectTimeout );
+	}
+
+	if( response.isReadyForReceive() == false || response.receive() == false )
+	{
+		error( tr( "No response from %1 Master!" ).arg( VeyonCore::applicationName() ) );
+		return false;
+	}
+
+	*enabled = response.read().toBool();
+
+	const auto data = response.read().toByteArray();
+	if( dump )
+	{
+		*dump = data;
+	}
+
+	return true;
+}
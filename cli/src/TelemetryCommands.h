@@ -0,0 +1,95 @@
+/*
+ * TelemetryCommands.h - declaration of TelemetryCommands class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "CommandLinePluginInterface.h"
+#include "CommandLineIO.h"
+#include "VncConnectionTelemetry.h"
+
+class TelemetryCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
+{
+	Q_OBJECT
+	Q_INTERFACES(PluginInterface CommandLinePluginInterface)
+public:
+	explicit TelemetryCommands( QObject* parent = nullptr );
+	~TelemetryCommands() override = default;
+
+	Plugin::Uid uid() const override
+	{
+		return QStringLiteral("e4a6a9b2-6f0c-4d55-b3e8-2c3f0a7d91c4");
+	}
+
+	QVersionNumber version() const override
+	{
+		return QVersionNumber( 1, 0 );
+	}
+
+	QString name() const override
+	{
+		return QStringLiteral( "Telemetry" );
+	}
+
+	QString description() const override
+	{
+		return tr( "Telemetry-related CLI operations" );
+	}
+
+	QString vendor() const override
+	{
+		return QStringLiteral( "Veyon Community" );
+	}
+
+	QString copyright() const override
+	{
+		return QStringLiteral( "Tobias Junghans" );
+	}
+
+	QString commandLineModuleName() const override
+	{
+		return QStringLiteral( "telemetry" );
+	}
+
+	QString commandLineModuleHelp() const override
+	{
+		return tr( "Commands for accessing the VNC connection telemetry of a running %1 Master" ).arg( VeyonCore::applicationName() );
+	}
+
+	QStringList commands() const override;
+	QString commandHelp( const QString& command ) const override;
+
+public Q_SLOTS:
+	CommandLinePluginInterface::RunResult handle_dump( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_enable( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_disable( const QStringList& arguments );
+
+private:
+	static constexpr int ConnectTimeout = 1000;
+	static constexpr int ResponseTimeout = 10000;
+
+	bool sendCommand( VncConnectionTelemetry::IpcCommand command, bool* enabled, QByteArray* dump );
+
+	const QMap<QString, QString> m_commands;
+
+};
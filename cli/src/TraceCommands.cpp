@@ -0,0 +1,86 @@
+/*
+ * TraceCommands.cpp - implementation of TraceCommands class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QFile>
+
+#include "TraceCommands.h"
+#include "TraceLog.h"
+
+
+TraceCommands::TraceCommands( QObject* parent ) :
+	QObject( parent ),
+	m_commands( {
+		{ QStringLiteral("convert"), tr( "Convert a binary trace file (written when %1 is set) to the Chrome trace event "
+										 "format (JSON) for inspection in chrome://tracing or Perfetto. "
+										 "Arguments: INPUT-FILE OUTPUT-FILE" ).
+										 arg( QLatin1String( TraceLog::directoryEnvironmentVariable() ) ) },
+		} )
+{
+}
+
+
+
+QStringList TraceCommands::commands() const
+{
+	return m_commands.keys();
+}
+
+
+
+QString TraceCommands::commandHelp( const QString& command ) const
+{
+	return m_commands.value( command );
+}
+
+
+
+CommandLinePluginInterface::RunResult TraceCommands::handle_convert( const QStringList& arguments )
+{
+	if( arguments.count() < 2 )
+	{
+		return NotEnoughArguments;
+	}
+
+	QFile inputFile( arguments[0] );
+	if( inputFile.open( QFile::ReadOnly ) == false )
+	{
+		error( tr( "Could not open file \"%1\" for reading!" ).arg( inputFile.fileName() ) );
+		return Failed;
+	}
+
+	QFile outputFile( arguments[1] );
+	if( outputFile.open( QFile::WriteOnly | QFile::Truncate ) == false )
+	{
+		error( tr( "Could not open file \"%1\" for writing!" ).arg( outputFile.fileName() ) );
+		return Failed;
+	}
+
+	if( TraceLog::convertToChromeTraceFormat( &inputFile, &outputFile ) == false )
+	{
+		error( tr( "Could not convert trace file \"%1\"!" ).arg( inputFile.fileName() ) );
+		return Failed;
+	}
+
+	return Successful;
+}
@@ -0,0 +1,87 @@
+/*
+ * TraceCommands.h - declaration of TraceCommands class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "CommandLinePluginInterface.h"
+#include "CommandLineIO.h"
+
+class TraceCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
+{
+	Q_OBJECT
+	Q_INTERFACES(PluginInterface CommandLinePluginInterface)
+public:
+	explicit TraceCommands( QObject* parent = nullptr );
+	~TraceCommands() override = default;
+
+	Plugin::Uid uid() const override
+	{
+		return QStringLiteral("5d0bcba4-2ec1-4a2f-9a8e-3f4f1b1a9d6e");
+	}
+
+	QVersionNumber version() const override
+	{
+		return QVersionNumber( 1, 0 );
+	}
+
+	QString name() const override
+	{
+		return QStringLiteral( "Trace" );
+	}
+
+	QString description() const override
+	{
+		return tr( "Trace-related CLI operations" );
+	}
+
+	QString vendor() const override
+	{
+		return QStringLiteral( "Veyon Community" );
+	}
+
+	QString copyright() const override
+	{
+		return QStringLiteral( "Tobias Junghans" );
+	}
+
+	QString commandLineModuleName() const override
+	{
+		return QStringLiteral( "trace" );
+	}
+
+	QString commandLineModuleHelp() const override
+	{
+		return tr( "Commands for processing binary trace files" );
+	}
+
+	QStringList commands() const override;
+	QString commandHelp( const QString& command ) const override;
+
+public Q_SLOTS:
+	CommandLinePluginInterface::RunResult handle_convert( const QStringList& arguments );
+
+private:
+	const QMap<QString, QString> m_commands;
+
+};
@@ -30,6 +30,8 @@
 #include "Logger.h"
 #include "PluginsCommands.h"
 #include "PluginManager.h"
+#include "TelemetryCommands.h"
+#include "TraceCommands.h"
 
 
 int main( int argc, char **argv )
@@ -82,6 +84,8 @@ int main( int argc, char **argv )
 	auto core = new VeyonCore( app, VeyonCore::Component::CLI, QStringLiteral("CLI") );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new ConfigCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new PluginsCommands( core ) );
+	VeyonCore::pluginManager().registerExtraPluginInterface( new TelemetryCommands( core ) );
+	VeyonCore::pluginManager().registerExtraPluginInterface( new TraceCommands( core ) );
 
 	QHash<CommandLinePluginInterface *, QObject *> commandLinePluginInterfaces;
 	const auto pluginObjects = VeyonCore::pluginManager().pluginObjects();
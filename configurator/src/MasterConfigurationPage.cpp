@@ -41,6 +41,8 @@ MasterConfigurationPage::MasterConfigurationPage( QWidget* parent ) :
 {
 	ui->setupUi(this);
 
+	Configuration::UiMapping::setFlags( ui->wakeOnLanGroupBox, Configuration::Property::Flag::Advanced );
+
 	connect( ui->openUserConfigurationDirectory, &QPushButton::clicked,
 			 this, &MasterConfigurationPage::openUserConfigurationDirectory );
 
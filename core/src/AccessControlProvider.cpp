@@ -28,6 +28,7 @@
 #include "UserGroupsBackendManager.h"
 #include "AccessControlProvider.h"
 #include "HostAddress.h"
+#include "HostResolver.h"
 #include "NetworkObjectDirectory.h"
 #include "NetworkObjectDirectoryManager.h"
 #include "VeyonConfiguration.h"
@@ -88,6 +89,10 @@ QStringList AccessControlProvider::locationsOfComputer( const QString& computer
 		return {};
 	}
 
+	// network objects with IP addresses are compared using cached lookups only so make sure
+	// the IP address is available (see resolveComputer() for callers which must not block)
+	HostAddress( fqdn ).convert( HostAddress::Type::IpAddress );
+
 	const auto computers = m_networkObjectDirectory->queryObjects( NetworkObject::Type::Host,
 																   NetworkObject::Property::HostAddress, fqdn );
 	if( computers.isEmpty() )
@@ -117,6 +122,33 @@ QStringList AccessControlProvider::locationsOfComputer( const QString& computer
 
 
 
+bool AccessControlProvider::resolveComputer( const QString& computer, QObject* context, const std::function<void()>& callback )
+{
+	auto& resolver = VeyonCore::hostResolver();
+	const auto notify = [callback]( const QString& ) { callback(); };
+
+	// locations are looked up via the FQDN while the FQDN is converted to the IP address
+	// when comparing it with the host addresses of network objects
+	QString fqdn;
+	if( resolver.lookupCache( computer, HostAddress::Type::FullyQualifiedDomainName, &fqdn ) == false )
+	{
+		resolver.tryConvert( computer, HostAddress::Type::FullyQualifiedDomainName, context, notify );
+		return false;
+	}
+
+	QString ipAddress;
+	if( fqdn.isEmpty() == false &&
+		resolver.lookupCache( fqdn, HostAddress::Type::IpAddress, &ipAddress ) == false )
+	{
+		resolver.tryConvert( fqdn, HostAddress::Type::IpAddress, context, notify );
+		return false;
+	}
+
+	return true;
+}
+
+
+
 AccessControlProvider::Access AccessControlProvider::checkAccess( const QString& accessingUser,
 																  const QString& accessingComputer,
 																  const QStringList& connectedUsers,
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "AccessControlRule.h"
 #include "NetworkObject.h"
 #include "Plugin.h"
@@ -49,6 +51,10 @@ public:
 	Access checkAccess( const QString& accessingUser, const QString& accessingComputer,
 						const QStringList& connectedUsers, Plugin::Uid authMethodUid );
 
+	// returns false if checking access for the given computer would block for DNS lookups - these
+	// are started in the background and callback is invoked in the thread of context once finished
+	static bool resolveComputer( const QString& computer, QObject* context, const std::function<void()>& callback );
+
 	bool processAuthorizedGroups( const QString& accessingUser );
 
 	AccessControlRule::Action processAccessControlRules( const QString& accessingUser,
@@ -118,6 +118,15 @@ void ComputerControlInterface::stop()
 
 	if( m_vncConnection )
 	{
+		if( VncConnection::isTelemetryEnabled() )
+		{
+			// connected times of subsequent connections add up
+			const auto telemetry = m_vncConnection->telemetry();
+			const auto connectedTime = m_telemetry.connectedTime + telemetry.connectedTime;
+			m_telemetry += telemetry;
+			m_telemetry.connectedTime = connectedTime;
+		}
+
 		// do not delete VNC connection but let it delete itself after stopping automatically
 		m_vncConnection->stopAndDeleteLater();
 		m_vncConnection = nullptr;
@@ -186,6 +195,35 @@ QImage ComputerControlInterface::screen() const
 
 
 
+VncConnection::LinkStatistics ComputerControlInterface::linkStatistics() const
+{
+	if( m_vncConnection && m_vncConnection->isConnected() )
+	{
+		return m_vncConnection->linkStatistics();
+	}
+
+	return {};
+}
+
+
+
+VncConnectionTelemetry ComputerControlInterface::telemetry() const
+{
+	auto telemetry = m_telemetry;
+
+	if( m_vncConnection )
+	{
+		const auto connectionTelemetry = m_vncConnection->telemetry();
+		const auto connectedTime = telemetry.connectedTime + connectionTelemetry.connectedTime;
+		telemetry += connectionTelemetry;
+		telemetry.connectedTime = connectedTime;
+	}
+
+	return telemetry;
+}
+
+
+
 void ComputerControlInterface::setUserInformation( const QString& userLoginName, const QString& userFullName, int sessionId )
 {
 	if( userLoginName != m_userLoginName ||
@@ -90,6 +90,10 @@ public:
 
 	QImage screen() const;
 
+	VncConnection::LinkStatistics linkStatistics() const;
+
+	VncConnectionTelemetry telemetry() const;
+
 	int timestamp() const
 	{
 		return m_timestamp;
@@ -174,6 +178,9 @@ private:
 	QSize m_scaledScreenSize;
 	int m_timestamp{0};
 
+	// telemetry of previous connections
+	VncConnectionTelemetry m_telemetry{};
+
 	VncConnection* m_vncConnection;
 	VeyonConnection* m_connection;
 	QTimer m_connectionWatchdogTimer;
@@ -87,7 +87,9 @@ void JsonStore::load( Object* obj )
 
 	QJsonDocument jsonDoc = QJsonDocument::fromJson( jsonFile.readAll() );
 
+	obj->beginUpdate();
 	loadJsonTree( obj, jsonDoc.object(), {} );
+	obj->endUpdate();
 }
 
 
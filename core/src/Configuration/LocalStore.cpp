@@ -91,7 +91,9 @@ static void loadSettingsTree( Object *obj, QSettings *s,
 void LocalStore::load( Object *obj )
 {
 	auto s = createSettingsObject();
+	obj->beginUpdate();
 	loadSettingsTree( obj, s, {} );
+	obj->endUpdate();
 	delete s;
 }
 
@@ -87,6 +87,7 @@ Object& Object::operator=( const Object& ref )
 	}
 
 	m_data = ref.data();
+	updateFlatData();
 
 	return *this;
 }
@@ -115,6 +116,7 @@ static Object::DataMap operator+( Object::DataMap dst, Object::DataMap src )
 Object& Object::operator+=( const Object& ref )
 {
 	m_data = m_data + ref.data();
+	updateFlatData();
 
 	return *this;
 }
@@ -123,116 +125,92 @@ Object& Object::operator+=( const Object& ref )
 
 bool Object::hasValue( const QString& key, const QString& parentKey ) const
 {
-	// empty parentKey?
-	if( parentKey.isEmpty() )
-	{
-		// search for key in toplevel data map
-		return m_data.contains( key );
-	}
+	return flatData()->contains( absoluteKey( key, parentKey ) );
+}
 
-	// recursively search through data maps and sub data-maps until
-	// all levels of the parentKey are processed
-	const QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap currentMap = m_data;
 
-	for( const auto& level : subLevels )
-	{
-		if( currentMap.contains( level ) &&
-				currentMap[level].type() == QVariant::Map )
-		{
-			currentMap = currentMap[level].toMap();
-		}
-		else
-		{
-			return false;
-		}
-	}
 
-	// ok, we're there - does the current submap then contain our key?
-	return currentMap.contains( key );
-}
 
+QVariant Object::value( const QString& key, const QString& parentKey, const QVariant& defaultValue ) const
+{
+	return valueByAbsoluteKey( absoluteKey( key, parentKey ), defaultValue );
+}
 
 
 
-QVariant Object::value( const QString& key, const QString& parentKey, const QVariant& defaultValue ) const
+QVariant Object::valueByAbsoluteKey( const QString& absoluteKey, const QVariant& defaultValue ) const
 {
-	// empty parentKey?
-	if( parentKey.isEmpty() )
-	{
-		// search for key in toplevel data map
-		if( m_data.contains( key ) )
-		{
-			return m_data[key];
-		}
-		return defaultValue;
-	}
+	const auto snapshot = flatData();
 
-	// recursively search through data maps and sub data-maps until
-	// all levels of the parentKey are processed
-	const QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap currentMap = m_data;
-	for( const auto& level : subLevels )
+	const auto it = snapshot->constFind( absoluteKey );
+	if( it != snapshot->constEnd() )
 	{
-		if( currentMap.contains( level ) &&
-				currentMap[level].type() == QVariant::Map )
-		{
-			currentMap = currentMap[level].toMap();
-		}
-		else
-		{
-			return defaultValue;
-		}
+		return it.value();
 	}
 
-	// ok, we're there - does the current submap then contain our key?
-	if( currentMap.contains( key ) )
-	{
-		return currentMap[key];
-	}
 	return defaultValue;
 }
 
 
 
 
-static Object::DataMap setValueRecursive( Object::DataMap data,
-										  QStringList subLevels,
-										  const QString& key,
-										  const QVariant& value )
+static bool setValueRecursive( Object::DataMap& data,
+							   QStringList subLevels,
+							   const QString& key,
+							   const QVariant& value )
 {
 	if( subLevels.isEmpty() )
 	{
 		// search for key in toplevel data map
-		if( !data.contains( key ) || data[key].type() != QVariant::Map )
-		{
-			data[key] = value;
-		}
-		else
+		if( data.value( key ).type() == QVariant::Map )
 		{
 			vWarning() << "cannot replace sub data map with a value!";
+			return false;
 		}
 
-		return data;
+		data[key] = value;
+
+		return true;
 	}
 
 	const QString level = subLevels.takeFirst();
-	if( data.contains( level ) )
+	auto it = data.find( level );
+	if( it == data.end() )
 	{
-		if( data[level].type() != QVariant::Map )
-		{
-			vWarning() << "parent key points doesn't point to a data map!";
-			return data;
-		}
+		it = data.insert( level, Object::DataMap() );
 	}
-	else
+	else if( it.value().type() != QVariant::Map )
+	{
+		vWarning() << "parent key points doesn't point to a data map!";
+		return false;
+	}
+
+	auto subData = it.value().toMap();
+	if( setValueRecursive( subData, subLevels, key, value ) == false )
 	{
-		data[level] = Object::DataMap();
+		return false;
 	}
 
-	data[level] = setValueRecursive( data[level].toMap(), subLevels, key, value );
+	it.value() = subData;
 
-	return data;
+	return true;
+}
+
+
+
+
+static void flattenDataMap( const Object::DataMap& data, const QString& prefix, Object::FlatDataMap& flatData )
+{
+	for( auto it = data.constBegin(), end = data.constEnd(); it != end; ++it )
+	{
+		const auto key = prefix + it.key();
+		flatData[key] = it.value();
+
+		if( it.value().type() == QVariant::Map )
+		{
+			flattenDataMap( it.value().toMap(), key + QLatin1Char('/'), flatData );
+		}
+	}
 }
 
 
@@ -240,14 +218,30 @@ static Object::DataMap setValueRecursive( Object::DataMap data,
 
 void Object::setValue( const QString& key, const QVariant& value, const QString& parentKey )
 {
+	// parentKey is always split into at least one level, i.e. an empty parentKey
+	// refers to a sub data map with an empty name
+	const auto flatKey = parentKey + QLatin1Char('/') + key;
+
+	const auto current = m_flatData.constFind( flatKey );
+	if( current != m_flatData.constEnd() && current.value() == value )
+	{
+		return;
+	}
+
 	// recursively search through data maps and sub data-maps until
 	// all levels of the parentKey are processed
-	QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap data = setValueRecursive( m_data, subLevels, key, value );
-
-	if( data != m_data )
+	const auto subLevels = parentKey.split( QLatin1Char('/') );
+	if( setValueRecursive( m_data, subLevels, key, value ) )
 	{
-		m_data = data;
+		m_flatData[flatKey] = value;
+		if( value.type() == QVariant::Map )
+		{
+			flattenDataMap( value.toMap(), flatKey + QLatin1Char('/'), m_flatData );
+		}
+
+		updateFlatDataLevels( subLevels );
+		publishFlatData();
+
 		Q_EMIT configurationChanged();
 	}
 }
@@ -255,28 +249,29 @@ void Object::setValue( const QString& key, const QVariant& value, const QString&
 
 
 
-static Object::DataMap removeValueRecursive( Object::DataMap data,
-											 QStringList subLevels,
-											 const QString& key )
+static bool removeValueRecursive( Object::DataMap& data,
+								  QStringList subLevels,
+								  const QString& key )
 {
 	if( subLevels.isEmpty() )
 	{
 		// search for key in toplevel data map
-		if( data.contains( key ) )
-		{
-			data.remove( key );
-		}
-
-		return data;
+		return data.remove( key ) > 0;
 	}
 
 	const QString level = subLevels.takeFirst();
-	if( data.contains( level ) && data[level].type() == QVariant::Map )
+	auto it = data.find( level );
+	if( it != data.end() && it.value().type() == QVariant::Map )
 	{
-		data[level] = removeValueRecursive( data[level].toMap(), subLevels, key );
+		auto subData = it.value().toMap();
+		if( removeValueRecursive( subData, subLevels, key ) )
+		{
+			it.value() = subData;
+			return true;
+		}
 	}
 
-	return data;
+	return false;
 }
 
 
@@ -285,11 +280,27 @@ static Object::DataMap removeValueRecursive( Object::DataMap data,
 
 void Object::removeValue( const QString& key, const QString& parentKey )
 {
-	QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap data = removeValueRecursive( m_data, subLevels, key );
-	if( data != m_data )
+	const auto subLevels = parentKey.split( QLatin1Char('/') );
+	if( removeValueRecursive( m_data, subLevels, key ) )
 	{
-		m_data = data;
+		const auto flatKey = parentKey + QLatin1Char('/') + key;
+		const auto flatSubKeyPrefix = flatKey + QLatin1Char('/');
+
+		for( auto it = m_flatData.begin(); it != m_flatData.end(); )
+		{
+			if( it.key() == flatKey || it.key().startsWith( flatSubKeyPrefix ) )
+			{
+				it = m_flatData.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		updateFlatDataLevels( subLevels );
+		publishFlatData();
+
 		Q_EMIT configurationChanged();
 	}
 }
@@ -323,7 +334,70 @@ static void addSubObjectRecursive( const Object::DataMap& dataMap,
 
 void Object::addSubObject( Object* obj, const QString& parentKey )
 {
+	beginUpdate();
 	addSubObjectRecursive( obj->data(), this, parentKey );
+	endUpdate();
+}
+
+
+
+void Object::beginUpdate()
+{
+	++m_updateDepth;
+}
+
+
+
+void Object::endUpdate()
+{
+	if( m_updateDepth > 0 && --m_updateDepth == 0 && m_flatDataModified )
+	{
+		publishFlatData();
+	}
+}
+
+
+
+void Object::updateFlatData()
+{
+	m_flatData.clear();
+	flattenDataMap( m_data, {}, m_flatData );
+
+	publishFlatData();
+}
+
+
+
+void Object::updateFlatDataLevels( const QStringList& subLevels )
+{
+	// refresh entries of all (sub) data maps along the given path
+	QString levelKey;
+	DataMap levelData = m_data;
+
+	for( int i = 0; i < subLevels.count(); ++i )
+	{
+		const auto& level = subLevels[i];
+		levelKey = i == 0 ? level : levelKey + QLatin1Char('/') + level;
+
+		const auto levelValue = levelData.value( level );
+		m_flatData[levelKey] = levelValue;
+		levelData = levelValue.toMap();
+	}
+}
+
+
+
+void Object::publishFlatData()
+{
+	if( m_updateDepth > 0 )
+	{
+		m_flatDataModified = true;
+		return;
+	}
+
+	m_flatDataModified = false;
+
+	std::atomic_store( &m_flatDataSnapshot, std::shared_ptr<const FlatDataMap>( std::make_shared<FlatDataMap>( m_flatData ) ) );
 }
 
 
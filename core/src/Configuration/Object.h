@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "VeyonCore.h"
 #include "Configuration/Store.h"
 
@@ -37,6 +39,7 @@ class VEYON_CORE_EXPORT Object : public QObject
 	Q_OBJECT
 public:
 	using DataMap = QMap<QString, QVariant>;
+	using FlatDataMap = QHash<QString, QVariant>;
 
 	Object() = default;
 	Object( Store::Backend backend, Store::Scope scope, const QString& storeName = {} );
@@ -51,6 +54,9 @@ public:
 
 	QVariant value( const QString& key, const QString& parentKey, const QVariant& defaultValue ) const;
 
+	// lookup of precomputed absolute key (see absoluteKey()) in current flat data snapshot
+	QVariant valueByAbsoluteKey( const QString& absoluteKey, const QVariant& defaultValue ) const;
+
 	void setValue( const QString& key, const QVariant& value, const QString& parentKey );
 
 	void removeValue( const QString& key, const QString& parentKey );
@@ -61,10 +67,17 @@ public:
 	{
 		if( m_store )
 		{
+			beginUpdate();
 			m_store->load( this );
+			endUpdate();
 		}
 	}
 
+	// suspend publishing flat data snapshots while loading many values so readers
+	// never see partially loaded data and the snapshot is copied only once
+	void beginUpdate();
+	void endUpdate();
+
 	void flushStore()
 	{
 		if( m_store )
@@ -81,6 +94,7 @@ public:
 	void clear()
 	{
 		m_data.clear();
+		updateFlatData();
 	}
 
 	const DataMap & data() const
@@ -88,6 +102,21 @@ public:
 		return m_data;
 	}
 
+	std::shared_ptr<const FlatDataMap> flatData() const
+	{
+		return std::atomic_load( &m_flatDataSnapshot );
+	}
+
+	static QString absoluteKey( const QString& key, const QString& parentKey )
+	{
+		if( parentKey.isEmpty() )
+		{
+			return key;
+		}
+
+		return parentKey + QLatin1Char('/') + key;
+	}
+
 
 Q_SIGNALS:
 	void configurationChanged();
@@ -96,10 +125,21 @@ Q_SIGNALS:
 private:
 	static Store* createStore( Store::Backend backend, Store::Scope scope );
 
+	void updateFlatData();
+	void updateFlatDataLevels( const QStringList& subLevels );
+	void publishFlatData();
+
 	Configuration::Store* m_store{nullptr};
 	bool m_customStore{false};
 	DataMap m_data{};
 
+	// flattened copy of m_data with one entry per (sub) key for fast lookups - readers
+	// from other threads only access immutable snapshots which are swapped atomically
+	FlatDataMap m_flatData{};
+	std::shared_ptr<const FlatDataMap> m_flatDataSnapshot{std::make_shared<FlatDataMap>()};
+	int m_updateDepth{0};
+	bool m_flatDataModified{false};
+
 } ;
 
 }
@@ -37,6 +37,7 @@ Configuration::Property::Property( Object* object, const QString& key, const QSt
 	m_proxy( nullptr ),
 	m_key( key ),
 	m_parentKey( parentKey ),
+	m_absoluteKey( Object::absoluteKey( key, parentKey ) ),
 	m_defaultValue( defaultValue ),
 	m_flags( flags )
 {
@@ -51,6 +52,7 @@ Configuration::Property::Property( Proxy* proxy, const QString& key, const QStri
 	m_proxy( proxy ),
 	m_key( key ),
 	m_parentKey( parentKey ),
+	m_absoluteKey( Object::absoluteKey( key, parentKey ) ),
 	m_defaultValue( defaultValue ),
 	m_flags( flags )
 {
@@ -74,7 +76,7 @@ QVariant Property::variantValue() const
 {
 	if( m_object )
 	{
-		return m_object->value( m_key, m_parentKey, m_defaultValue );
+		return m_object->valueByAbsoluteKey( m_absoluteKey, m_defaultValue );
 	}
 
 	if( m_proxy )
@@ -96,14 +96,9 @@ public:
 		return m_parentKey;
 	}
 
-	QString absoluteKey() const
+	const QString& absoluteKey() const
 	{
-		if( m_parentKey.isEmpty() )
-		{
-			return m_key;
-		}
-
-		return m_parentKey + QLatin1Char('/') + m_key;
+		return m_absoluteKey;
 	}
 
 	const QVariant& defaultValue() const
@@ -121,6 +116,7 @@ private:
 	Proxy* m_proxy;
 	const QString m_key;
 	const QString m_parentKey;
+	const QString m_absoluteKey;
 	const QVariant m_defaultValue;
 	const Flags m_flags;
 
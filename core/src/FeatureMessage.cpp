@@ -23,6 +23,7 @@
  */
 
 #include "FeatureMessage.h"
+#include "TraceLog.h"
 #include "VariantArrayMessage.h"
 
 
@@ -36,6 +37,8 @@ bool FeatureMessage::send( QIODevice* ioDevice ) const
 		message.write( m_command );
 		message.write( m_arguments );
 
+		TraceLog::record( TraceLog::Event::FeatureMessageSend, m_featureUid.data1, m_command );
+
 		return message.send();
 	}
 
@@ -65,6 +68,9 @@ bool FeatureMessage::receive( QIODevice* ioDevice )
 			m_featureUid = message.read().toUuid(); // Flawfinder: ignore
 			m_command = message.read().value<Command>(); // Flawfinder: ignore
 			m_arguments = message.read().toMap(); // Flawfinder: ignore
+
+			TraceLog::record( TraceLog::Event::FeatureMessageReceive, m_featureUid.data1, m_command );
+
 			return true;
 		}
 
@@ -53,10 +53,10 @@ FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, Featur
 		vCritical() << "can't listen on localhost!";
 	}
 
-	auto pendingMessagesTimer = new QTimer( this );
-	connect( pendingMessagesTimer, &QTimer::timeout, this, &FeatureWorkerManager::sendPendingMessages );
-
-	pendingMessagesTimer->start( 100 );
+	if( isPrespawningEnabled() )
+	{
+		QTimer::singleShot( 0, this, &FeatureWorkerManager::prespawnWorkers );
+	}
 }
 
 
@@ -70,6 +70,11 @@ FeatureWorkerManager::~FeatureWorkerManager()
 	{
 		stopWorker( m_workers.firstKey() );
 	}
+
+	while( m_standbyWorkers.isEmpty() == false )
+	{
+		discardStandbyWorker( m_standbyWorkers.firstKey() );
+	}
 }
 
 
@@ -84,21 +89,38 @@ bool FeatureWorkerManager::startManagedSystemWorker( Feature::Uid featureUid )
 
 	stopWorker( featureUid );
 
-	Worker worker;
+	m_workersMutex.lock();
 
-	worker.process = new QProcess;
-	worker.process->setProcessChannelMode( QProcess::ForwardedChannels );
+	auto worker = m_standbyWorkers.value( WorkerType::ManagedSystem );
+	if( worker.socket )
+	{
+		vDebug() << "Assigning prespawned managed system worker to feature" << featureUid;
 
-	connect( worker.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-			 worker.process, &QProcess::deleteLater );
+		m_standbyWorkers.remove( WorkerType::ManagedSystem );
+		worker.prespawned = true;
+		FeatureMessage( featureUid, FeatureMessage::InitCommand ).send( worker.socket );
+	}
+	else
+	{
+		worker = {};
+		worker.process = new QProcess;
+		worker.process->setProcessChannelMode( QProcess::ForwardedChannels );
 
-	vDebug() << "Starting managed system worker for feature" << featureUid;
-	worker.process->start( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() } );
+		connect( worker.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+				 worker.process, &QProcess::deleteLater );
+
+		vDebug() << "Starting managed system worker for feature" << featureUid;
+		worker.process->start( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() } );
+	}
 
-	m_workersMutex.lock();
 	m_workers[featureUid] = worker;
 	m_workersMutex.unlock();
 
+	if( worker.prespawned )
+	{
+		prespawnWorker( WorkerType::ManagedSystem );
+	}
+
 	return true;
 }
 
@@ -114,7 +136,28 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 
 	stopWorker( featureUid );
 
-	Worker worker;
+	m_workersMutex.lock();
+
+	auto worker = m_standbyWorkers.value( WorkerType::UnmanagedSession );
+	if( worker.socket )
+	{
+		vDebug() << "Assigning prespawned worker (unmanaged session process) to feature" << featureUid;
+
+		m_standbyWorkers.remove( WorkerType::UnmanagedSession );
+		worker.prespawned = true;
+		FeatureMessage( featureUid, FeatureMessage::InitCommand ).send( worker.socket );
+
+		m_workers[featureUid] = worker;
+		m_workersMutex.unlock();
+
+		prespawnWorker( WorkerType::UnmanagedSession );
+
+		return true;
+	}
+
+	m_workersMutex.unlock();
+
+	worker = {};
 
 	vDebug() << "Starting worker (unmanaged session process) for feature" << featureUid;
 
@@ -252,31 +295,39 @@ void FeatureWorkerManager::acceptConnection()
 void FeatureWorkerManager::processConnection( QTcpSocket* socket )
 {
 	FeatureMessage message;
-	message.receive( socket );
 
-	m_workersMutex.lock();
-
-	// set socket information
-	if( m_workers.contains( message.featureUid() ) )
+	while( message.isReadyForReceive( socket ) && message.receive( socket ) )
 	{
-		if( m_workers[message.featureUid()].socket.isNull() )
+		if( message.featureUid().isNull() && message.command() == FeatureMessage::InitCommand )
 		{
-			m_workers[message.featureUid()].socket = socket;
-			sendPendingMessages();
+			registerStandbyWorker( socket, static_cast<WorkerType>( message.argument( StandbyWorkerArgument::WorkerType ).toInt() ) );
+			continue;
 		}
 
-		m_workersMutex.unlock();
+		m_workersMutex.lock();
 
-		if( message.command() >= 0 )
+		// set socket information
+		if( m_workers.contains( message.featureUid() ) )
 		{
-			m_featureManager.handleFeatureMessage( m_server, MessageContext( socket ), message );
+			if( m_workers[message.featureUid()].socket.isNull() )
+			{
+				m_workers[message.featureUid()].socket = socket;
+				sendPendingMessages();
+			}
+
+			m_workersMutex.unlock();
+
+			if( message.command() >= 0 )
+			{
+				m_featureManager.handleFeatureMessage( m_server, MessageContext( socket ), message );
+			}
 		}
-	}
-	else
-	{
-		m_workersMutex.unlock();
+		else
+		{
+			m_workersMutex.unlock();
 
-		vCritical() << "got data from non-existing worker!" << message.featureUid();
+			vCritical() << "got data from non-existing worker!" << message.featureUid();
+		}
 	}
 }
 
@@ -299,9 +350,31 @@ void FeatureWorkerManager::closeConnection( QTcpSocket* socket )
 		}
 	}
 
+	QList<WorkerType> closedStandbyWorkers;
+
+	for( auto it = m_standbyWorkers.begin(); it != m_standbyWorkers.end(); )
+	{
+		if( it.value().socket == socket )
+		{
+			vDebug() << "removing standby worker after socket has been closed";
+			closedStandbyWorkers.append( it.key() );
+			it = m_standbyWorkers.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
 	m_workersMutex.unlock();
 
 	socket->deleteLater();
+
+	// delay restart to avoid busy loops if standby workers keep crashing
+	for( auto type : closedStandbyWorkers )
+	{
+		QTimer::singleShot( UnmanagedSessionProcessRetryInterval, this, [=]() { prespawnWorker( type ); } );
+	}
 }
 
 
@@ -312,7 +385,7 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 
 	if( m_workers.contains( message.featureUid() ) )
 	{
-		m_workers[message.featureUid()].pendingMessages.append( message );
+		m_workers[message.featureUid()].pendingMessages.append( PendingMessage( message ) );
 	}
 	else
 	{
@@ -320,6 +393,17 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 	}
 
 	m_workersMutex.unlock();
+
+	// push message to worker immediately if it's connected already
+	if( thread() == QThread::currentThread() )
+	{
+		sendPendingMessages();
+	}
+	else
+	{
+		// zero-timeout single shot timers are queued to the receiver's thread
+		QTimer::singleShot( 0, this, &FeatureWorkerManager::sendPendingMessages );
+	}
 }
 
 
@@ -334,10 +418,160 @@ void FeatureWorkerManager::sendPendingMessages()
 
 		while( worker.socket && worker.pendingMessages.isEmpty() == false )
 		{
-			worker.pendingMessages.first().send( worker.socket );
+			const auto& pendingMessage = worker.pendingMessages.first();
+			pendingMessage.message.send( worker.socket );
+
+			vDebug() << "delivered message for feature" << it.key()
+					 << "to" << ( worker.prespawned ? "prespawned" : "on-demand" ) << "worker after"
+					 << pendingMessage.receiveTimer.elapsed() << "ms";
+
 			worker.pendingMessages.removeFirst();
 		}
 	}
 
 	m_workersMutex.unlock();
 }
+
+
+
+bool FeatureWorkerManager::isPrespawningEnabled() const
+{
+	return VeyonCore::config().featureWorkerPrespawningEnabled();
+}
+
+
+
+void FeatureWorkerManager::prespawnWorkers()
+{
+	prespawnWorker( WorkerType::ManagedSystem );
+	prespawnWorker( WorkerType::UnmanagedSession );
+}
+
+
+
+void FeatureWorkerManager::prespawnWorker( WorkerType type )
+{
+	if( isPrespawningEnabled() == false || m_tcpServer.isListening() == false )
+	{
+		return;
+	}
+
+	m_workersMutex.lock();
+	const auto exists = m_standbyWorkers.contains( type );
+	m_workersMutex.unlock();
+
+	if( exists )
+	{
+		return;
+	}
+
+	const auto standbyId = ++m_standbyWorkerCounter;
+
+	if( startStandbyProcess( type, standbyId ) == false )
+	{
+		vDebug() << "could not prespawn worker of type" << type << "- retrying later";
+		QTimer::singleShot( UnmanagedSessionProcessRetryInterval, this, [=]() { prespawnWorker( type ); } );
+		return;
+	}
+
+	// discard standby worker if it doesn't connect in time, e.g. because it crashed during startup
+	QTimer::singleShot( StandbyWorkerConnectTimeout, this, [=]() {
+		m_workersMutex.lock();
+		const auto worker = m_standbyWorkers.value( type );
+		m_workersMutex.unlock();
+
+		if( worker.standbyId == standbyId && worker.socket.isNull() )
+		{
+			vWarning() << "standby worker of type" << type << "did not connect in time";
+			discardStandbyWorker( type );
+			prespawnWorker( type );
+		}
+	} );
+}
+
+
+
+bool FeatureWorkerManager::startStandbyProcess( WorkerType type, quint64 standbyId )
+{
+	const QStringList arguments{ standbyWorkerCommandLineArgument(), QString::number( static_cast<int>( type ) ) };
+
+	Worker worker;
+	worker.standbyId = standbyId;
+
+	if( type == WorkerType::ManagedSystem )
+	{
+		worker.process = new QProcess;
+		worker.process->setProcessChannelMode( QProcess::ForwardedChannels );
+
+		connect( worker.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+				 worker.process, &QProcess::deleteLater );
+
+		vDebug() << "Prespawning managed system worker";
+		worker.process->start( VeyonCore::filesystem().workerFilePath(), arguments );
+	}
+	else
+	{
+		const auto currentUser = VeyonCore::platform().userFunctions().currentUser();
+		if( currentUser.isEmpty() )
+		{
+			return false;
+		}
+
+		vDebug() << "Prespawning worker (unmanaged session process) for user" << currentUser;
+
+		if( VeyonCore::platform().coreFunctions().
+			runProgramAsUser( VeyonCore::filesystem().workerFilePath(), arguments,
+							  currentUser,
+							  VeyonCore::platform().coreFunctions().activeDesktopName() ) == false )
+		{
+			return false;
+		}
+	}
+
+	m_workersMutex.lock();
+	m_standbyWorkers[type] = worker;
+	m_workersMutex.unlock();
+
+	return true;
+}
+
+
+
+void FeatureWorkerManager::registerStandbyWorker( QTcpSocket* socket, WorkerType type )
+{
+	QMutexLocker locker( &m_workersMutex );
+
+	if( m_standbyWorkers.contains( type ) == false || m_standbyWorkers[type].socket )
+	{
+		vWarning() << "closing connection of unexpected standby worker of type" << type;
+		socket->close();
+		return;
+	}
+
+	vDebug() << "standby worker of type" << type << "ready";
+
+	m_standbyWorkers[type].socket = socket;
+}
+
+
+
+void FeatureWorkerManager::discardStandbyWorker( WorkerType type )
+{
+	m_workersMutex.lock();
+	const auto worker = m_standbyWorkers.take( type );
+	m_workersMutex.unlock();
+
+	if( worker.socket )
+	{
+		worker.socket->disconnect( this );
+		disconnect( worker.socket );
+
+		worker.socket->close();
+		worker.socket->deleteLater();
+	}
+
+	if( worker.process )
+	{
+		worker.process->terminate();
+	}
+}
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QPointer>
 #include <QProcess>
@@ -39,6 +40,18 @@ class VEYON_CORE_EXPORT FeatureWorkerManager : public QObject
 {
 	Q_OBJECT
 public:
+	enum class WorkerType
+	{
+		ManagedSystem,
+		UnmanagedSession
+	};
+	Q_ENUM(WorkerType)
+
+	enum class StandbyWorkerArgument
+	{
+		WorkerType
+	};
+
 	FeatureWorkerManager( VeyonServerInterface& server, FeatureManager& featureManager, QObject* parent = nullptr );
 	~FeatureWorkerManager() override;
 
@@ -53,6 +66,11 @@ public:
 	bool isWorkerRunning( Feature::Uid featureUid );
 	FeatureUidList runningWorkers();
 
+	static QString standbyWorkerCommandLineArgument()
+	{
+		return QStringLiteral("--standby");
+	}
+
 private:
 	void acceptConnection();
 	void processConnection( QTcpSocket* socket );
@@ -62,22 +80,47 @@ private:
 
 	void sendPendingMessages();
 
+	bool isPrespawningEnabled() const;
+	void prespawnWorkers();
+	void prespawnWorker( WorkerType type );
+	bool startStandbyProcess( WorkerType type, quint64 standbyId );
+	void registerStandbyWorker( QTcpSocket* socket, WorkerType type );
+	void discardStandbyWorker( WorkerType type );
+
 	static constexpr auto UnmanagedSessionProcessRetryInterval = 5000;
+	static constexpr auto StandbyWorkerConnectTimeout = 30000;
 
 	VeyonServerInterface& m_server;
 	FeatureManager& m_featureManager;
 	QTcpServer m_tcpServer;
 
+	struct PendingMessage
+	{
+		explicit PendingMessage( const FeatureMessage& featureMessage ) :
+			message( featureMessage )
+		{
+			receiveTimer.start();
+		}
+
+		FeatureMessage message;
+		QElapsedTimer receiveTimer;
+	};
+
 	struct Worker
 	{
 		QPointer<QTcpSocket> socket;
 		QPointer<QProcess> process;
-		QList<FeatureMessage> pendingMessages;
+		QList<PendingMessage> pendingMessages;
+		bool prespawned{false};
+		quint64 standbyId{0};
 	};
 
 	using WorkerMap = QMap<Feature::Uid, Worker>;
 	WorkerMap m_workers;
 
+	QMap<WorkerType, Worker> m_standbyWorkers;
+	quint64 m_standbyWorkerCounter{0};
+
 	QMutex m_workersMutex;
 
 } ;
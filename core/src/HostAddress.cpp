@@ -27,6 +27,7 @@
 #include <QUrl>
 
 #include "HostAddress.h"
+#include "HostResolver.h"
 
 
 HostAddress::HostAddress( const QString& address ) :
@@ -67,6 +68,47 @@ bool HostAddress::isLocalHost() const
 
 
 QString HostAddress::convert( HostAddress::Type targetType ) const
+{
+	const auto resolver = HostResolver::instance();
+	if( resolver && isLookupRequired( targetType ) )
+	{
+		return resolver->convert( m_address, targetType ).result();
+	}
+
+	return resolve( targetType );
+}
+
+
+
+QString HostAddress::tryConvert( HostAddress::Type targetType ) const
+{
+	const auto address = convert( targetType );
+	if( address.isEmpty() )
+	{
+		return m_address;
+	}
+
+	return address;
+}
+
+
+
+bool HostAddress::convertCached( HostAddress::Type targetType, QString* result ) const
+{
+	const auto resolver = HostResolver::instance();
+	if( resolver && isLookupRequired( targetType ) )
+	{
+		return resolver->convertCached( m_address, targetType, result );
+	}
+
+	*result = resolve( targetType );
+
+	return true;
+}
+
+
+
+QString HostAddress::resolve( HostAddress::Type targetType ) const
 {
 	if( m_type == targetType )
 	{
@@ -87,15 +129,11 @@ QString HostAddress::convert( HostAddress::Type targetType ) const
 
 
 
-QString HostAddress::tryConvert( HostAddress::Type targetType ) const
+bool HostAddress::isLookupRequired( HostAddress::Type targetType ) const
 {
-	const auto address = convert( targetType );
-	if( address.isEmpty() )
-	{
-		return m_address;
-	}
-
-	return address;
+	// host names can be derived from FQDNs without asking the DNS
+	return m_type != Type::Invalid && targetType != Type::Invalid && m_type != targetType &&
+			( m_type == Type::FullyQualifiedDomainName && targetType == Type::HostName ) == false;
 }
 
 
@@ -51,6 +51,14 @@ public:
 	QString convert( Type targetType ) const;
 	QString tryConvert( Type targetType ) const;
 
+	// non-blocking variant of convert() for code running on event loops - returns false
+	// if the result is not cached yet and has to be looked up in the background
+	bool convertCached( Type targetType, QString* result ) const;
+
+	// uncached and possibly blocking conversion - use convert() or HostResolver instead
+	QString resolve( Type targetType ) const;
+	bool isLookupRequired( Type targetType ) const;
+
 	QStringList lookupIpAddresses() const;
 
 	static QString parseHost( const QString& address );
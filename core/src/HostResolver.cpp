@@ -0,0 +1,254 @@
+/*
+ * HostResolver.cpp - implementation of HostResolver class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include "HostResolver.h"
+
+
+std::atomic<HostResolver *> HostResolver::s_instance{nullptr};
+
+
+static QFuture<QString> readyFuture( const QString& result )
+{
+	QFutureInterface<QString> futureInterface( QFutureInterfaceBase::Started );
+	futureInterface.reportFinished( &result );
+
+	return futureInterface.future();
+}
+
+
+
+QJsonObject HostResolver::Statistics::toJson() const
+{
+	return {
+		{ QStringLiteral("lookups"), lookups },
+		{ QStringLiteral("failures"), failures },
+		{ QStringLiteral("cacheHits"), cacheHits },
+		{ QStringLiteral("negativeCacheHits"), negativeCacheHits },
+		{ QStringLiteral("averageLookupDuration"), lookups > 0 ? double(lookupDuration) / lookups / 1000000 : 0.0 },
+		{ QStringLiteral("maximumLookupDuration"), double(maximumLookupDuration) / 1000000 },
+		{ QStringLiteral("cacheSize"), cacheSize },
+		{ QStringLiteral("pendingLookups"), pendingLookups },
+	};
+}
+
+
+
+HostResolver::HostResolver()
+{
+	m_clock.start();
+
+	m_threadPool.setMaxThreadCount( MaximumThreadCount );
+
+	s_instance.store( this, std::memory_order_release );
+}
+
+
+
+HostResolver::~HostResolver()
+{
+	s_instance.store( nullptr, std::memory_order_release );
+
+	// cancel lookups which have not been started yet and wait for the running ones only
+	m_threadPool.clear();
+	m_threadPool.waitForDone();
+}
+
+
+
+QFuture<QString> HostResolver::convert( const QString& address, Type targetType )
+{
+	QString result;
+	if( lookupCache( address, targetType, &result ) )
+	{
+		return readyFuture( result );
+	}
+
+	QMutexLocker locker( &m_mutex );
+
+	const auto lookupKey = key( address, targetType );
+
+	const auto pendingLookup = m_pendingLookups.constFind( lookupKey );
+	if( pendingLookup != m_pendingLookups.constEnd() )
+	{
+		return *pendingLookup;
+	}
+
+	const auto future = QtConcurrent::run( &m_threadPool, [=]() { return lookup( address, targetType ); } );
+	m_pendingLookups[lookupKey] = future;
+
+	return future;
+}
+
+
+
+bool HostResolver::lookupCache( const QString& address, Type targetType, QString* result )
+{
+	const HostAddress hostAddress( address );
+	if( hostAddress.isLookupRequired( targetType ) == false )
+	{
+		*result = hostAddress.resolve( targetType );
+		return true;
+	}
+
+	QMutexLocker locker( &m_mutex );
+
+	const auto it = m_cache.constFind( key( address, targetType ) );
+	if( it == m_cache.constEnd() || hasExpired( *it ) )
+	{
+		return false;
+	}
+
+	++m_statistics.cacheHits;
+	if( it->result.isEmpty() )
+	{
+		++m_statistics.negativeCacheHits;
+	}
+
+	*result = it->result;
+
+	return true;
+}
+
+
+
+bool HostResolver::convertCached( const QString& address, Type targetType, QString* result )
+{
+	if( lookupCache( address, targetType, result ) )
+	{
+		return true;
+	}
+
+	convert( address, targetType );
+
+	return false;
+}
+
+
+
+void HostResolver::tryConvert( const QString& address, Type targetType, QObject* context, const Callback& callback )
+{
+	const auto future = convert( address, targetType );
+	if( future.isFinished() )
+	{
+		const auto result = future.result();
+		callback( result.isEmpty() ? address : result );
+		return;
+	}
+
+	auto watcher = new QFutureWatcher<QString>( context );
+	QObject::connect( watcher, &QFutureWatcher<QString>::finished, context, [=]() {
+		const auto result = watcher->result();
+		callback( result.isEmpty() ? address : result );
+		watcher->deleteLater();
+	} );
+	watcher->setFuture( future );
+}
+
+
+
+HostResolver::Statistics HostResolver::statistics() const
+{
+	QMutexLocker locker( &m_mutex );
+
+	auto statistics = m_statistics;
+	statistics.cacheSize = m_cache.size();
+	statistics.pendingLookups = m_pendingLookups.size();
+
+	return statistics;
+}
+
+
+
+void HostResolver::clear()
+{
+	QMutexLocker locker( &m_mutex );
+
+	m_cache.clear();
+}
+
+
+
+QString HostResolver::lookup( const QString& address, Type targetType )
+{
+	QElapsedTimer lookupTimer;
+	lookupTimer.start();
+
+	const auto result = HostAddress( address ).resolve( targetType );
+
+	const auto duration = lookupTimer.nsecsElapsed();
+	if( duration >= qint64(SlowLookupThreshold) * 1000000 )
+	{
+		vWarning() << "converting" << address << "to" << targetType << "took" << duration / 1000000 << "ms";
+	}
+
+	QMutexLocker locker( &m_mutex );
+
+	++m_statistics.lookups;
+	if( result.isEmpty() )
+	{
+		++m_statistics.failures;
+	}
+	m_statistics.lookupDuration += duration;
+	m_statistics.maximumLookupDuration = qMax( m_statistics.maximumLookupDuration, duration );
+
+	if( m_cache.size() >= MaximumCacheSize )
+	{
+		purgeCache();
+	}
+
+	const auto lookupKey = key( address, targetType );
+	const auto timeToLive = result.isEmpty() ? NegativeTimeToLive : DefaultTimeToLive;
+	m_cache[lookupKey] = { result, m_clock.elapsed() + qint64(timeToLive) * 1000 };
+	m_pendingLookups.remove( lookupKey );
+
+	return result;
+}
+
+
+
+void HostResolver::purgeCache()
+{
+	for( auto it = m_cache.begin(); it != m_cache.end(); )
+	{
+		if( hasExpired( *it ) )
+		{
+			it = m_cache.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	// still full with valid entries, so start over rather than tracking usage of each entry
+	if( m_cache.size() >= MaximumCacheSize )
+	{
+		m_cache.clear();
+	}
+}
@@ -0,0 +1,129 @@
+/*
+ * HostResolver.h - declaration of HostResolver class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThreadPool>
+
+#include "HostAddress.h"
+
+// clazy:excludeall=rule-of-three
+
+// process-wide service performing host address conversions (DNS lookups) in a separate thread pool
+// with a positive and negative result cache so callers on event loops never have to block
+class VEYON_CORE_EXPORT HostResolver
+{
+public:
+	using Type = HostAddress::Type;
+	using Callback = std::function<void(const QString&)>;
+
+	struct Statistics
+	{
+		qint64 lookups{0};
+		qint64 failures{0};
+		qint64 cacheHits{0};
+		qint64 negativeCacheHits{0};
+		qint64 lookupDuration{0}; // nanoseconds
+		qint64 maximumLookupDuration{0}; // nanoseconds
+		int cacheSize{0};
+		int pendingLookups{0};
+
+		QJsonObject toJson() const;
+	};
+
+	static constexpr int DefaultTimeToLive = 300; // seconds
+	static constexpr int NegativeTimeToLive = 30; // seconds
+	static constexpr int MaximumCacheSize = 4096;
+	static constexpr int MaximumThreadCount = 4;
+	static constexpr int SlowLookupThreshold = 1000; // milliseconds
+
+	HostResolver();
+	~HostResolver();
+
+	static HostResolver* instance()
+	{
+		return s_instance.load( std::memory_order_acquire );
+	}
+
+	// returns a future with the converted address or an empty string if the lookup failed -
+	// concurrent requests for the same address share a single lookup
+	QFuture<QString> convert( const QString& address, Type targetType );
+
+	// returns true and sets result if the conversion can be answered without a lookup
+	bool lookupCache( const QString& address, Type targetType, QString* result );
+
+	// non-blocking variant of convert() - returns false and starts a lookup in the background
+	// if the conversion can't be answered from the cache yet so callers can check again later
+	bool convertCached( const QString& address, Type targetType, QString* result );
+
+	// invokes callback in the thread of context once the conversion finished, passing the
+	// original address if the lookup failed
+	void tryConvert( const QString& address, Type targetType, QObject* context, const Callback& callback );
+
+	Statistics statistics() const;
+
+	void clear();
+
+private:
+	using Key = QPair<int, QString>;
+
+	struct CacheEntry
+	{
+		QString result;
+		qint64 expiry; // milliseconds on m_clock
+	};
+
+	static Key key( const QString& address, Type targetType )
+	{
+		return { static_cast<int>( targetType ), address.toLower() };
+	}
+
+	bool hasExpired( const CacheEntry& entry ) const
+	{
+		return m_clock.elapsed() >= entry.expiry;
+	}
+
+	QString lookup( const QString& address, Type targetType );
+	void purgeCache();
+
+	static std::atomic<HostResolver *> s_instance;
+
+	QElapsedTimer m_clock{};
+
+	mutable QMutex m_mutex{};
+	QHash<Key, CacheEntry> m_cache{};
+	QHash<Key, QFuture<QString>> m_pendingLookups{};
+	Statistics m_statistics{};
+
+	QThreadPool m_threadPool{};
+
+} ;
@@ -23,29 +23,54 @@
  */
 
 #include <QCoreApplication>
-#include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QThread>
 
 #include "VeyonConfiguration.h"
 #include "Filesystem.h"
 #include "Logger.h"
+#include "MpscQueue.h"
 #include "PlatformCoreFunctions.h"
 #include "PlatformFilesystemFunctions.h"
 
 QAtomicPointer<Logger> Logger::s_instance = nullptr;
-QMutex Logger::s_instanceMutex;
+QReadWriteLock Logger::s_instanceLock;
+
+
+class LogWriterThread : public QThread
+{
+public:
+	explicit LogWriterThread( Logger* logger ) :
+		m_logger( logger )
+	{
+	}
+
+protected:
+	void run() override
+	{
+		m_logger->runWriter();
+	}
+
+private:
+	Logger* m_logger;
+
+} ;
+
 
 
 Logger::Logger( const QString &appName ) :
+	m_messageQueue( new MpscQueue<Message>( MessageQueueSize ) ),
+	m_writerThread( new LogWriterThread( this ) ),
 	m_appName( QStringLiteral( "Veyon" ) + appName )
 {
-	s_instanceMutex.lock();
+	s_instanceLock.lockForWrite();
 
 	Q_ASSERT(s_instance == nullptr);
 
 	s_instance = this;
-	s_instanceMutex.unlock();
+	s_instanceLock.unlock();
 
 	auto configuredLogLevel = VeyonCore::config().logLevel();
 	if( qEnvironmentVariableIsSet( logLevelEnvironmentVariable() ) )
@@ -55,12 +80,16 @@ Logger::Logger( const QString &appName ) :
 
 	m_logLevel = qBound( LogLevel::Min, configuredLogLevel, LogLevel::Max );
 	m_logToSystem = VeyonCore::config().logToSystem();
+	m_logToStdErr = VeyonCore::config().logToStdErr();
 
 	if( m_logLevel > LogLevel::Nothing )
 	{
 		initLogFile();
 	}
 
+	m_writerThread->setObjectName( QStringLiteral("LogWriter") );
+	m_writerThread->start( QThread::LowPriority );
+
 	qInstallMessageHandler( qtMsgHandler );
 
 	VeyonCore::platform().coreFunctions().initNativeLoggingSystem( appName );
@@ -83,14 +112,27 @@ Logger::~Logger()
 {
 	vDebug() << "Shutdown";
 
-	QMutexLocker l( &m_logMutex );
-
 	qInstallMessageHandler(nullptr);
 
-	s_instanceMutex.lock();
+	// threads waiting for critical messages to be flushed hold the instance lock for reading
+	// so release them before acquiring it - otherwise the writer thread could be blocked as well
+	// when logging while we're waiting for the lock
+	m_writerMutex.lock();
+	m_shuttingDown = true;
+	m_flushedWaitCondition.wakeAll();
+	m_writerMutex.unlock();
+
+	s_instanceLock.lockForWrite();
 	s_instance = nullptr;
-	s_instanceMutex.unlock();
+	s_instanceLock.unlock();
+
+	// writer thread writes all pending messages before quitting
+	m_writerQuit = true;
+	wakeWriter();
+	m_writerThread->wait();
 
+	delete m_writerThread;
+	delete m_messageQueue;
 	delete m_logFile;
 }
 
@@ -215,7 +257,7 @@ void Logger::rotateLogFile()
 
 
 
-QString Logger::formatMessage( LogLevel ll, const QString& message )
+QString Logger::formatMessage( LogLevel ll, const QDateTime& time, const QString& message )
 {
 	QString messageType;
 	switch( ll )
@@ -229,8 +271,8 @@ QString Logger::formatMessage( LogLevel ll, const QString& message )
 	}
 
 	return QStringLiteral( "%1.%2: [%3] %4\n" ).arg(
-				QDateTime::currentDateTime().toString( Qt::ISODate ),
-				QDateTime::currentDateTime().toString( QStringLiteral( "zzz" ) ),
+				time.toString( Qt::ISODate ),
+				time.toString( QStringLiteral( "zzz" ) ),
 				messageType,
 				message.trimmed() );
 }
@@ -240,7 +282,8 @@ QString Logger::formatMessage( LogLevel ll, const QString& message )
 
 void Logger::qtMsgHandler( QtMsgType messageType, const QMessageLogContext& context, const QString& message )
 {
-	QMutexLocker instanceLocker( &s_instanceMutex );
+	// instance can't be destroyed while handling messages but handlers do not block each other
+	QReadLocker instanceLocker( &s_instanceLock );
 
 	const auto instance = s_instance.loadAcquire();
 
@@ -275,43 +318,132 @@ void Logger::qtMsgHandler( QtMsgType messageType, const QMessageLogContext& cont
 
 void Logger::log( LogLevel logLevel, const QString& message )
 {
-	if( m_logLevel >= logLevel )
+	if( m_logLevel < logLevel )
+	{
+		return;
+	}
+
+	quint64 messageId = 0;
+	if( m_messageQueue->enqueue( { logLevel, QDateTime::currentDateTime(), message }, &messageId ) == false )
+	{
+		// never block callers - the writer thread reports the number of dropped messages
+		++m_droppedMessageCount;
+		return;
+	}
+
+	wakeWriter();
+
+	// make sure critical messages are written before a possible abort
+	if( logLevel == LogLevel::Critical )
+	{
+		flush( messageId );
+	}
+}
+
+
+
+void Logger::runWriter()
+{
+	QVector<Message> messages;
+	messages.reserve( MaximumBatchSize );
+
+	for(;;)
+	{
+		const bool quit = m_writerQuit;
+
+		Message message;
+		while( messages.size() < MaximumBatchSize && m_messageQueue->dequeue( message ) )
+		{
+			messages.append( std::move( message ) );
+		}
+
+		if( messages.isEmpty() == false ||
+			m_droppedMessageCount != m_reportedDroppedMessageCount )
+		{
+			writeMessages( messages );
+			messages.clear();
+
+			m_writerMutex.lock();
+			m_writtenMessageCount = m_messageQueue->dequeuePosition();
+			m_flushedWaitCondition.wakeAll();
+			m_writerMutex.unlock();
+
+			continue;
+		}
+
+		if( quit )
+		{
+			break;
+		}
+
+		m_writerMutex.lock();
+		m_writerIdle = true;
+		if( m_messageQueue->isEmpty() && m_writerQuit == false )
+		{
+			m_writerWaitCondition.wait( &m_writerMutex, WriterIdleTimeout );
+		}
+		m_writerIdle = false;
+		m_writerMutex.unlock();
+	}
+}
+
+
+
+void Logger::writeMessages( const QVector<Message>& messages )
+{
+	QByteArray output;
+
+	const quint64 droppedMessageCount = m_droppedMessageCount;
+	if( droppedMessageCount != m_reportedDroppedMessageCount )
 	{
-		QMutexLocker l( &m_logMutex );
-		if( message == m_lastMessage && logLevel == m_lastMessageLevel )
+		output += formatMessage( LogLevel::Warning, QDateTime::currentDateTime(),
+								 QStringLiteral( "%1 log messages dropped" ).
+								 arg( droppedMessageCount - m_reportedDroppedMessageCount ) ).toUtf8();
+		m_reportedDroppedMessageCount = droppedMessageCount;
+	}
+
+	for( const auto& message : messages )
+	{
+		if( message.text == m_lastMessage && message.level == m_lastMessageLevel )
 		{
 			++m_lastMessageCount;
+			continue;
 		}
-		else
+
+		if( m_lastMessageCount )
 		{
-			if( m_lastMessageCount )
-			{
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) );
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "Last message repeated %1 times" ).arg( m_lastMessageCount ) ) );
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) );
-				m_lastMessageCount = 0;
-			}
-			outputMessage( formatMessage( logLevel, message ) );
+			output += formatMessage( m_lastMessageLevel, message.time, QStringLiteral( "---" ) ).toUtf8();
+			output += formatMessage( m_lastMessageLevel, message.time, QStringLiteral( "Last message repeated %1 times" ).arg( m_lastMessageCount ) ).toUtf8();
+			output += formatMessage( m_lastMessageLevel, message.time, QStringLiteral( "---" ) ).toUtf8();
+			m_lastMessageCount = 0;
+		}
 
-			if( m_logToSystem )
-			{
-				VeyonCore::platform().coreFunctions().writeToNativeLoggingSystem( message, logLevel );
-			}
+		output += formatMessage( message.level, message.time, message.text ).toUtf8();
 
-			m_lastMessage = message;
-			m_lastMessageLevel = logLevel;
+		if( m_logToSystem )
+		{
+			VeyonCore::platform().coreFunctions().writeToNativeLoggingSystem( message.text, message.level );
 		}
+
+		m_lastMessage = message.text;
+		m_lastMessageLevel = message.level;
 	}
+
+	outputMessages( output );
 }
 
 
 
-void Logger::outputMessage( const QString& message )
+void Logger::outputMessages( const QByteArray& messages )
 {
+	if( messages.isEmpty() )
+	{
+		return;
+	}
+
 	if( m_logFile )
 	{
-		m_logFile->write( message.toUtf8() );
-		m_logFile->flush();
+		m_logFile->write( messages );
 
 		if( m_logFileSizeLimit > 0 &&
 				m_logFile->size() > m_logFileSizeLimit )
@@ -327,9 +459,56 @@ void Logger::outputMessage( const QString& message )
 		}
 	}
 
-	if( VeyonCore::config().logToStdErr() )
+	if( m_logToStdErr )
 	{
-		fprintf( stderr, "%s", message.toUtf8().constData() );
+		fwrite( messages.constData(), 1, size_t(messages.size()), stderr );
 		fflush( stderr );
 	}
 }
+
+
+
+void Logger::wakeWriter()
+{
+	if( m_writerIdle.exchange( false ) )
+	{
+		QMutexLocker locker( &m_writerMutex );
+		m_writerWaitCondition.wakeOne();
+	}
+	else if( m_writerQuit )
+	{
+		QMutexLocker locker( &m_writerMutex );
+		m_writerWaitCondition.wakeAll();
+	}
+}
+
+
+
+void Logger::flush( quint64 messageId )
+{
+	// messages logged by the writer thread itself (e.g. while rotating) can't be waited for
+	if( QThread::currentThread() == m_writerThread )
+	{
+		return;
+	}
+
+	QMutexLocker locker( &m_writerMutex );
+
+	m_writerWaitCondition.wakeOne();
+
+	// never wait unbounded as the writer thread may be blocked by logging itself
+	QElapsedTimer flushTimer;
+	flushTimer.start();
+
+	while( m_writtenMessageCount <= messageId &&
+		   m_shuttingDown == false &&
+		   m_writerThread->isRunning() )
+	{
+		const auto remainingTime = FlushTimeout - flushTimer.elapsed();
+		if( remainingTime <= 0 ||
+			m_flushedWaitCondition.wait( &m_writerMutex, QDeadlineTimer( remainingTime ) ) == false )
+		{
+			break;
+		}
+	}
+}
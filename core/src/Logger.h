@@ -24,12 +24,20 @@
 
 #pragma once
 
+#include <atomic>
+
+#include <QDateTime>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QTextStream>
+#include <QVector>
+#include <QWaitCondition>
 
 #include "VeyonCore.h"
 
 class QFile;
+template<typename T> class MpscQueue;
+class LogWriterThread;
 
 // clazy:excludeall=rule-of-three
 
@@ -70,8 +78,28 @@ public:
 		return m_logLevel;
 	}
 
+	quint64 droppedMessageCount() const
+	{
+		return m_droppedMessageCount;
+	}
+
 
 private:
+	friend class LogWriterThread;
+
+	struct Message
+	{
+		LogLevel level{LogLevel::Nothing};
+		QDateTime time{};
+		QString text{};
+	};
+
+	// must be a power of two
+	static constexpr int MessageQueueSize = 8192;
+	static constexpr int MaximumBatchSize = 256;
+	static constexpr int WriterIdleTimeout = 100;
+	static constexpr int FlushTimeout = 1000;
+
 	void initLogFile();
 	void openLogFile();
 	void closeLogFile();
@@ -79,21 +107,41 @@ private:
 	void rotateLogFile();
 
 	void log( LogLevel logLevel, const QString& message );
-	void outputMessage( const QString& message );
 
-	static QString formatMessage( LogLevel ll, const QString &msg );
+	// executed by writer thread
+	void runWriter();
+	void writeMessages( const QVector<Message>& messages );
+	void outputMessages( const QByteArray& messages );
+
+	void wakeWriter();
+	void flush( quint64 messageId );
+
+	static QString formatMessage( LogLevel ll, const QDateTime& time, const QString &msg );
 	static void qtMsgHandler( QtMsgType msgType, const QMessageLogContext &, const QString& msg );
 
 	static QAtomicPointer<Logger> s_instance;
-	static QMutex s_instanceMutex;
+	static QReadWriteLock s_instanceLock;
 
 	LogLevel m_logLevel{LogLevel::Default};
-	QMutex m_logMutex{};
+
+	// messages are queued without blocking and written by a background thread
+	MpscQueue<Message>* m_messageQueue{nullptr};
+	LogWriterThread* m_writerThread{nullptr};
+	QMutex m_writerMutex{};
+	QWaitCondition m_writerWaitCondition{};
+	QWaitCondition m_flushedWaitCondition{};
+	std::atomic<bool> m_writerIdle{false};
+	std::atomic<bool> m_writerQuit{false};
+	bool m_shuttingDown{false};
+	quint64 m_writtenMessageCount{0};
+	std::atomic<quint64> m_droppedMessageCount{0};
+	quint64 m_reportedDroppedMessageCount{0};
 
 	LogLevel m_lastMessageLevel{LogLevel::Nothing};
 	QString m_lastMessage{};
 	int m_lastMessageCount{0};
 	bool m_logToSystem{false};
+	bool m_logToStdErr{false};
 
 	QString m_appName;
 
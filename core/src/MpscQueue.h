@@ -0,0 +1,143 @@
+/*
+ * MpscQueue.h - bounded lock-free multi-producer single-consumer queue
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <QtGlobal>
+
+// clazy:excludeall=rule-of-three
+
+// bounded lock-free queue for multiple producers and a single consumer - each slot carries
+// a sequence number indicating whether it is free for the producers or ready for the consumer
+template<typename T>
+class MpscQueue
+{
+public:
+	// size must be a power of two
+	explicit MpscQueue( size_t size ) :
+		m_slots( size ),
+		m_mask( quint64(size) - 1 )
+	{
+		for( size_t i = 0; i < size; ++i )
+		{
+			m_slots[i].sequence.store( i, std::memory_order_relaxed );
+		}
+	}
+
+	// returns false without blocking if the queue is full, position receives the
+	// running number of the enqueued value which is compared with dequeuePosition()
+	bool enqueue( T&& value, quint64* position = nullptr )
+	{
+		auto enqueuePosition = m_enqueuePosition.load( std::memory_order_relaxed );
+
+		for(;;)
+		{
+			auto& slot = m_slots[enqueuePosition & m_mask];
+			const auto sequence = slot.sequence.load( std::memory_order_acquire );
+			const auto difference = qint64(sequence) - qint64(enqueuePosition);
+
+			if( difference == 0 )
+			{
+				if( m_enqueuePosition.compare_exchange_weak( enqueuePosition, enqueuePosition + 1, std::memory_order_relaxed ) )
+				{
+					slot.value = std::move( value );
+					slot.sequence.store( enqueuePosition + 1, std::memory_order_release );
+					if( position )
+					{
+						*position = enqueuePosition;
+					}
+					return true;
+				}
+			}
+			else if( difference < 0 )
+			{
+				// queue full
+				return false;
+			}
+			else
+			{
+				enqueuePosition = m_enqueuePosition.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	bool enqueue( const T& value, quint64* position = nullptr )
+	{
+		return enqueue( T( value ), position );
+	}
+
+	// must only be called by the consumer
+	bool dequeue( T& value )
+	{
+		const auto dequeuePosition = m_dequeuePosition.load( std::memory_order_relaxed );
+
+		auto& slot = m_slots[dequeuePosition & m_mask];
+		if( slot.sequence.load( std::memory_order_acquire ) != dequeuePosition + 1 )
+		{
+			return false;
+		}
+
+		value = std::move( slot.value );
+		slot.sequence.store( dequeuePosition + m_mask + 1, std::memory_order_release );
+		m_dequeuePosition.store( dequeuePosition + 1, std::memory_order_release );
+
+		return true;
+	}
+
+	bool isEmpty() const
+	{
+		return size() == 0;
+	}
+
+	int size() const
+	{
+		// both positions only grow so the difference may just be transiently off by
+		// values which are being enqueued right now
+		const auto dequeuePosition = m_dequeuePosition.load( std::memory_order_acquire );
+		const auto enqueuePosition = m_enqueuePosition.load( std::memory_order_acquire );
+
+		return enqueuePosition > dequeuePosition ? int( enqueuePosition - dequeuePosition ) : 0;
+	}
+
+	quint64 dequeuePosition() const
+	{
+		return m_dequeuePosition.load( std::memory_order_acquire );
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<quint64> sequence{0};
+		T value{};
+	};
+
+	std::vector<Slot> m_slots;
+	const quint64 m_mask;
+	std::atomic<quint64> m_enqueuePosition{0};
+	std::atomic<quint64> m_dequeuePosition{0};
+
+} ;
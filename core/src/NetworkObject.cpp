@@ -197,10 +197,18 @@ bool NetworkObject::isPropertyValueEqual( NetworkObject::Property property,
 		// make sure to compare host addresses in the same format
 		if( property == NetworkObject::Property::HostAddress )
 		{
+			if( myValue.toString().compare( value.toString(), cs ) == 0 )
+			{
+				return true;
+			}
+
+			// never block while iterating objects - addresses not resolved yet are looked up
+			// in the background and considered different until then
 			const HostAddress myHostAddress( myValue.toString() );
-			const auto otherHost = HostAddress( value.toString() ).convert( myHostAddress.type() );
+			QString otherHost;
 
-			return myValue.toString().compare( otherHost, cs ) == 0;
+			return HostAddress( value.toString() ).convertCached( myHostAddress.type(), &otherHost ) &&
+					myValue.toString().compare( otherHost, cs ) == 0;
 		}
 
 		return myValue.toString().compare( value.toString(), cs ) == 0;
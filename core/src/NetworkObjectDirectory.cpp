@@ -81,18 +81,10 @@ const NetworkObject& NetworkObjectDirectory::object( NetworkObject::ModelId pare
 		return m_rootObject;
 	}
 
-	const auto it = m_objects.constFind( parent );
-	if( it != m_objects.end() )
+	const auto row = objectRow( parent, object );
+	if( row >= 0 )
 	{
-		int index = 0;
-		for( const auto& entry : *it )
-		{
-			if( entry.modelId() == object )
-			{
-				return entry;
-			}
-			++index;
-		}
+		return m_objects.constFind( parent )->at( row );
 	}
 
 	return m_invalidObject;
@@ -102,21 +94,7 @@ const NetworkObject& NetworkObjectDirectory::object( NetworkObject::ModelId pare
 
 int NetworkObjectDirectory::index( NetworkObject::ModelId parent, NetworkObject::ModelId child ) const
 {
-	const auto it = m_objects.constFind( parent );
-	if( it != m_objects.end() )
-	{
-		int index = 0;
-		for( const auto& entry : *it )
-		{
-			if( entry.modelId() == child )
-			{
-				return index;
-			}
-			++index;
-		}
-	}
-
-	return -1;
+	return objectRow( parent, child );
 }
 
 
@@ -157,17 +135,10 @@ NetworkObject::ModelId NetworkObjectDirectory::parentId( NetworkObject::ModelId
 		return 0;
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
+	const auto positions = m_objectPositions.constFind( child );
+	if( positions != m_objectPositions.constEnd() && positions->isEmpty() == false )
 	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
-		{
-			if( object.modelId() == child )
-			{
-				return it.key();
-			}
-		}
+		return positions->first().parent;
 	}
 
 	return 0;
@@ -182,6 +153,20 @@ NetworkObject::ModelId NetworkObjectDirectory::rootId() const
 
 
 
+NetworkObject::ModelId NetworkObjectDirectory::modelId( NetworkObject::Uid uid ) const
+{
+	return m_objectModelIds.value( uid, 0 );
+}
+
+
+
+QList<NetworkObject::ModelId> NetworkObjectDirectory::hostObjectIds( const QString& hostAddress ) const
+{
+	return m_hostObjectIds.values( hostAddress.toLower() );
+}
+
+
+
 NetworkObjectList NetworkObjectDirectory::queryObjects( NetworkObject::Type type,
 														NetworkObject::Property property,
 														const QVariant& value )
@@ -225,16 +210,13 @@ NetworkObjectList NetworkObjectDirectory::queryParents( const NetworkObject& chi
 		return {};
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
+	const auto modelId = m_objectModelIds.constFind( child.parentUid() );
+	if( modelId != m_objectModelIds.constEnd() )
 	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
+		const auto& parentObject = object( parentId( *modelId ), *modelId );
+		if( parentObject.isValid() )
 		{
-			if( object.uid() == child.parentUid() )
-			{
-				return queryParents( object ) + NetworkObjectList( { object } );
-			}
+			return queryParents( parentObject ) + NetworkObjectList( { parentObject } );
 		}
 	}
 
@@ -277,24 +259,39 @@ void NetworkObjectDirectory::addOrUpdateObject( const NetworkObject& networkObje
 		completeNetworkObject.setParentUid( parent.uid() );
 	}
 
-	auto& objectList = m_objects[parent.modelId()]; // clazy:exclude=detaching-member
-	const auto index = objectList.indexOf( completeNetworkObject );
+	const auto parentModelId = parent.modelId();
+	const auto objectModelId = completeNetworkObject.modelId();
+
+	auto& objectList = m_objects[parentModelId]; // clazy:exclude=detaching-member
+	const auto index = objectRow( parentModelId, objectModelId );
 
 	if( index < 0 )
 	{
 		Q_EMIT objectsAboutToBeInserted( parent, objectList.count(), 1 );
 
+		const auto firstPosition = m_objectPositions.contains( objectModelId ) == false;
+
+		setObjectRow( parentModelId, objectModelId, objectList.count() );
+		m_objectModelIds[completeNetworkObject.uid()] = objectModelId;
+
 		objectList.append( completeNetworkObject );
-		if( completeNetworkObject.type() == NetworkObject::Type::Location ||
-			completeNetworkObject.type() == NetworkObject::Type::DesktopGroup )
+		if( firstPosition )
 		{
-			m_objects[completeNetworkObject.modelId()] = {};
+			addHostObjectId( completeNetworkObject );
+		}
+		if( ( completeNetworkObject.type() == NetworkObject::Type::Location ||
+			  completeNetworkObject.type() == NetworkObject::Type::DesktopGroup ) &&
+			m_objects.contains( objectModelId ) == false )
+		{
+			m_objects[objectModelId] = {};
 		}
 
 		Q_EMIT objectsInserted();
 	}
 	else if( objectList[index].exactMatch( completeNetworkObject ) == false )
 	{
+		removeHostObjectId( objectList[index] );
+		addHostObjectId( completeNetworkObject );
 		objectList.replace( index, completeNetworkObject );
 		Q_EMIT objectChanged( parent, index );
 	}
@@ -309,34 +306,50 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 		return;
 	}
 
-	auto& objectList = m_objects[parent.modelId()]; // clazy:exclude=detaching-member
-	int index = 0;
-	QList<NetworkObject::ModelId> objectsToRemove;
+	const auto parentModelId = parent.modelId();
+	auto& objectList = m_objects[parentModelId]; // clazy:exclude=detaching-member
+
+	QVector<bool> removeFlags( objectList.count(), false );
+	for( int row = 0; row < objectList.count(); ++row )
+	{
+		removeFlags[row] = removeObjectFilter( objectList.at( row ) );
+	}
+
+	// remove contiguous ranges starting at the end so rows of pending ranges do not change
+	// and renumber remaining objects once afterwards (objectRow() copes with stale rows meanwhile)
+	int firstRemovedRow = -1;
 
-	for( auto it = objectList.begin(); it != objectList.end(); )
+	for( int last = objectList.count() - 1; last >= 0; )
 	{
-		if( removeObjectFilter( *it ) )
+		if( removeFlags.at( last ) == false )
 		{
-			if( it->type() == NetworkObject::Type::Location ||
-				it->type() == NetworkObject::Type::DesktopGroup )
-			{
-				objectsToRemove.append( it->modelId() );
-			}
+			--last;
+			continue;
+		}
 
-			Q_EMIT objectsAboutToBeRemoved( parent, index, 1 );
-			it = objectList.erase( it );
-			Q_EMIT objectsRemoved();
+		int first = last;
+		while( first > 0 && removeFlags.at( first-1 ) )
+		{
+			--first;
 		}
-		else
+
+		Q_EMIT objectsAboutToBeRemoved( parent, first, last - first + 1 );
+
+		for( int row = first; row <= last; ++row )
 		{
-			++it;
-			++index;
+			removeObjectPositions( parentModelId, objectList.at( row ) );
 		}
+		objectList.remove( first, last - first + 1 );
+
+		Q_EMIT objectsRemoved();
+
+		firstRemovedRow = first;
+		last = first - 1;
 	}
 
-	for( const auto& groupId : objectsToRemove )
+	if( firstRemovedRow >= 0 )
 	{
-		m_objects.remove( groupId );
+		updateObjectPositions( parentModelId, firstRemovedRow );
 	}
 }
 
@@ -344,30 +357,162 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 
 void NetworkObjectDirectory::replaceObjects( const NetworkObjectList& objects, const NetworkObject& parent )
 {
+	NetworkObjectUidList objectUids;
+	objectUids.reserve( objects.size() );
+
 	for( const auto& object : objects )
 	{
+		objectUids.append( object.uid() );
 		addOrUpdateObject( object, parent );
 	}
 
-	removeObjects( parent, [&objects]( const NetworkObject& object ) { return objects.contains( object ) == false; } );
+	removeObjects( parent, [&objectUids]( const NetworkObject& object ) { return objectUids.contains( object.uid() ) == false; } );
 }
 
 
 
 void NetworkObjectDirectory::setObjectPopulated( const NetworkObject& networkObject )
 {
-	const auto objectModelId = networkObject.modelId();
+	const auto modelId = networkObject.modelId();
+	const auto positions = m_objectPositions.value( modelId );
 
-	auto it = m_objects.find( parentId( objectModelId ) ); // clazy:exclude=detaching-member
-	if( it != m_objects.end() )
+	for( const auto& position : positions )
+	{
+		const auto row = objectRow( position.parent, modelId );
+		if( row >= 0 )
+		{
+			m_objects[position.parent][row].setPopulated(); // clazy:exclude=detaching-member
+		}
+	}
+}
+
+
+
+int NetworkObjectDirectory::objectRow( NetworkObject::ModelId parent, NetworkObject::ModelId object ) const
+{
+	const auto positions = m_objectPositions.constFind( object );
+	const auto objectList = m_objects.constFind( parent );
+
+	if( positions == m_objectPositions.constEnd() || objectList == m_objects.constEnd() )
+	{
+		return -1;
+	}
+
+	for( const auto& position : *positions )
 	{
-		for( auto& entry : *it )
+		if( position.parent == parent )
 		{
-			if( entry.modelId() == objectModelId )
+			if( position.row < objectList->count() && objectList->at( position.row ).modelId() == object )
 			{
-				entry.setPopulated();
-				break;
+				return position.row;
 			}
+
+			// rows are stale while removeObjects() processes multiple ranges
+			for( int row = 0; row < objectList->count(); ++row )
+			{
+				if( objectList->at( row ).modelId() == object )
+				{
+					return row;
+				}
+			}
+
+			return -1;
+		}
+	}
+
+	return -1;
+}
+
+
+
+void NetworkObjectDirectory::setObjectRow( NetworkObject::ModelId parent, NetworkObject::ModelId object, int row )
+{
+	auto& positions = m_objectPositions[object]; // clazy:exclude=detaching-member
+
+	for( auto& position : positions )
+	{
+		if( position.parent == parent )
+		{
+			position.row = row;
+			return;
 		}
 	}
+
+	positions.append( { parent, row } );
+}
+
+
+
+void NetworkObjectDirectory::removeObjectPositions( NetworkObject::ModelId parent, const NetworkObject& object )
+{
+	const auto objectModelId = object.modelId();
+
+	const auto positions = m_objectPositions.find( objectModelId );
+	if( positions != m_objectPositions.end() )
+	{
+		for( auto it = positions->begin(); it != positions->end(); )
+		{
+			it = it->parent == parent ? positions->erase( it ) : it + 1;
+		}
+
+		// object still exists below other parents
+		if( positions->isEmpty() == false )
+		{
+			return;
+		}
+
+		m_objectPositions.erase( positions );
+	}
+
+	m_objectModelIds.remove( object.uid() );
+	removeHostObjectId( object );
+
+	const auto it = m_objects.constFind( objectModelId );
+	if( it != m_objects.constEnd() )
+	{
+		const auto children = it.value();
+		m_objects.remove( objectModelId );
+
+		for( const auto& child : children )
+		{
+			removeObjectPositions( objectModelId, child );
+		}
+	}
+}
+
+
+
+void NetworkObjectDirectory::updateObjectPositions( NetworkObject::ModelId parent, int firstRow )
+{
+	const auto& objectList = m_objects[parent]; // clazy:exclude=detaching-member
+
+	for( int row = firstRow; row < objectList.count(); ++row )
+	{
+		setObjectRow( parent, objectList[row].modelId(), row );
+	}
+}
+
+
+
+void NetworkObjectDirectory::addHostObjectId( const NetworkObject& object )
+{
+	if( object.type() == NetworkObject::Type::Host )
+	{
+		const auto hostAddress = object.property( NetworkObject::Property::HostAddress ).toString().toLower();
+		if( hostAddress.isEmpty() == false )
+		{
+			m_hostObjectIds.insert( hostAddress, object.modelId() );
+		}
+	}
+}
+
+
+
+void NetworkObjectDirectory::removeHostObjectId( const NetworkObject& object )
+{
+	if( object.type() == NetworkObject::Type::Host )
+	{
+		m_hostObjectIds.remove( object.property( NetworkObject::Property::HostAddress ).toString().toLower(),
+								object.modelId() );
+	}
 }
@@ -55,6 +55,9 @@ public:
 
 	NetworkObject::ModelId rootId() const;
 
+	NetworkObject::ModelId modelId( NetworkObject::Uid uid ) const;
+	QList<NetworkObject::ModelId> hostObjectIds( const QString& hostAddress ) const;
+
 	virtual NetworkObjectList queryObjects( NetworkObject::Type type,
 											NetworkObject::Property property, const QVariant& value );
 	virtual NetworkObjectList queryParents( const NetworkObject& child );
@@ -72,8 +75,26 @@ protected:
 	void setObjectPopulated( const NetworkObject& networkObject );
 
 private:
+	struct ObjectPosition
+	{
+		NetworkObject::ModelId parent;
+		int row;
+	};
+
+	int objectRow( NetworkObject::ModelId parent, NetworkObject::ModelId object ) const;
+	void setObjectRow( NetworkObject::ModelId parent, NetworkObject::ModelId object, int row );
+	void removeObjectPositions( NetworkObject::ModelId parent, const NetworkObject& object );
+	void addHostObjectId( const NetworkObject& object );
+	void removeHostObjectId( const NetworkObject& object );
+	void updateObjectPositions( NetworkObject::ModelId parent, int firstRow );
+
 	QTimer* m_updateTimer{nullptr};
 	QHash<NetworkObject::ModelId, NetworkObjectList> m_objects{};
+	// objects with a uid derived from their directory address (e.g. LDAP computers which are
+	// members of multiple groups) can have the same model ID below multiple parents
+	QHash<NetworkObject::ModelId, QVector<ObjectPosition>> m_objectPositions{};
+	QHash<NetworkObject::Uid, NetworkObject::ModelId> m_objectModelIds{};
+	QMultiHash<QString, NetworkObject::ModelId> m_hostObjectIds{};
 	NetworkObject m_invalidObject{NetworkObject::Type::None};
 	NetworkObject m_rootObject{NetworkObject::Type::Root};
 	NetworkObjectList m_defaultObjectList{};
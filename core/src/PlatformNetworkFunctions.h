@@ -38,10 +38,17 @@ public:
 		PingProcessTimeout = PingTimeout*2
 	};
 
+	enum class Protocol {
+		TCP,
+		UDP
+	};
+
 	virtual ~PlatformNetworkFunctions() = default;
 
 	virtual bool ping( const QString& hostAddress ) = 0;
 	virtual bool configureFirewallException( const QString& applicationPath, const QString& description, bool enabled ) = 0;
+	virtual bool configureFirewallPortException( const QString& description, Protocol protocol,
+												 int firstPort, int lastPort, bool enabled ) = 0;
 
 	virtual bool configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes ) = 0;
 
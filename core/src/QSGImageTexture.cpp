@@ -64,11 +64,27 @@ QSGImageTexture::~QSGImageTexture()
 void QSGImageTexture::setImage(const QImage &image)
 {
 	m_image = image;
+	m_source_offset = QPoint();
 	m_texture_size = image.size();
 	m_has_alpha = image.hasAlphaChannel();
 	m_dirty_texture = true;
 	m_dirty_bind_options = true;
- }
+	m_dirty_region = QRegion();
+}
+
+void QSGImageTexture::updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion)
+{
+	// fall back to a full upload if there's no texture yet or the image has changed in size or format
+	if (m_texture_id == 0 || m_dirty_texture || sourceRect.size() != m_texture_size
+		|| image.rect().contains(sourceRect) == false || image.hasAlphaChannel() != bool(m_has_alpha)) {
+		setImage(sourceRect == image.rect() ? image : image.copy(sourceRect));
+		return;
+	}
+
+	m_image = image;
+	m_source_offset = sourceRect.topLeft();
+	m_dirty_region += dirtyRegion & QRect(QPoint(), sourceRect.size());
+}
 
 int QSGImageTexture::textureId() const
 {
@@ -93,6 +109,8 @@ void QSGImageTexture::bind()
 	QOpenGLFunctions *funcs = context->functions();
 	if (!m_dirty_texture) {
 		funcs->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+		if (!m_dirty_region.isEmpty() && !m_image.isNull())
+			uploadDirtyRegion(context);
 		updateBindOptions(m_dirty_bind_options);
 		m_dirty_bind_options = false;
 		return;
@@ -134,6 +152,18 @@ void QSGImageTexture::bind()
 	GLenum externalFormat = GL_RGBA;
 	GLenum internalFormat = GL_RGBA;
 
+	if (!selectTextureFormats(context, &externalFormat, &internalFormat))
+		tmp = std::move(tmp).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+	funcs->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture_size.width(), m_texture_size.height(), 0, externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
+
+	m_dirty_bind_options = false;
+	m_dirty_region = QRegion();
+	m_image = {};
+}
+
+bool QSGImageTexture::selectTextureFormats(QOpenGLContext *context, uint *externalFormat, uint *internalFormat) const
+{
 #if defined(Q_OS_ANDROID) && !defined(Q_OS_ANDROID_EMBEDDED)
 	QString *deviceName =
 			static_cast<QString *>(QGuiApplication::platformNativeInterface()->nativeResourceForIntegration("AndroidDeviceName"));
@@ -146,29 +176,59 @@ void QSGImageTexture::bind()
 #endif
 
 	if (context->hasExtension(QByteArrayLiteral("GL_EXT_bgra"))) {
-		externalFormat = GL_BGRA;
+		*externalFormat = GL_BGRA;
 #ifdef QT_OPENGL_ES
-		internalFormat = GL_BGRA;
+		*internalFormat = GL_BGRA;
 #else
 		if (context->isOpenGLES())
-			internalFormat = GL_BGRA;
+			*internalFormat = GL_BGRA;
 #endif // QT_OPENGL_ES
 	} else if (!wrongfullyReportsBgra8888Support
 			   && (context->hasExtension(QByteArrayLiteral("GL_EXT_texture_format_BGRA8888"))
 				   || context->hasExtension(QByteArrayLiteral("GL_IMG_texture_format_BGRA8888")))) {
-		externalFormat = GL_BGRA;
-		internalFormat = GL_BGRA;
+		*externalFormat = GL_BGRA;
+		*internalFormat = GL_BGRA;
 #if defined(Q_OS_DARWIN) && !defined(Q_OS_OSX)
 	} else if (context->hasExtension(QByteArrayLiteral("GL_APPLE_texture_format_BGRA8888"))) {
-		externalFormat = GL_BGRA;
-		internalFormat = GL_RGBA;
+		*externalFormat = GL_BGRA;
+		*internalFormat = GL_RGBA;
 #endif
 	} else {
-		tmp = std::move(tmp).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+		// image data has to be converted to RGBA
+		return false;
 	}
 
-	funcs->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture_size.width(), m_texture_size.height(), 0, externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
+	return true;
+}
 
-	m_dirty_bind_options = false;
+void QSGImageTexture::uploadDirtyRegion(QOpenGLContext *context)
+{
+	QOpenGLFunctions *funcs = context->functions();
+
+	GLenum externalFormat = GL_RGBA;
+	GLenum internalFormat = GL_RGBA;
+	const bool convert = !selectTextureFormats(context, &externalFormat, &internalFormat);
+
+	// upload the bounding rectangle at once if the region is too fragmented
+	QVector<QRect> rects;
+	if (m_dirty_region.rectCount() > MaxSubImageCount) {
+		rects.append(m_dirty_region.boundingRect());
+	} else {
+		rects.reserve(m_dirty_region.rectCount());
+		for (const QRect &rect : m_dirty_region)
+			rects.append(rect);
+	}
+
+	for (const QRect &rect : qAsConst(rects)) {
+		// copy to contiguous memory as GL_UNPACK_ROW_LENGTH is not available with OpenGL ES 2
+		QImage subImage = m_image.copy(rect.translated(m_source_offset));
+		if (convert)
+			subImage = std::move(subImage).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+		funcs->glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x(), rect.y(), rect.width(), rect.height(),
+							   externalFormat, GL_UNSIGNED_BYTE, subImage.constBits());
+	}
+
+	m_dirty_region = QRegion();
 	m_image = {};
 }
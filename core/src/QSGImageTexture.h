@@ -41,6 +41,9 @@
 
 #include <QSGTexture>
 #include <QImage>
+#include <QRegion>
+
+class QOpenGLContext;
 
 class QSGImageTexture : public QSGTexture
 {
@@ -62,6 +65,8 @@ public:
 	bool hasMipmaps() const override { return false; }
 
 	void setImage(const QImage &image);
+	// image is only referenced and dirty areas within sourceRect are copied when uploading
+	void updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion);
 	const QImage &image() { return m_image; }
 
 	void bind() override;
@@ -73,7 +78,14 @@ public:
 	}
 
 protected:
+	static constexpr int MaxSubImageCount = 32;
+
+	bool selectTextureFormats(QOpenGLContext *context, uint *externalFormat, uint *internalFormat) const;
+	void uploadDirtyRegion(QOpenGLContext *context);
+
 	QImage m_image;
+	QPoint m_source_offset;
+	QRegion m_dirty_region;
 
 	uint m_texture_id;
 	QSize m_texture_size;
@@ -0,0 +1,52 @@
+/*
+ * RfbExtensions.h - constants for RFB protocol extensions
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// message types, pseudo encodings and flags of the ContinuousUpdates and Fence RFB protocol
+// extensions which allow servers to push framebuffer updates without explicit requests
+class RfbExtensions
+{
+public:
+	static constexpr uint8_t EnableContinuousUpdatesMessage = 150; // client to server
+	static constexpr uint8_t EndOfContinuousUpdatesMessage = 150; // server to client
+	static constexpr uint8_t FenceMessage = 248;
+
+	static constexpr int EnableContinuousUpdatesMessageSize = 10;
+	static constexpr int FenceMessageHeaderSize = 9;
+	static constexpr int FenceMaximumPayloadSize = 64;
+
+	static constexpr int32_t EncodingContinuousUpdates = -313;
+	static constexpr int32_t EncodingFence = -312;
+
+	static constexpr uint32_t FenceFlagBlockBefore = 0x00000001;
+	static constexpr uint32_t FenceFlagBlockAfter = 0x00000002;
+	static constexpr uint32_t FenceFlagSyncNext = 0x00000004;
+	static constexpr uint32_t FenceFlagRequest = 0x80000000;
+	static constexpr uint32_t FenceFlagsSupported = FenceFlagBlockBefore | FenceFlagBlockAfter |
+													FenceFlagSyncNext | FenceFlagRequest;
+
+} ;
@@ -30,8 +30,10 @@
 #include <QMetaEnum>
 #include <QPainter>
 #include <QRegularExpression>
+#include <QThread>
 
 #include "Screenshot.h"
+#include "ScreenshotIndex.h"
 #include "VeyonConfiguration.h"
 #include "Computer.h"
 #include "ComputerControlInterface.h"
@@ -50,7 +52,26 @@ Screenshot::Screenshot( const QString &fileName, QObject* parent ) :
 
 
 
+Screenshot::Screenshot( const QString& fileName, const QImage& image, QObject* parent ) :
+	QObject( parent ),
+	m_fileName( fileName ),
+	m_image( image )
+{
+}
+
+
+
 void Screenshot::take( const ComputerControlInterface::Pointer& computerControlInterface )
+{
+	if( capture( computerControlInterface ) && save() == false )
+	{
+		showError( tr( "Could not open screenshot file %1 for writing." ).arg( m_fileName ) );
+	}
+}
+
+
+
+bool Screenshot::capture( const ComputerControlInterface::Pointer& computerControlInterface )
 {
 	auto userLogin = computerControlInterface->userLoginName();
 	if( userLogin.isEmpty() )
@@ -62,51 +83,50 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 
 	if( VeyonCore::filesystem().ensurePathExists( dir ) == false )
 	{
-		const auto msg = tr( "Could not take a screenshot as directory %1 doesn't exist and couldn't be created." ).arg( dir );
-		vCritical() << msg.toUtf8().constData();
-		if( qobject_cast<QApplication *>( QCoreApplication::instance() ) )
-		{
-			QMessageBox::critical( nullptr, tr( "Screenshot" ), msg );
-		}
-
-		return;
+		showError( tr( "Could not take a screenshot as directory %1 doesn't exist and couldn't be created." ).arg( dir ) );
+		return false;
 	}
 
 	// construct filename
 	m_fileName = dir + QDir::separator() + constructFileName( userLogin, computerControlInterface->computer().hostAddress() );
 
+	// collect meta data
+	m_user = userLogin;
+	if( computerControlInterface->userFullName().isEmpty() == false )
+	{
+		m_user = QStringLiteral( "%1 (%2)" ).arg( userLogin, computerControlInterface->userFullName() );
+	}
+
+	m_host = computerControlInterface->computer().hostAddress();
+	m_date = QDate::currentDate().toString( Qt::ISODate );
+	m_time = QTime::currentTime().toString( Qt::ISODate );
+
+	m_compressionLevel = VeyonCore::config().screenshotCompressionLevel();
+
+	// only take a shallow copy here - the framebuffer gets detached when drawing the caption in save()
+	m_image = computerControlInterface->screen();
+
+	return m_image.isNull() == false;
+}
+
+
+
+bool Screenshot::save()
+{
 	QFile outputFile( m_fileName );
 	if( VeyonCore::platform().filesystemFunctions().openFileSafely(
 			&outputFile,
 			QFile::WriteOnly | QFile::Truncate,
 			QFile::ReadOwner | QFile::WriteOwner ) == false )
 	{
-		const auto msg = tr( "Could not open screenshot file %1 for writing." ).arg( m_fileName );
-		vCritical() << msg.toUtf8().constData();
-		if( qobject_cast<QApplication *>( QCoreApplication::instance() ) )
-		{
-			QMessageBox::critical( nullptr, tr( "Screenshot" ), msg );
-		}
-
-		return;
+		vCritical() << "could not open screenshot file" << m_fileName << "for writing";
+		return false;
 	}
 
-	// construct caption
-	auto user = userLogin;
-	if( computerControlInterface->userFullName().isEmpty() == false )
-	{
-		user = QStringLiteral( "%1 (%2)" ).arg( userLogin, computerControlInterface->userFullName() );
-	}
+	const auto caption = QStringLiteral( "%1@%2 %3 %4" ).arg( m_user, m_host, m_date, m_time );
 
-	const auto host = computerControlInterface->computer().hostAddress();
-	const auto date = QDate::currentDate().toString( Qt::ISODate );
-	const auto time = QTime::currentTime().toString( Qt::ISODate );
-
-	const auto caption = QStringLiteral( "%1@%2 %3 %4" ).arg( user, host, date, time );
-
-	m_image = computerControlInterface->screen();
-
-	QPixmap icon( QStringLiteral( ":/core/icon16.png" ) );
+	// QPixmap must not be used outside the main thread
+	const QImage icon( QStringLiteral( ":/core/icon16.png" ) );
 
 	QPainter painter( &m_image );
 
@@ -137,17 +157,25 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 	const auto textY = rect.y() + PADDING + fontMetrics.ascent();
 
 	painter.fillRect( rect, QColor( 255, 255, 255, 160 ) );
-	painter.drawPixmap( iconX, iconY, icon );
+	painter.drawImage( iconX, iconY, icon );
 	painter.drawText( textX, textY, caption );
+	painter.end();
 
-	m_image.setText( metaDataKey( MetaData::User ), user );
-	m_image.setText( metaDataKey( MetaData::Host ), host );
-	m_image.setText( metaDataKey( MetaData::Date ), date );
-	m_image.setText( metaDataKey( MetaData::Time ), time );
+	m_image.setText( metaDataKey( MetaData::User ), m_user );
+	m_image.setText( metaDataKey( MetaData::Host ), m_host );
+	m_image.setText( metaDataKey( MetaData::Date ), m_date );
+	m_image.setText( metaDataKey( MetaData::Time ), m_time );
 
-	m_image.save( &outputFile, "PNG", 50 );
+	const auto success = m_image.save( &outputFile, "PNG", pngQuality( m_compressionLevel ) );
+	if( success )
+	{
+		saveThumbnail( m_fileName, m_image );
+		ScreenshotIndex::addScreenshot( m_fileName, { m_user, m_host, m_date, m_time } );
+	}
 
 	Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+
+	return success;
 }
 
 
@@ -202,6 +230,92 @@ QString Screenshot::metaDataKey( MetaData key )
 
 
 
+QString Screenshot::thumbnailFileName( const QString& fileName )
+{
+	const QFileInfo fileInfo( fileName );
+
+	return fileInfo.path() + QDir::separator() + QStringLiteral(".thumbnails") + QDir::separator() + fileInfo.fileName();
+}
+
+
+
+QImage Screenshot::loadThumbnail( const QString& fileName )
+{
+	const QFileInfo fileInfo( fileName );
+	const QFileInfo thumbnailFileInfo( thumbnailFileName( fileName ) );
+
+	if( thumbnailFileInfo.exists() && thumbnailFileInfo.lastModified() >= fileInfo.lastModified() )
+	{
+		QImage thumbnail;
+		if( thumbnail.load( thumbnailFileInfo.filePath() ) )
+		{
+			return thumbnail;
+		}
+	}
+
+	// no (valid) sidecar file yet (e.g. screenshots taken by previous versions) so create it now
+	QImage image;
+	if( fileInfo.isFile() == false || image.load( fileName ) == false )
+	{
+		return {};
+	}
+
+	return saveThumbnail( fileName, image );
+}
+
+
+
+bool Screenshot::removeThumbnail( const QString& fileName )
+{
+	return QFile::remove( thumbnailFileName( fileName ) );
+}
+
+
+
+QImage Screenshot::saveThumbnail( const QString& fileName, const QImage& image )
+{
+	auto thumbnail = image.scaled( ThumbnailWidth, ThumbnailHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+
+	const auto textKeys = image.textKeys();
+	for( const auto& key : textKeys )
+	{
+		thumbnail.setText( key, image.text( key ) );
+	}
+
+	const auto thumbnailPath = QFileInfo( thumbnailFileName( fileName ) ).path();
+	if( QDir().mkpath( thumbnailPath ) == false ||
+		thumbnail.save( thumbnailFileName( fileName ), "PNG" ) == false )
+	{
+		vWarning() << "could not write thumbnail for" << fileName;
+	}
+
+	return thumbnail;
+}
+
+
+
+void Screenshot::showError( const QString& message )
+{
+	vCritical() << message.toUtf8().constData();
+
+	if( qobject_cast<QApplication *>( QCoreApplication::instance() ) &&
+		QThread::currentThread() == QCoreApplication::instance()->thread() )
+	{
+		QMessageBox::critical( nullptr, tr( "Screenshot" ), message );
+	}
+}
+
+
+
+int Screenshot::pngQuality( int compressionLevel )
+{
+	// QImageWriter maps quality values (0-100) for PNG to zlib compression levels via (100-quality)*9/91
+	// so choose the highest quality value resulting in the requested compression level
+	return 100 - ( qBound( 0, compressionLevel, 9 ) * 91 + 8 ) / 9;
+}
+
+
+
 QString Screenshot::property( const QString& key, int section ) const
 {
 	const auto embeddedProperty = m_image.text( key );
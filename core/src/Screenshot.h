@@ -45,9 +45,17 @@ public:
 	Q_ENUM(MetaData)
 
 	explicit Screenshot( const QString &fileName = {}, QObject* parent = nullptr );
+	Screenshot( const QString& fileName, const QImage& image, QObject* parent = nullptr );
 
 	void take( const ComputerControlInterface::Pointer& computerControlInterface );
 
+	// grabs the current screen of the given computer without any further processing
+	// and therefore should be called from the main thread only
+	bool capture( const ComputerControlInterface::Pointer& computerControlInterface );
+
+	// renders caption and meta data and writes the encoded image to disk - may be called from any thread
+	bool save();
+
 	bool isValid() const
 	{
 		return !fileName().isEmpty() && !image().isNull();
@@ -79,8 +87,20 @@ public:
 
 	static QString metaDataKey( MetaData key );
 
+	// thumbnails including all meta data are stored as sidecar files in a hidden subdirectory
+	// so the screenshot management can show previews without decoding the full images
+	static QString thumbnailFileName( const QString& fileName );
+	static QImage loadThumbnail( const QString& fileName );
+	static bool removeThumbnail( const QString& fileName );
+
 private:
 	static constexpr auto ScreenshotLabelFontPointSize = 14;
+	static constexpr auto ThumbnailWidth = 480;
+	static constexpr auto ThumbnailHeight = 270;
+
+	static void showError( const QString& message );
+	static QImage saveThumbnail( const QString& fileName, const QImage& image );
+	static int pngQuality( int compressionLevel );
 
 	QString property( const QString& key, int section ) const;
 	QString fileNameSection( int n ) const;
@@ -88,5 +108,11 @@ private:
 	QString m_fileName{};
 	QImage m_image{};
 
+	QString m_user{};
+	QString m_host{};
+	QString m_date{};
+	QString m_time{};
+	int m_compressionLevel{0};
+
 } ;
 
@@ -0,0 +1,293 @@
+/*
+ * ScreenshotIndex.cpp - implementation of ScreenshotIndex class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSaveFile>
+
+#include "ScreenshotIndex.h"
+
+// serializes appends from background screenshot encoders with compactions
+static QMutex __screenshotIndexMutex;
+
+
+ScreenshotIndex::ScreenshotIndex( const QString& directory ) :
+	m_directory( directory )
+{
+}
+
+
+
+bool ScreenshotIndex::update()
+{
+	if( QFileInfo::exists( indexFileName( m_directory ) ) == false )
+	{
+		rebuild();
+	}
+
+	QFile indexFile( indexFileName( m_directory ) );
+	if( indexFile.open( QFile::ReadOnly ) == false )
+	{
+		vWarning() << "could not open" << indexFile.fileName();
+		return false;
+	}
+
+	bool modified = false;
+
+	// index has been rewritten (e.g. compacted by another instance) so read it completely
+	if( indexFile.size() < m_readPosition )
+	{
+		m_entries.clear();
+		m_readPosition = 0;
+		m_removalRecordCount = 0;
+		m_synchronizedLastModified = {};
+		modified = true;
+	}
+
+	indexFile.seek( m_readPosition );
+
+	while( indexFile.atEnd() == false )
+	{
+		const auto line = indexFile.readLine();
+		if( line.endsWith( '\n' ) == false )
+		{
+			// record is still being written
+			break;
+		}
+
+		m_readPosition += line.size();
+
+		const auto record = QJsonDocument::fromJson( line ).object();
+		const auto fileName = record.value( QStringLiteral("file") ).toString();
+		if( fileName.isEmpty() )
+		{
+			continue;
+		}
+
+		if( record.value( QStringLiteral("removed") ).toBool() )
+		{
+			modified |= m_entries.remove( fileName ) > 0;
+			++m_removalRecordCount;
+		}
+		else
+		{
+			m_entries[fileName] = { record.value( QStringLiteral("user") ).toString(),
+									record.value( QStringLiteral("host") ).toString(),
+									record.value( QStringLiteral("date") ).toString(),
+									record.value( QStringLiteral("time") ).toString() };
+			modified = true;
+		}
+	}
+
+	indexFile.close();
+
+	if( synchronize() )
+	{
+		compact();
+		modified = true;
+	}
+	else if( m_removalRecordCount >= MinimumCompactionRecordCount &&
+			 m_removalRecordCount > m_entries.size() )
+	{
+		compact();
+	}
+
+	return modified;
+}
+
+
+
+void ScreenshotIndex::addScreenshot( const QString& fileName, const Entry& entry )
+{
+	const QFileInfo fileInfo( fileName );
+
+	appendRecord( fileInfo.path(), entryToRecord( fileInfo.fileName(), entry ) );
+}
+
+
+
+void ScreenshotIndex::removeScreenshot( const QString& fileName )
+{
+	const QFileInfo fileInfo( fileName );
+
+	appendRecord( fileInfo.path(), QJsonObject{ { QStringLiteral("file"), fileInfo.fileName() },
+												{ QStringLiteral("removed"), true } } );
+}
+
+
+
+QString ScreenshotIndex::indexFileName( const QString& directory )
+{
+	return directory + QDir::separator() + QStringLiteral(".thumbnails") + QDir::separator() + QStringLiteral("index.jsonl");
+}
+
+
+
+void ScreenshotIndex::rebuild()
+{
+	QMutexLocker locker( &__screenshotIndexMutex );
+
+	// screenshots taken by previous versions - meta data is derived from the file names
+	// (see Screenshot::constructFileName()) so no image has to be decoded
+	const QDir dir( m_directory );
+	const auto files = dir.entryList( { QStringLiteral("*.png") }, QDir::Filter::Files, QDir::SortFlag::Name );
+
+	vDebug() << "building index for" << files.size() << "screenshots in" << m_directory;
+
+	QByteArray data;
+
+	for( const auto& file : files )
+	{
+		data += QJsonDocument( entryToRecord( file, entryFromFileName( file ) ) ).toJson( QJsonDocument::Compact ) + '\n';
+	}
+
+	QSaveFile indexFile( indexFileName( m_directory ) );
+	if( QDir().mkpath( QFileInfo( indexFile.fileName() ).path() ) == false ||
+		indexFile.open( QFile::WriteOnly ) == false ||
+		indexFile.write( data ) != data.size() ||
+		indexFile.commit() == false )
+	{
+		vWarning() << "could not write" << indexFile.fileName();
+	}
+}
+
+
+
+void ScreenshotIndex::compact()
+{
+	QMutexLocker locker( &__screenshotIndexMutex );
+
+	QFile indexFile( indexFileName( m_directory ) );
+
+	// do not lose records appended since the last update
+	if( indexFile.size() != m_readPosition )
+	{
+		return;
+	}
+
+	QByteArray data;
+
+	for( auto it = m_entries.constBegin(), end = m_entries.constEnd(); it != end; ++it )
+	{
+		data += QJsonDocument( entryToRecord( it.key(), it.value() ) ).toJson( QJsonDocument::Compact ) + '\n';
+	}
+
+	QSaveFile compactedIndexFile( indexFile.fileName() );
+	if( compactedIndexFile.open( QFile::WriteOnly ) &&
+		compactedIndexFile.write( data ) == data.size() &&
+		compactedIndexFile.commit() )
+	{
+		m_readPosition = data.size();
+		m_removalRecordCount = 0;
+	}
+}
+
+
+
+bool ScreenshotIndex::synchronize()
+{
+	const auto lastModified = QFileInfo( m_directory ).lastModified();
+
+	// directory timestamps may have a resolution of one second only so keep checking
+	// until the last modification is older than the previous check
+	if( lastModified == m_synchronizedLastModified &&
+		m_synchronizedLastModified.msecsTo( m_synchronizationTime ) >= 1000 )
+	{
+		return false;
+	}
+
+	m_synchronizedLastModified = lastModified;
+	m_synchronizationTime = QDateTime::currentDateTime();
+
+	auto files = QDir( m_directory ).entryList( { QStringLiteral("*.png") }, QDir::Filter::Files, QDir::SortFlag::NoSort );
+	files.sort();
+
+	if( files == m_entries.keys() )
+	{
+		return false;
+	}
+
+	vDebug() << "screenshots in" << m_directory << "have been modified externally";
+
+	// keep meta data of known screenshots
+	Entries entries;
+	for( const auto& file : qAsConst(files) )
+	{
+		const auto it = m_entries.constFind( file );
+		entries[file] = it != m_entries.constEnd() ? it.value() : entryFromFileName( file );
+	}
+
+	m_entries = entries;
+
+	return true;
+}
+
+
+
+void ScreenshotIndex::appendRecord( const QString& directory, const QJsonObject& record )
+{
+	QMutexLocker locker( &__screenshotIndexMutex );
+
+	QFile indexFile( indexFileName( directory ) );
+
+	// index is built from the directory contents on first use
+	if( indexFile.exists() == false )
+	{
+		return;
+	}
+
+	if( indexFile.open( QFile::WriteOnly | QFile::Append ) == false ||
+		indexFile.write( QJsonDocument( record ).toJson( QJsonDocument::Compact ) + '\n' ) < 0 )
+	{
+		vWarning() << "could not append to" << indexFile.fileName();
+	}
+}
+
+
+
+ScreenshotIndex::Entry ScreenshotIndex::entryFromFileName( const QString& fileName )
+{
+	const auto baseName = QFileInfo( fileName ).completeBaseName();
+
+	return { baseName.section( QLatin1Char('_'), 0, 0 ),
+			 baseName.section( QLatin1Char('_'), 1, 1 ),
+			 baseName.section( QLatin1Char('_'), 2, 2 ),
+			 baseName.section( QLatin1Char('_'), 3, 3 ) };
+}
+
+
+
+QJsonObject ScreenshotIndex::entryToRecord( const QString& fileName, const Entry& entry )
+{
+	return QJsonObject{
+		{ QStringLiteral("file"), fileName },
+		{ QStringLiteral("user"), entry.user },
+		{ QStringLiteral("host"), entry.host },
+		{ QStringLiteral("date"), entry.date },
+		{ QStringLiteral("time"), entry.time }
+	};
+}
@@ -0,0 +1,86 @@
+/*
+ * ScreenshotIndex.h - declaration of ScreenshotIndex class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QMap>
+
+#include "VeyonCore.h"
+
+class QJsonObject;
+
+// append-only on-disk index of all screenshots in a directory including their meta data
+// so screenshots can be listed without scanning the directory or decoding any images
+class VEYON_CORE_EXPORT ScreenshotIndex
+{
+public:
+	struct Entry
+	{
+		QString user;
+		QString host;
+		QString date;
+		QString time;
+	};
+
+	using Entries = QMap<QString, Entry>;
+
+	explicit ScreenshotIndex( const QString& directory );
+
+	// reads records appended since the last call (or builds the index if it does not exist yet),
+	// picks up screenshots added or removed outside of Veyon and returns whether any entries
+	// were added or removed
+	bool update();
+
+	// entries sorted by file name
+	const Entries& entries() const
+	{
+		return m_entries;
+	}
+
+	static void addScreenshot( const QString& fileName, const Entry& entry );
+	static void removeScreenshot( const QString& fileName );
+
+	static QString indexFileName( const QString& directory );
+
+private:
+	static constexpr auto MinimumCompactionRecordCount = 256;
+
+	void rebuild();
+	void compact();
+	bool synchronize();
+
+	static Entry entryFromFileName( const QString& fileName );
+
+	static void appendRecord( const QString& directory, const QJsonObject& record );
+	static QJsonObject entryToRecord( const QString& fileName, const Entry& entry );
+
+	QString m_directory;
+	Entries m_entries{};
+	qint64 m_readPosition{0};
+	int m_removalRecordCount{0};
+	QDateTime m_synchronizedLastModified{};
+	QDateTime m_synchronizationTime{};
+
+};
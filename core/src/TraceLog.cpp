@@ -0,0 +1,307 @@
+/*
+ * TraceLog.cpp - implementation of TraceLog class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QThread>
+
+#include "EnumHelper.h"
+#include "TraceLog.h"
+
+
+std::atomic<TraceLog *> TraceLog::s_instance{nullptr};
+std::atomic<int> TraceLog::s_activeRecorders{0};
+
+static constexpr char __traceLogMagic[] = "VEYONTRC";
+
+
+class TraceLogWriterThread : public QThread
+{
+public:
+	explicit TraceLogWriterThread( TraceLog* traceLog ) :
+		m_traceLog( traceLog )
+	{
+	}
+
+protected:
+	void run() override
+	{
+		m_traceLog->runWriter();
+	}
+
+private:
+	TraceLog* m_traceLog;
+
+} ;
+
+
+
+TraceLog::TraceLog( const QString& fileName ) :
+	m_file( fileName )
+{
+	if( m_file.open( QFile::WriteOnly | QFile::Truncate ) == false )
+	{
+		vCritical() << "could not open trace file" << fileName;
+		return;
+	}
+
+	Header header{};
+	memcpy( header.magic, __traceLogMagic, sizeof(header.magic) );
+	header.version = FormatVersion;
+	header.recordSize = sizeof(Record);
+	header.startTime = QDateTime::currentMSecsSinceEpoch();
+	header.processId = QCoreApplication::applicationPid();
+
+	m_file.write( reinterpret_cast<const char *>( &header ), sizeof(header) );
+
+	m_timer.start();
+
+	m_writerThread = new TraceLogWriterThread( this );
+	m_writerThread->setObjectName( QStringLiteral("TraceLogWriter") );
+	m_writerThread->start( QThread::LowPriority );
+
+	s_instance = this;
+
+	vDebug() << "writing trace to" << fileName;
+}
+
+
+
+TraceLog::~TraceLog()
+{
+	// stop handing out this instance and wait until all recorders which
+	// may have obtained it before have finished appending
+	auto instance = this;
+	s_instance.compare_exchange_strong( instance, nullptr );
+
+	while( s_activeRecorders.load() > 0 )
+	{
+		QThread::yieldCurrentThread();
+	}
+
+	if( m_writerThread )
+	{
+		// writer thread writes all pending records before quitting
+		m_writerMutex.lock();
+		m_writerQuit = true;
+		m_writerWaitCondition.wakeAll();
+		m_writerMutex.unlock();
+
+		m_writerThread->wait();
+		delete m_writerThread;
+	}
+
+	if( m_droppedRecordCount > 0 )
+	{
+		vWarning() << m_droppedRecordCount << "trace records dropped";
+	}
+}
+
+
+
+void TraceLog::append( Event event, qint64 argument0, qint64 argument1, qint64 argument2 )
+{
+	Record record{
+		quint64( m_timer.nsecsElapsed() ),
+		quint64( reinterpret_cast<quintptr>( QThread::currentThreadId() ) ),
+		quint16( event ),
+		{ 0, 0, 0 },
+		{ argument0, argument1, argument2 }
+	};
+
+	// never block hot paths - the number of dropped records is reported on shutdown
+	if( m_recordQueue.enqueue( std::move( record ) ) == false )
+	{
+		++m_droppedRecordCount;
+	}
+}
+
+
+
+void TraceLog::runWriter()
+{
+	QByteArray buffer;
+	buffer.reserve( BufferSize );
+
+	Record record{};
+
+	for(;;)
+	{
+		m_writerMutex.lock();
+		const auto quit = m_writerQuit;
+		m_writerMutex.unlock();
+
+		while( m_recordQueue.dequeue( record ) )
+		{
+			buffer.append( reinterpret_cast<const char *>( &record ), sizeof(record) );
+
+			if( buffer.size() >= BufferSize )
+			{
+				writeBuffer( buffer );
+			}
+		}
+
+		writeBuffer( buffer );
+
+		if( quit )
+		{
+			break;
+		}
+
+		m_writerMutex.lock();
+		if( m_writerQuit == false )
+		{
+			m_writerWaitCondition.wait( &m_writerMutex, WriterInterval );
+		}
+		m_writerMutex.unlock();
+	}
+}
+
+
+
+void TraceLog::writeBuffer( QByteArray& buffer )
+{
+	if( buffer.isEmpty() == false && m_file.isOpen() )
+	{
+		m_file.write( buffer );
+		m_file.flush();
+	}
+
+	buffer.clear();
+}
+
+
+
+QByteArray TraceLog::eventArgumentName( Event event, int argument )
+{
+	QList<QByteArray> names;
+
+	switch( event )
+	{
+	case Event::VncUpdateRequest: names = { "incremental" }; break;
+	case Event::VncUpdateComplete: names = { "duration", "pixels", "rects" }; break;
+	case Event::VncProxyForwardToClient:
+	case Event::VncProxyForwardToServer: names = { "bytes", "messageType" }; break;
+	case Event::DemoServerEnqueue: names = { "bytes", "queueSize", "keyFrame" }; break;
+	case Event::DemoServerSend: names = { "bytes", "messages", "keyFrame" }; break;
+	case Event::FeatureMessageSend:
+	case Event::FeatureMessageReceive: names = { "feature", "command" }; break;
+	case Event::VncInputSend: names = { "bytes", "events", "latency" }; break;
+	default: break;
+	}
+
+	return names.value( argument );
+}
+
+
+
+bool TraceLog::convertToChromeTraceFormat( QIODevice* input, QIODevice* output )
+{
+	Header header{};
+	if( input->read( reinterpret_cast<char *>( &header ), sizeof(header) ) != qint64(sizeof(header)) || // Flawfinder: ignore
+		memcmp( header.magic, __traceLogMagic, sizeof(header.magic) ) != 0 ||
+		header.version != FormatVersion ||
+		header.recordSize != sizeof(Record) )
+	{
+		vCritical() << "invalid or unsupported trace file";
+		return false;
+	}
+
+	// map native thread IDs to small numbers for better readability
+	QHash<quint64, int> threadIds;
+
+	output->write( "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"startTime\":\"" );
+	output->write( QDateTime::fromMSecsSinceEpoch( header.startTime ).toString( QStringLiteral("yyyy-MM-ddTHH:mm:ss.zzz") ).toUtf8() );
+	output->write( "\"},\"traceEvents\":[\n" );
+
+	Record record{};
+	bool first = true;
+
+	while( input->read( reinterpret_cast<char *>( &record ), sizeof(record) ) == qint64(sizeof(record)) ) // Flawfinder: ignore
+	{
+		if( record.event >= quint16(Event::EventCount) )
+		{
+			vWarning() << "skipping record with invalid event" << record.event;
+			continue;
+		}
+
+		const auto event = Event( record.event );
+
+		auto threadId = threadIds.value( record.threadId, -1 );
+		if( threadId < 0 )
+		{
+			threadId = threadIds.size() + 1;
+			threadIds[record.threadId] = threadId;
+		}
+
+		// events with a duration end at their timestamp
+		const auto hasDuration = event == Event::VncUpdateComplete;
+		auto timestamp = double(record.timestamp) / 1000;
+		if( hasDuration )
+		{
+			timestamp -= double(record.arguments[0]) / 1000;
+		}
+
+		QByteArray line = first ? "{" : ",\n{";
+		first = false;
+
+		line += "\"name\":\"" + EnumHelper::toString( event ).toUtf8() + "\",\"cat\":\"veyon\"";
+		line += ",\"pid\":" + QByteArray::number( header.processId );
+		line += ",\"tid\":" + QByteArray::number( threadId );
+		line += ",\"ts\":" + QByteArray::number( timestamp, 'f', 3 );
+
+		if( hasDuration )
+		{
+			line += ",\"ph\":\"X\",\"dur\":" + QByteArray::number( double(record.arguments[0]) / 1000, 'f', 3 );
+		}
+		else
+		{
+			line += ",\"ph\":\"i\",\"s\":\"t\"";
+		}
+
+		line += ",\"args\":{";
+		bool firstArgument = true;
+		for( int i = 0; i < ArgumentCount; ++i )
+		{
+			const auto name = eventArgumentName( event, i );
+			if( name.isEmpty() == false )
+			{
+				line += ( firstArgument ? "\"" : ",\"" ) + name + "\":" + QByteArray::number( record.arguments[i] );
+				firstArgument = false;
+			}
+		}
+		line += "}}";
+
+		if( output->write( line ) != line.size() )
+		{
+			return false;
+		}
+	}
+
+	output->write( "\n]}\n" );
+
+	return true;
+}
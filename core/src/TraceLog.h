@@ -0,0 +1,146 @@
+/*
+ * TraceLog.h - declaration of TraceLog class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "MpscQueue.h"
+#include "VeyonCore.h"
+
+class QIODevice;
+class TraceLogWriterThread;
+
+// compact binary trace of hot path events with fixed-size records - enabled by setting
+// the environment variable VEYON_TRACE_DIRECTORY
+class VEYON_CORE_EXPORT TraceLog
+{
+	Q_GADGET
+public:
+	enum class Event : quint16
+	{
+		VncUpdateRequest,
+		VncUpdateComplete,
+		VncProxyForwardToClient,
+		VncProxyForwardToServer,
+		DemoServerEnqueue,
+		DemoServerSend,
+		FeatureMessageSend,
+		FeatureMessageReceive,
+		VncInputSend,
+		EventCount
+	};
+	Q_ENUM(Event)
+
+	static constexpr int ArgumentCount = 3;
+
+	struct Record
+	{
+		quint64 timestamp; // nanoseconds since start of trace
+		quint64 threadId;
+		quint16 event;
+		quint16 reserved[3];
+		qint64 arguments[ArgumentCount];
+	};
+
+	explicit TraceLog( const QString& fileName );
+	~TraceLog();
+
+	static const char* directoryEnvironmentVariable()
+	{
+		return "VEYON_TRACE_DIRECTORY";
+	}
+
+	static bool isEnabled()
+	{
+		return s_instance.load( std::memory_order_acquire ) != nullptr;
+	}
+
+	static void record( Event event, qint64 argument0 = 0, qint64 argument1 = 0, qint64 argument2 = 0 )
+	{
+		// cheap check so disabled tracing doesn't touch shared counters
+		if( s_instance.load( std::memory_order_relaxed ) == nullptr )
+		{
+			return;
+		}
+
+		// announce access before loading the instance again so the destructor can wait for us
+		s_activeRecorders.fetch_add( 1 );
+
+		auto instance = s_instance.load();
+		if( instance )
+		{
+			instance->append( event, argument0, argument1, argument2 );
+		}
+
+		s_activeRecorders.fetch_sub( 1 );
+	}
+
+	static bool convertToChromeTraceFormat( QIODevice* input, QIODevice* output );
+
+private:
+	struct Header
+	{
+		char magic[8];
+		quint32 version;
+		quint32 recordSize;
+		qint64 startTime; // milliseconds since epoch
+		qint64 processId;
+	};
+
+	friend class TraceLogWriterThread;
+
+	static constexpr quint32 FormatVersion = 1;
+	static constexpr int BufferSize = 64*1024;
+	static constexpr int RecordQueueSize = 64*1024; // must be a power of two
+	static constexpr int WriterInterval = 50;
+
+	void append( Event event, qint64 argument0, qint64 argument1, qint64 argument2 );
+
+	// executed by writer thread
+	void runWriter();
+	void writeBuffer( QByteArray& buffer );
+
+	static QByteArray eventArgumentName( Event event, int argument );
+
+	static std::atomic<TraceLog *> s_instance;
+	static std::atomic<int> s_activeRecorders;
+
+	QFile m_file;
+	QElapsedTimer m_timer{};
+
+	// records are queued without locking and written by a background thread
+	MpscQueue<Record> m_recordQueue{RecordQueueSize};
+	std::atomic<quint64> m_droppedRecordCount{0};
+	TraceLogWriterThread* m_writerThread{nullptr};
+	QMutex m_writerMutex{};
+	QWaitCondition m_writerWaitCondition{};
+	bool m_writerQuit{false};
+
+} ;
@@ -114,9 +114,8 @@ bool VeyonConnection::handleServerMessage( rfbClient* client, uint8_t msg )
 		return true;
 	}
 
-	vCritical() << "unknown message type" << int( msg )
-				<< "from server. Closing connection. Will re-open it later.";
-
+	// message may be handled by another protocol extension, otherwise LibVNCClient
+	// reports the unknown message type and closes the connection
 	return false;
 }
 
@@ -39,6 +39,7 @@
 #include "ComputerControlInterface.h"
 #include "Filesystem.h"
 #include "HostAddress.h"
+#include "HostResolver.h"
 #include "Logger.h"
 #include "NetworkObjectDirectoryManager.h"
 #include "PlatformPluginManager.h"
@@ -46,6 +47,7 @@
 #include "PlatformSessionFunctions.h"
 #include "PluginManager.h"
 #include "QmlCore.h"
+#include "TraceLog.h"
 #include "TranslationLoader.h"
 #include "UserGroupsBackendManager.h"
 #include "VeyonConfiguration.h"
@@ -58,6 +60,7 @@ VeyonCore* VeyonCore::s_instance = nullptr;
 VeyonCore::VeyonCore( QCoreApplication* application, Component component, const QString& appComponentName ) :
 	QObject( application ),
 	m_filesystem( new Filesystem ),
+	m_hostResolver( new HostResolver ),
 	m_config( nullptr ),
 	m_logger( nullptr ),
 	m_authenticationCredentials( nullptr ),
@@ -126,6 +129,12 @@ VeyonCore::~VeyonCore()
 	delete m_pluginManager;
 	m_pluginManager = nullptr;
 
+	delete m_hostResolver;
+	m_hostResolver = nullptr;
+
+	delete m_traceLog;
+	m_traceLog = nullptr;
+
 	delete m_logger;
 	m_logger = nullptr;
 
@@ -561,6 +570,14 @@ void VeyonCore::initLogging( const QString& appComponentName )
 	m_debugging = ( m_logger->logLevel() >= Logger::LogLevel::Debug );
 
 	VncConnection::initLogging( isDebugging() );
+
+	const auto traceDirectory = QString::fromLocal8Bit( qgetenv( TraceLog::directoryEnvironmentVariable() ) );
+	if( traceDirectory.isEmpty() == false )
+	{
+		m_traceLog = new TraceLog( QDir( traceDirectory ).filePath(
+									   QStringLiteral("Veyon%1-%2.trace").arg( appComponentName ).
+									   arg( QCoreApplication::applicationPid() ) ) );
+	}
 }
 
 
@@ -49,12 +49,14 @@ class AuthenticationManager;
 class BuiltinFeatures;
 class CryptoCore;
 class Filesystem;
+class HostResolver;
 class Logger;
 class NetworkObjectDirectoryManager;
 class PlatformPluginInterface;
 class PlatformPluginManager;
 class PluginManager;
 class QmlCore;
+class TraceLog;
 class UserGroupsBackendManager;
 class VeyonConfiguration;
 
@@ -162,6 +164,11 @@ public:
 		return *( instance()->m_filesystem );
 	}
 
+	static HostResolver& hostResolver()
+	{
+		return *( instance()->m_hostResolver );
+	}
+
 	static void setupApplicationParameters();
 
 	static int sessionId()
@@ -199,8 +206,10 @@ private:
 	static VeyonCore* s_instance;
 
 	Filesystem* m_filesystem;
+	HostResolver* m_hostResolver;
 	VeyonConfiguration* m_config;
 	Logger* m_logger;
+	TraceLog* m_traceLog{nullptr};
 	AuthenticationCredentials* m_authenticationCredentials;
 	AuthenticationManager* m_authenticationManager;
 	CryptoCore* m_cryptoCore;
@@ -32,6 +32,10 @@ extern "C"
 #include <QRegion>
 #include <QTcpSocket>
 
+#include "AuthenticationPluginInterface.h"
+#include "PlatformPluginInterface.h"
+#include "PlatformUserFunctions.h"
+#include "VariantArrayMessage.h"
 #include "VncClientProtocol.h"
 
 
@@ -98,6 +102,12 @@ bool VncClientProtocol::read() // Flawfinder: ignore
 	case State::SecurityChallenge:
 		return receiveSecurityChallenge();
 
+	case State::AuthenticationMethods:
+		return receiveAuthenticationMethods();
+
+	case State::AuthenticationAck:
+		return receiveAuthenticationAck();
+
 	case State::SecurityResult:
 		return receiveSecurityResult();
 
@@ -286,7 +296,12 @@ bool VncClientProtocol::receiveSecurityTypes()
 
 		char securityType = rfbSecTypeInvalid;
 
-		if( securityTypeList.contains( rfbSecTypeVncAuth ) )
+		if( m_authenticationPlugin && securityTypeList.contains( VeyonCore::RfbSecurityTypeVeyon ) )
+		{
+			securityType = VeyonCore::RfbSecurityTypeVeyon;
+			m_state = State::AuthenticationMethods;
+		}
+		else if( securityTypeList.contains( rfbSecTypeVncAuth ) )
 		{
 			securityType = rfbSecTypeVncAuth;
 			m_state = State::SecurityChallenge;
@@ -335,6 +350,67 @@ bool VncClientProtocol::receiveSecurityChallenge()
 
 
 
+bool VncClientProtocol::receiveAuthenticationMethods()
+{
+	VariantArrayMessage message( m_socket );
+
+	if( message.isReadyForReceive() && message.receive() )
+	{
+		const auto authMethodCount = message.read().toInt(); // Flawfinder: ignore
+
+		PluginUidList authMethodUids;
+		authMethodUids.reserve( authMethodCount );
+
+		for( int i = 0; i < authMethodCount; ++i )
+		{
+			authMethodUids.append( message.read().toUuid() ); // Flawfinder: ignore
+		}
+
+		if( authMethodUids.contains( m_authenticationPluginUid ) == false )
+		{
+			vCritical() << "authentication method not supported by server!" << authMethodUids;
+			m_socket->close();
+			return false;
+		}
+
+		VariantArrayMessage authReplyMessage( m_socket );
+		authReplyMessage.write( m_authenticationPluginUid );
+		authReplyMessage.write( VeyonCore::platform().userFunctions().currentUser() );
+		authReplyMessage.send();
+
+		m_state = State::AuthenticationAck;
+
+		return true;
+	}
+
+	return false;
+}
+
+
+
+bool VncClientProtocol::receiveAuthenticationAck()
+{
+	VariantArrayMessage message( m_socket );
+
+	if( message.isReadyForReceive() && message.receive() )
+	{
+		if( m_authenticationPlugin->authenticate( m_socket ) == false )
+		{
+			vCritical() << "authentication failed!";
+			m_socket->close();
+			return false;
+		}
+
+		m_state = State::SecurityResult;
+
+		return true;
+	}
+
+	return false;
+}
+
+
+
 bool VncClientProtocol::receiveSecurityResult()
 {
 	if( m_socket->bytesAvailable() >= 4 )
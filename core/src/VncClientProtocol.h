@@ -29,7 +29,9 @@
 #include <QRect>
 
 #include "CryptoCore.h"
+#include "Plugin.h"
 
+class AuthenticationPluginInterface;
 class QBuffer;
 class QTcpSocket;
 
@@ -44,6 +46,8 @@ public:
 		Protocol,
 		SecurityInit,
 		SecurityChallenge,
+		AuthenticationMethods,
+		AuthenticationAck,
 		SecurityResult,
 		FramebufferInit,
 		Running,
@@ -57,6 +61,14 @@ public:
 		return m_state;
 	}
 
+	// authenticate via the Veyon security type using the given plugin instead of VNC authentication -
+	// the plugin has to send its credentials without waiting for further data from the server
+	void setAuthenticationPlugin( Plugin::Uid pluginUid, const AuthenticationPluginInterface* plugin )
+	{
+		m_authenticationPluginUid = pluginUid;
+		m_authenticationPlugin = plugin;
+	}
+
 	void start();
 	bool read();  // Flawfinder: ignore
 
@@ -101,6 +113,8 @@ private:
 	bool readProtocol();
 	bool receiveSecurityTypes();
 	bool receiveSecurityChallenge();
+	bool receiveAuthenticationMethods();
+	bool receiveAuthenticationAck();
 	bool receiveSecurityResult();
 	bool receiveServerInitMessage();
 
@@ -131,6 +145,9 @@ private:
 
 	Password m_vncPassword{};
 
+	Plugin::Uid m_authenticationPluginUid{};
+	const AuthenticationPluginInterface* m_authenticationPlugin{nullptr};
+
 	QByteArray m_serverInitMessage{};
 
 	rfbPixelFormat m_pixelFormat{};
@@ -32,14 +32,36 @@
 #include <QMutexLocker>
 #include <QPixmap>
 #include <QTime>
+#include <QtEndian>
 
 #include "PlatformNetworkFunctions.h"
+#include "RfbExtensions.h"
+#include "TraceLog.h"
 #include "VeyonConfiguration.h"
 #include "VncConnection.h"
 #include "SocketDevice.h"
 #include "VncEvents.h"
 
 
+static std::atomic<bool> __telemetryEnabled{false};
+static rfbClientProtocolExtension* __vncConnectionProtocolExt = nullptr;
+static std::array<int, 3> __vncConnectionEncodings = {
+	RfbExtensions::EncodingContinuousUpdates, RfbExtensions::EncodingFence, 0 };
+
+
+static rfbBool handleVncConnectionMessage( rfbClient* client, rfbServerToClientMsg* message )
+{
+	auto connection = static_cast<VncConnection *>( VncConnection::clientData( client, VncConnection::VncConnectionTag ) );
+	if( connection )
+	{
+		return connection->handleExtensionMessage( client, message->type );
+	}
+
+	return false;
+}
+
+
+
 rfbBool VncConnection::hookInitFrameBuffer( rfbClient* client )
 {
 	auto connection = static_cast<VncConnection *>( clientData( client, VncConnectionTag ) );
@@ -59,7 +81,7 @@ void VncConnection::hookUpdateFB( rfbClient* client, int x, int y, int w, int h
 	auto connection = static_cast<VncConnection *>( clientData( client, VncConnectionTag ) );
 	if( connection )
 	{
-		Q_EMIT connection->imageUpdated( x, y, w, h );
+		connection->updateFrameBuffer( x, y, w, h );
 	}
 }
 
@@ -166,6 +188,20 @@ VncConnection::VncConnection( QObject* parent ) :
 	QThread( parent ),
 	m_defaultPort( VeyonCore::config().veyonServerPort() )
 {
+	m_inputEventTimer.start();
+
+	if( __vncConnectionProtocolExt == nullptr )
+	{
+		__vncConnectionProtocolExt = new rfbClientProtocolExtension;
+		__vncConnectionProtocolExt->encodings = __vncConnectionEncodings.data();
+		__vncConnectionProtocolExt->handleEncoding = nullptr;
+		__vncConnectionProtocolExt->handleMessage = handleVncConnectionMessage;
+		__vncConnectionProtocolExt->securityTypes = nullptr;
+		__vncConnectionProtocolExt->handleAuthentication = nullptr;
+
+		rfbClientRegisterExtension( __vncConnectionProtocolExt );
+	}
+
 	if( VeyonCore::config().useCustomVncConnectionSettings() )
 	{
 		m_threadTerminationTimeout = VeyonCore::config().vncConnectionThreadTerminationTimeout();
@@ -312,6 +348,45 @@ void VncConnection::setServerReachable()
 
 
 
+VncConnection::LinkStatistics VncConnection::linkStatistics() const
+{
+	QMutexLocker locker( &m_linkStatisticsMutex );
+	return m_linkStatistics;
+}
+
+
+
+void VncConnection::setTelemetryEnabled( bool enabled )
+{
+	__telemetryEnabled = enabled;
+}
+
+
+
+bool VncConnection::isTelemetryEnabled()
+{
+	return __telemetryEnabled;
+}
+
+
+
+VncConnectionTelemetry VncConnection::telemetry()
+{
+	m_eventQueueMutex.lock();
+	const auto eventQueueDepth = m_eventQueue.size() + m_inputEventQueue.size() + m_inputEventOverflowQueue.size();
+	m_eventQueueMutex.unlock();
+
+	QMutexLocker locker( &m_telemetryMutex );
+
+	auto telemetry = m_telemetry;
+	telemetry.eventQueueDepth = eventQueueDepth;
+	telemetry.connectedTime = isConnected() && m_connectedTimer.isValid() ? m_connectedTimer.elapsed() : 0;
+
+	return telemetry;
+}
+
+
+
 void VncConnection::setScaledSize( QSize s )
 {
 	QMutexLocker globalLock( &m_globalMutex );
@@ -412,6 +487,11 @@ void VncConnection::establishConnection()
 
 	m_framebufferState = FramebufferState::Invalid;
 
+	resetLinkStatistics();
+
+	m_continuousUpdatesSupported = false;
+	m_continuousUpdatesEnabled = false;
+
 	while( isControlFlagSet( ControlFlag::TerminateThread ) == false &&
 		   state() != State::Connected ) // try to connect as long as the server allows
 	{
@@ -447,11 +527,25 @@ void VncConnection::establishConnection()
 
 		setControlFlag( ControlFlag::ServerReachable, false );
 
+		if( isTelemetryEnabled() )
+		{
+			QMutexLocker locker( &m_telemetryMutex );
+			++m_telemetry.connectionAttempts;
+		}
+
 		if( rfbInitClient( m_client, nullptr, nullptr ) &&
 			isControlFlagSet( ControlFlag::TerminateThread ) == false )
 		{
 			m_framebufferUpdateWatchdog.restart();
 
+			m_telemetryMutex.lock();
+			m_connectedTimer.restart();
+			if( isTelemetryEnabled() )
+			{
+				++m_telemetry.connections;
+			}
+			m_telemetryMutex.unlock();
+
 			Q_EMIT connectionEstablished();
 
 			VeyonCore::platform().networkFunctions().
@@ -533,6 +627,7 @@ void VncConnection::handleConnection()
 			// handle all available messages
 			bool handledOkay = true;
 			do {
+				m_messageTimer.start();
 				handledOkay &= HandleRFBServerMessage( m_client );
 			} while( handledOkay && WaitForMessage( m_client, 0 ) );
 
@@ -542,6 +637,15 @@ void VncConnection::handleConnection()
 			}
 		}
 
+		if( m_encodingLevelChanged )
+		{
+			configureEncodings( m_client );
+			SetFormatAndEncodings( m_client );
+			m_encodingLevelChanged = false;
+		}
+
+		updateContinuousUpdates();
+
 		sendEvents();
 
 		const auto remainingUpdateInterval = m_framebufferUpdateInterval - loopTimer.elapsed();
@@ -550,6 +654,7 @@ void VncConnection::handleConnection()
 			m_framebufferUpdateWatchdog.elapsed() >= qMax<qint64>( 2*m_framebufferUpdateInterval, m_framebufferUpdateWatchdogTimeout ) )
 		{
 			SendFramebufferUpdateRequest( m_client, 0, 0, m_client->width, m_client->height, false );
+			TraceLog::record( TraceLog::Event::VncUpdateRequest, false );
 
 			const auto remainingFastUpdateInterval = m_fastFramebufferUpdateInterval - loopTimer.elapsed();
 
@@ -631,10 +736,18 @@ bool VncConnection::initFrameBuffer( rfbClient* client )
 
 	memset( client->frameBuffer, '\0', pixelCount*RfbBytesPerPixel );
 
-	// initialize framebuffer image which just wraps the allocated memory and ensures cleanup after last
+	// initialize back buffer image which just wraps the allocated memory and ensures cleanup after last
 	// image copy using the framebuffer gets destroyed
+	m_backBuffer = QImage( client->frameBuffer, client->width, client->height, QImage::Format_RGB32, framebufferCleanup, client->frameBuffer );
+	m_backBufferUpdatedRegion = {};
+
+	QImage frontBuffer( client->width, client->height, QImage::Format_RGB32 );
+	frontBuffer.fill( Qt::black );
+
 	m_imgLock.lockForWrite();
-	m_image = QImage( client->frameBuffer, client->width, client->height, QImage::Format_RGB32, framebufferCleanup, client->frameBuffer );
+	m_image = frontBuffer;
+	m_spareBuffer = {};
+	m_spareBufferOutdatedRegion = {};
 	m_imgLock.unlock();
 
 	// set up pixel format according to QImage
@@ -645,54 +758,339 @@ bool VncConnection::initFrameBuffer( rfbClient* client )
 	client->format.greenMax = 0xff;
 	client->format.blueMax = 0xff;
 
-	client->appData.encodingsString = "zrle ultra copyrect hextile zlib corre rre raw";
-	client->appData.useRemoteCursor = false;
-	client->appData.compressLevel = 0;
+	configureEncodings( client );
+
+	m_framebufferState = FramebufferState::Initialized;
+
+	Q_EMIT framebufferSizeChanged( client->width, client->height );
+
+	return true;
+}
+
+
+
+void VncConnection::updateFrameBuffer( int x, int y, int w, int h )
+{
+	// collect updated rectangles and do not notify about them before they have been published
+	m_backBufferUpdatedRegion += QRect( x, y, w, h );
+	++m_pendingRectCount;
+}
+
+
+
+void VncConnection::finishFrameBufferUpdate()
+{
+	// time spent for receiving and decoding the update
+	const auto updateDuration = m_messageTimer.isValid() ? m_messageTimer.nsecsElapsed() : 0;
+
+	const auto updatedRegion = m_backBufferUpdatedRegion;
+	m_backBufferUpdatedRegion = {};
+
+	const auto rectCount = m_pendingRectCount;
+	m_pendingRectCount = 0;
+
+	const auto telemetryEnabled = isTelemetryEnabled();
+
+	QElapsedTimer publishTimer;
+	if( telemetryEnabled )
+	{
+		publishTimer.start();
+	}
+
+	publishFrameBuffer( updatedRegion );
+
+	const auto publishDuration = telemetryEnabled ? publishTimer.nsecsElapsed() : 0;
+
+	qint64 updatedPixelCount = 0;
+
+	for( const auto& rect : updatedRegion )
+	{
+		updatedPixelCount += qint64( rect.width() ) * rect.height();
+		Q_EMIT imageUpdated( rect.x(), rect.y(), rect.width(), rect.height() );
+	}
+
+	updateLinkStatistics( updateDuration, updatedPixelCount );
+
+	TraceLog::record( TraceLog::Event::VncUpdateComplete, updateDuration, updatedPixelCount, rectCount );
+
+	if( telemetryEnabled )
+	{
+		QMutexLocker locker( &m_telemetryMutex );
+		++m_telemetry.framebufferUpdates;
+		m_telemetry.rects += rectCount;
+		m_telemetry.updatedPixels += updatedPixelCount;
+		m_telemetry.publishDuration += publishDuration;
+		m_telemetry.addUpdateDuration( updateDuration );
+	}
+
+	m_framebufferUpdateWatchdog.restart();
+
+	m_framebufferState = FramebufferState::Valid;
+	setControlFlag( ControlFlag::ScaledScreenNeedsUpdate, true );
+
+	Q_EMIT framebufferUpdateComplete();
+}
+
+
+
+void VncConnection::publishFrameBuffer( const QRegion& updatedRegion )
+{
+	QWriteLocker locker( &m_imgLock );
+
+	if( updatedRegion.isEmpty() || m_image.size() != m_backBuffer.size() )
+	{
+		return;
+	}
+
+	// nobody holds a copy of the current front buffer so update it in place
+	if( m_image.isDetached() )
+	{
+		copyRegion( m_backBuffer, m_image, updatedRegion );
+		m_spareBufferOutdatedRegion += updatedRegion;
+		return;
+	}
+
+	// the current front buffer is still in use by some reader so bring the spare buffer
+	// up to date (if it has been released in the meantime) and swap buffers
+	if( m_spareBuffer.isNull() == false && m_spareBuffer.isDetached() )
+	{
+		copyRegion( m_backBuffer, m_spareBuffer, m_spareBufferOutdatedRegion + updatedRegion );
+		std::swap( m_image, m_spareBuffer );
+	}
+	else
+	{
+		// both buffers are in use, so fall back to a full copy
+		m_spareBuffer = m_image;
+		m_image = m_backBuffer.copy();
+	}
+
+	m_spareBufferOutdatedRegion = updatedRegion;
+}
+
+
+
+void VncConnection::copyRegion( const QImage& source, QImage& target, const QRegion& region )
+{
+	const auto bounds = region.boundingRect() & source.rect();
+	if( bounds.isEmpty() )
+	{
+		return;
+	}
+
+	// use the bounding rectangle if the region consists of many small rectangles
+	// in order to reduce the number of copy operations
+	QVector<QRect> copyRects;
+	if( region.rectCount() > MaxCopyRectCount )
+	{
+		copyRects.append( bounds );
+	}
+	else
+	{
+		copyRects.reserve( region.rectCount() );
+		for( const auto& rect : region )
+		{
+			copyRects.append( rect );
+		}
+	}
+
+	for( const auto& regionRect : qAsConst(copyRects) )
+	{
+		const auto rect = regionRect & source.rect();
+		const auto bytesPerLine = size_t( rect.width() ) * RfbBytesPerPixel;
+		const auto offset = size_t( rect.x() ) * RfbBytesPerPixel;
+
+		for( int y = rect.top(); y <= rect.bottom(); ++y )
+		{
+			memcpy( target.scanLine( y ) + offset, source.constScanLine( y ) + offset, bytesPerLine );
+		}
+	}
+}
+
+
+
+VncConnection::EncodingLevel VncConnection::bestEncodingLevel() const
+{
+	if( m_encodingLevelFixed )
+	{
+		return m_fixedEncodingLevel;
+	}
+
+	return EncodingLevel::Lossless;
+}
+
+
+
+void VncConnection::setFixedEncodingLevel( EncodingLevel level )
+{
+	m_fixedEncodingLevel = level;
+	m_encodingLevelFixed = true;
+}
+
+
+
+void VncConnection::setEncodingLevel( EncodingLevel level )
+{
+	if( level == m_encodingLevel )
+	{
+		return;
+	}
+
+	vDebug() << m_host << "switching encoding level from" << m_encodingLevel << "to" << level;
+
+	m_encodingLevel = level;
+	m_encodingLevelChanged = true;
+
+	if( isTelemetryEnabled() )
+	{
+		QMutexLocker locker( &m_telemetryMutex );
+		++m_telemetry.encodingLevelChanges;
+	}
+
+	m_slowLinkEvaluations = 0;
+	m_fastLinkEvaluations = 0;
+
+	QMutexLocker locker( &m_linkStatisticsMutex );
+	m_linkStatistics.encodingLevel = m_encodingLevel;
+}
+
+
+
+void VncConnection::configureEncodings( rfbClient* client )
+{
+	client->appData.useRemoteCursor = m_quality == Quality::RemoteControl;
 	client->appData.useBGR233 = false;
-	client->appData.qualityLevel = 9;
-	client->appData.enableJPEG = false;
 
-	switch( m_quality )
+	if( m_quality == Quality::Screenshot )
 	{
-	case Quality::Screenshot:
 		// make sure to use lossless raw encoding
 		client->appData.encodingsString = "raw";
+		client->appData.compressLevel = 0;
+		client->appData.qualityLevel = 9;
+		client->appData.enableJPEG = false;
+		return;
+	}
+
+	// the strength of ZYWRLE's wavelet transformation is derived from the quality level
+	// by the server: 9-6 -> level 1, 5-3 -> level 2, 2-0 -> level 3
+	switch( m_encodingLevel )
+	{
+	case EncodingLevel::Lossless:
+		client->appData.encodingsString = "zrle ultra copyrect hextile zlib corre rre raw";
+		client->appData.compressLevel = m_quality == Quality::Thumbnail ? 9 : 0;
+		client->appData.qualityLevel = 9;
+		client->appData.enableJPEG = false;
 		break;
-	case Quality::RemoteControl:
-		client->appData.useRemoteCursor = true;
+	case EncodingLevel::Compressed:
+		client->appData.encodingsString = "zywrle zrle ultra copyrect hextile zlib corre rre raw";
+		client->appData.compressLevel = 9;
+		client->appData.qualityLevel = 9;
+		client->appData.enableJPEG = true;
 		break;
-	case Quality::Thumbnail:
+	case EncodingLevel::Lossy:
+		client->appData.encodingsString = "zywrle zrle ultra copyrect hextile zlib corre rre raw";
 		client->appData.compressLevel = 9;
 		client->appData.qualityLevel = 5;
 		client->appData.enableJPEG = true;
 		break;
-	default:
+	case EncodingLevel::LowQuality:
+		client->appData.encodingsString = "zywrle zrle ultra copyrect hextile zlib corre rre raw";
+		client->appData.compressLevel = 9;
+		client->appData.qualityLevel = 2;
+		client->appData.enableJPEG = true;
 		break;
 	}
+}
 
-	m_framebufferState = FramebufferState::Initialized;
 
-	Q_EMIT framebufferSizeChanged( client->width, client->height );
 
-	return true;
+void VncConnection::resetLinkStatistics()
+{
+	m_encodingLevel = bestEncodingLevel();
+	m_encodingLevelChanged = false;
+
+	m_linkEvaluationTimer.restart();
+	m_linkEvaluationDuration = 0;
+	m_linkEvaluationPixelCount = 0;
+	m_slowLinkEvaluations = 0;
+	m_fastLinkEvaluations = 0;
+
+	QMutexLocker locker( &m_linkStatisticsMutex );
+	m_linkStatistics = {};
+	m_linkStatistics.encodingLevel = m_encodingLevel;
 }
 
 
 
-void VncConnection::finishFrameBufferUpdate()
+void VncConnection::updateLinkStatistics( qint64 duration, qint64 pixelCount )
 {
-	m_framebufferUpdateWatchdog.restart();
+	m_linkEvaluationDuration += duration;
+	m_linkEvaluationPixelCount += pixelCount;
 
-	m_framebufferState = FramebufferState::Valid;
-	setControlFlag( ControlFlag::ScaledScreenNeedsUpdate, true );
+	m_linkStatisticsMutex.lock();
+	++m_linkStatistics.updateCount;
+	m_linkStatistics.averageUpdateDuration = int( ( m_linkStatistics.averageUpdateDuration * 7LL + duration / 1000 ) / 8 );
+	m_linkStatisticsMutex.unlock();
 
-	Q_EMIT framebufferUpdateComplete();
+	// wait until enough data has been transferred for a meaningful measurement
+	if( m_linkEvaluationTimer.elapsed() < AdaptiveEncodingEvaluationInterval ||
+		m_linkEvaluationPixelCount < AdaptiveEncodingMinimumPixelCount )
+	{
+		return;
+	}
+
+	m_linkStatisticsMutex.lock();
+	m_linkStatistics.throughput = m_linkEvaluationDuration > 0 ?
+									  m_linkEvaluationPixelCount * 1000000000LL / m_linkEvaluationDuration : 0;
+	m_linkStatisticsMutex.unlock();
+
+	adaptEncoding( m_linkEvaluationDuration / m_linkEvaluationPixelCount );
+
+	m_linkEvaluationTimer.restart();
+	m_linkEvaluationDuration = 0;
+	m_linkEvaluationPixelCount = 0;
+}
+
+
+
+void VncConnection::adaptEncoding( qint64 nanosecondsPerPixel )
+{
+	if( m_quality == Quality::Screenshot || m_encodingLevelFixed )
+	{
+		return;
+	}
+
+	// require several consecutive evaluations before switching in order to avoid oscillation
+	if( nanosecondsPerPixel > AdaptiveEncodingDegradeThreshold )
+	{
+		m_fastLinkEvaluations = 0;
+		if( ++m_slowLinkEvaluations >= AdaptiveEncodingDegradeEvaluations &&
+			m_encodingLevel != EncodingLevel::LowQuality )
+		{
+			setEncodingLevel( EncodingLevel( int(m_encodingLevel) + 1 ) );
+		}
+	}
+	else if( nanosecondsPerPixel < AdaptiveEncodingUpgradeThreshold )
+	{
+		m_slowLinkEvaluations = 0;
+		if( ++m_fastLinkEvaluations >= AdaptiveEncodingUpgradeEvaluations &&
+			int(m_encodingLevel) > int(bestEncodingLevel()) )
+		{
+			setEncodingLevel( EncodingLevel( int(m_encodingLevel) - 1 ) );
+		}
+	}
+	else
+	{
+		m_slowLinkEvaluations = 0;
+		m_fastLinkEvaluations = 0;
+	}
 }
 
 
 
 void VncConnection::sendEvents()
 {
+	sendInputEvents();
+
 	m_eventQueueMutex.lock();
 
 	while( m_eventQueue.isEmpty() == false )
@@ -705,6 +1103,12 @@ void VncConnection::sendEvents()
 		if( isControlFlagSet( ControlFlag::TerminateThread ) == false )
 		{
 			event->fire( m_client );
+
+			if( isTelemetryEnabled() )
+			{
+				QMutexLocker locker( &m_telemetryMutex );
+				++m_telemetry.eventsSent;
+			}
 		}
 
 		delete event;
@@ -718,6 +1122,274 @@ void VncConnection::sendEvents()
 
 
 
+void VncConnection::enqueueInputEvent( const VncInputEventQueue::Event& event )
+{
+	if( state() != State::Connected )
+	{
+		return;
+	}
+
+	int overflowQueueDepth = 0;
+
+	if( m_inputEventQueueOverflow || m_inputEventQueue.enqueue( event ) == false )
+	{
+		// connection thread is stalled - queue all further events behind the full queue
+		// until it has caught up so that no key or button release gets lost or reordered
+		QMutexLocker locker( &m_eventQueueMutex );
+		m_inputEventOverflowQueue.enqueue( event );
+		m_inputEventQueueOverflow = true;
+		overflowQueueDepth = m_inputEventOverflowQueue.size();
+	}
+
+	if( isTelemetryEnabled() )
+	{
+		const auto inputEventQueueDepth = m_inputEventQueue.size() + overflowQueueDepth;
+
+		QMutexLocker locker( &m_telemetryMutex );
+		m_telemetry.maximumEventQueueDepth = qMax( m_telemetry.maximumEventQueueDepth, inputEventQueueDepth );
+	}
+
+	m_updateIntervalSleeper.wakeAll();
+}
+
+
+
+static void appendPointerEvent( QByteArray& data, const VncInputEventQueue::Event& event )
+{
+	std::array<uchar, sz_rfbPointerEventMsg> message{};
+	message[0] = rfbPointerEvent;
+	message[1] = uchar( event.buttonMask );
+	qToBigEndian<uint16_t>( uint16_t( qBound( 0, event.x, 0xffff ) ), message.data() + 2 );
+	qToBigEndian<uint16_t>( uint16_t( qBound( 0, event.y, 0xffff ) ), message.data() + 4 );
+
+	data.append( reinterpret_cast<const char *>( message.data() ), int( message.size() ) );
+}
+
+
+
+static void appendKeyEvent( QByteArray& data, const VncInputEventQueue::Event& event )
+{
+	std::array<uchar, sz_rfbKeyEventMsg> message{};
+	message[0] = rfbKeyEvent;
+	message[1] = event.pressed ? 1 : 0;
+	qToBigEndian<uint32_t>( event.key, message.data() + 4 );
+
+	data.append( reinterpret_cast<const char *>( message.data() ), int( message.size() ) );
+}
+
+
+
+void VncConnection::sendInputEvents()
+{
+	if( m_inputEventQueue.isEmpty() && m_inputEventQueueOverflow == false )
+	{
+		return;
+	}
+
+	const auto terminating = isControlFlagSet( ControlFlag::TerminateThread );
+	const auto pointerEventsSupported = SupportsClient2Server( m_client, rfbPointerEvent );
+	const auto keyEventsSupported = SupportsClient2Server( m_client, rfbKeyEvent );
+
+	QByteArray data;
+	VncInputEventQueue::Event queuedEvent;
+	VncInputEventQueue::Event pendingPointerEvent;
+	bool hasPendingPointerEvent = false;
+	qint64 eventCount = 0;
+	qint64 coalescedEventCount = 0;
+	qint64 timestampSum = 0;
+	qint64 oldestTimestamp = 0;
+
+	// consecutive pointer movements with the same button mask are coalesced into the
+	// last one while button changes and key events are always sent in order
+	const auto processEvent = [&]( const VncInputEventQueue::Event& event ) {
+		if( eventCount == 0 )
+		{
+			oldestTimestamp = event.timestamp;
+		}
+		++eventCount;
+		timestampSum += event.timestamp;
+
+		if( event.type == VncInputEventQueue::Event::Type::Pointer )
+		{
+			if( hasPendingPointerEvent && pendingPointerEvent.buttonMask == event.buttonMask )
+			{
+				++coalescedEventCount;
+			}
+			else if( hasPendingPointerEvent && pointerEventsSupported )
+			{
+				appendPointerEvent( data, pendingPointerEvent );
+			}
+
+			pendingPointerEvent = event;
+			hasPendingPointerEvent = true;
+		}
+		else
+		{
+			if( hasPendingPointerEvent && pointerEventsSupported )
+			{
+				appendPointerEvent( data, pendingPointerEvent );
+			}
+			hasPendingPointerEvent = false;
+
+			if( keyEventsSupported )
+			{
+				appendKeyEvent( data, event );
+			}
+		}
+	};
+
+	while( m_inputEventQueue.dequeue( queuedEvent ) )
+	{
+		processEvent( queuedEvent );
+	}
+
+	// events which did not fit into the queue are newer than all events queued before
+	// and producers keep using the overflow queue until it has been taken over here
+	if( m_inputEventQueueOverflow )
+	{
+		QQueue<VncInputEventQueue::Event> overflowQueue;
+
+		m_eventQueueMutex.lock();
+		while( m_inputEventQueue.dequeue( queuedEvent ) )
+		{
+			processEvent( queuedEvent );
+		}
+		overflowQueue.swap( m_inputEventOverflowQueue );
+		m_inputEventQueueOverflow = false;
+		m_eventQueueMutex.unlock();
+
+		for( const auto& overflowEvent : qAsConst( overflowQueue ) )
+		{
+			processEvent( overflowEvent );
+		}
+	}
+
+	if( hasPendingPointerEvent && pointerEventsSupported )
+	{
+		appendPointerEvent( data, pendingPointerEvent );
+	}
+
+	if( terminating || data.isEmpty() )
+	{
+		return;
+	}
+
+	WriteToRFBServer( m_client, data.data(), uint( data.size() ) );
+
+	const auto now = m_inputEventTimer.nsecsElapsed();
+	const auto maximumLatency = now - oldestTimestamp;
+
+	TraceLog::record( TraceLog::Event::VncInputSend, data.size(), eventCount - coalescedEventCount, maximumLatency );
+
+	if( isTelemetryEnabled() )
+	{
+		QMutexLocker locker( &m_telemetryMutex );
+		m_telemetry.eventsSent += eventCount - coalescedEventCount;
+		m_telemetry.inputEvents += eventCount;
+		m_telemetry.coalescedInputEvents += coalescedEventCount;
+		++m_telemetry.inputWrites;
+		m_telemetry.inputLatency += eventCount * now - timestampSum;
+		m_telemetry.maximumInputLatency = qMax( m_telemetry.maximumInputLatency, maximumLatency );
+	}
+}
+
+
+
+void VncConnection::updateContinuousUpdates()
+{
+	// let the server push updates as soon as they are available unless updates are throttled anyway
+	const auto enable = m_continuousUpdatesSupported && m_framebufferUpdateInterval <= 0;
+
+	if( enable != m_continuousUpdatesEnabled && sendEnableContinuousUpdates( enable ) )
+	{
+		m_continuousUpdatesEnabled = enable;
+	}
+}
+
+
+
+bool VncConnection::sendEnableContinuousUpdates( bool enable )
+{
+	// message type, enable flag, x, y, width and height of the area to update
+	std::array<uchar, RfbExtensions::EnableContinuousUpdatesMessageSize> message{};
+	message[0] = RfbExtensions::EnableContinuousUpdatesMessage;
+	message[1] = enable ? 1 : 0;
+	qToBigEndian<uint16_t>( uint16_t( m_client->width ), message.data() + 6 );
+	qToBigEndian<uint16_t>( uint16_t( m_client->height ), message.data() + 8 );
+
+	return WriteToRFBServer( m_client, reinterpret_cast<char *>( message.data() ), uint( message.size() ) );
+}
+
+
+
+bool VncConnection::handleExtensionMessage( rfbClient* client, uint8_t messageType )
+{
+	switch( messageType )
+	{
+	case RfbExtensions::EndOfContinuousUpdatesMessage:
+		// sent by the server once for announcing support for continuous updates
+		// and whenever continuous updates have been disabled
+		m_continuousUpdatesSupported = true;
+		m_continuousUpdatesEnabled = false;
+		return true;
+
+	case RfbExtensions::FenceMessage:
+		return handleFenceMessage( client );
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+
+
+bool VncConnection::handleFenceMessage( rfbClient* client )
+{
+	// padding (3 bytes), flags (4 bytes) and payload length (1 byte) following the message type
+	std::array<char, RfbExtensions::FenceMessageHeaderSize - 1> header{};
+	if( ReadFromRFBServer( client, header.data(), uint( header.size() ) ) == false )
+	{
+		return false;
+	}
+
+	const auto flags = qFromBigEndian<uint32_t>( reinterpret_cast<const uchar *>( header.data() + 3 ) );
+	const auto payloadLength = int( uint8_t( header[7] ) );
+
+	if( payloadLength > RfbExtensions::FenceMaximumPayloadSize )
+	{
+		vCritical() << "invalid fence payload length" << payloadLength;
+		return false;
+	}
+
+	QByteArray payload( payloadLength, 0 );
+	if( payloadLength > 0 &&
+		ReadFromRFBServer( client, payload.data(), uint( payloadLength ) ) == false )
+	{
+		return false;
+	}
+
+	// we never request fences ourselves so there's nothing to do for responses
+	if( ( flags & RfbExtensions::FenceFlagRequest ) == 0 )
+	{
+		return true;
+	}
+
+	// all messages preceding the fence request have been processed completely at this point
+	// so the request can be answered right away
+	QByteArray response( RfbExtensions::FenceMessageHeaderSize, 0 );
+	response[0] = char( RfbExtensions::FenceMessage );
+	qToBigEndian<uint32_t>( flags & RfbExtensions::FenceFlagsSupported & ~RfbExtensions::FenceFlagRequest,
+							reinterpret_cast<uchar *>( response.data() + 4 ) );
+	response[8] = char( payloadLength );
+	response.append( payload );
+
+	return WriteToRFBServer( client, response.data(), uint( response.size() ) );
+}
+
+
+
 void VncConnection::enqueueEvent( VncEvent* event, bool wake )
 {
 	if( state() != State::Connected )
@@ -727,8 +1399,15 @@ void VncConnection::enqueueEvent( VncEvent* event, bool wake )
 
 	m_eventQueueMutex.lock();
 	m_eventQueue.enqueue( event );
+	const auto eventQueueDepth = m_eventQueue.size();
 	m_eventQueueMutex.unlock();
 
+	if( isTelemetryEnabled() )
+	{
+		QMutexLocker locker( &m_telemetryMutex );
+		m_telemetry.maximumEventQueueDepth = qMax( m_telemetry.maximumEventQueueDepth, eventQueueDepth );
+	}
+
 	if( wake )
 	{
 		m_updateIntervalSleeper.wakeAll();
@@ -740,21 +1419,34 @@ void VncConnection::enqueueEvent( VncEvent* event, bool wake )
 bool VncConnection::isEventQueueEmpty()
 {
 	QMutexLocker lock( &m_eventQueueMutex );
-	return m_eventQueue.isEmpty();
+	return m_eventQueue.isEmpty() && m_inputEventQueue.isEmpty() && m_inputEventOverflowQueue.isEmpty();
 }
 
 
 
 void VncConnection::mouseEvent( int x, int y, uint buttonMask )
 {
-	enqueueEvent( new VncPointerEvent( x, y, buttonMask ), true );
+	VncInputEventQueue::Event event;
+	event.type = VncInputEventQueue::Event::Type::Pointer;
+	event.x = x;
+	event.y = y;
+	event.buttonMask = buttonMask;
+	event.timestamp = m_inputEventTimer.nsecsElapsed();
+
+	enqueueInputEvent( event );
 }
 
 
 
 void VncConnection::keyEvent( unsigned int key, bool pressed )
 {
-	enqueueEvent( new VncKeyEvent( key, pressed ), true );
+	VncInputEventQueue::Event event;
+	event.type = VncInputEventQueue::Event::Type::Key;
+	event.key = key;
+	event.pressed = pressed;
+	event.timestamp = m_inputEventTimer.nsecsElapsed();
+
+	enqueueInputEvent( event );
 }
 
 
@@ -32,12 +32,15 @@
 #include <QMutex>
 #include <QQueue>
 #include <QReadWriteLock>
+#include <QRegion>
 #include <QThread>
 #include <QTimer>
 #include <QWaitCondition>
 
 #include "VeyonCore.h"
 #include "SocketDevice.h"
+#include "VncConnectionTelemetry.h"
+#include "VncInputEventQueue.h"
 
 using rfbClient = struct _rfbClient;
 
@@ -87,6 +90,24 @@ public:
 	} ;
 	Q_ENUM(State)
 
+	// Lossless: ZRLE, Compressed/Lossy/LowQuality: ZYWRLE with increasing wavelet strength
+	enum class EncodingLevel
+	{
+		Lossless,
+		Compressed,
+		Lossy,
+		LowQuality
+	} ;
+	Q_ENUM(EncodingLevel)
+
+	struct LinkStatistics
+	{
+		EncodingLevel encodingLevel{EncodingLevel::Lossless};
+		qint64 updateCount{0};
+		qint64 throughput{0}; // decoded pixels per second while receiving framebuffer updates
+		int averageUpdateDuration{0}; // microseconds
+	};
+
 	explicit VncConnection( QObject *parent = nullptr );
 	~VncConnection() override;
 
@@ -123,6 +144,16 @@ public:
 
 	void setServerReachable();
 
+	LinkStatistics linkStatistics() const;
+
+	// disables adaptive encoding (e.g. for benchmarks) - has to be called before starting the connection
+	void setFixedEncodingLevel( EncodingLevel level );
+
+	static void setTelemetryEnabled( bool enabled );
+	static bool isTelemetryEnabled();
+
+	VncConnectionTelemetry telemetry();
+
 	void enqueueEvent( VncEvent* event, bool wake );
 	bool isEventQueueEmpty();
 
@@ -152,6 +183,8 @@ public:
 	void keyEvent( unsigned int key, bool pressed );
 	void clientCut( const QString& text );
 
+	bool handleExtensionMessage( rfbClient* client, uint8_t messageType );
+
 Q_SIGNALS:
 	void connectionPrepared();
 	void connectionEstablished();
@@ -173,6 +206,24 @@ private:
 	static constexpr int RfbSamplesPerPixel = 3;
 	static constexpr int RfbBytesPerPixel = sizeof(RfbPixel);
 
+	static constexpr int MaxCopyRectCount = 64;
+
+	// adaptive encoding - the link is considered slow if receiving and decoding an update takes
+	// more than AdaptiveEncodingDegradeThreshold nanoseconds per pixel (= milliseconds per megapixel)
+	static constexpr int AdaptiveEncodingEvaluationInterval = 2000;
+	static constexpr qint64 AdaptiveEncodingMinimumPixelCount = 256*256;
+	static constexpr qint64 AdaptiveEncodingDegradeThreshold = 150;
+	static constexpr qint64 AdaptiveEncodingUpgradeThreshold = 40;
+	static constexpr int AdaptiveEncodingDegradeEvaluations = 2;
+	static constexpr int AdaptiveEncodingUpgradeEvaluations = 5;
+
+	// a gap between both thresholds keeps links close to a threshold from switching back and forth
+	static_assert( AdaptiveEncodingUpgradeThreshold > 0 &&
+				   AdaptiveEncodingUpgradeThreshold < AdaptiveEncodingDegradeThreshold,
+				   "adaptive encoding thresholds must be positive and the upgrade threshold below the degrade threshold" );
+	static_assert( AdaptiveEncodingDegradeEvaluations > 0 && AdaptiveEncodingUpgradeEvaluations > 0,
+				   "adaptive encoding requires at least one evaluation before switching" );
+
 	enum class ControlFlag {
 		ScaledScreenNeedsUpdate = 0x01,
 		ServerReachable = 0x02,
@@ -190,9 +241,26 @@ private:
 	bool isControlFlagSet( ControlFlag flag );
 
 	bool initFrameBuffer( rfbClient* client );
+	void updateFrameBuffer( int x, int y, int w, int h );
 	void finishFrameBufferUpdate();
+	void publishFrameBuffer( const QRegion& updatedRegion );
+
+	static void copyRegion( const QImage& source, QImage& target, const QRegion& region );
+
+	EncodingLevel bestEncodingLevel() const;
+	void setEncodingLevel( EncodingLevel level );
+	void configureEncodings( rfbClient* client );
+	void resetLinkStatistics();
+	void updateLinkStatistics( qint64 duration, qint64 pixelCount );
+	void adaptEncoding( qint64 nanosecondsPerPixel );
 
 	void sendEvents();
+	void enqueueInputEvent( const VncInputEventQueue::Event& event );
+	void sendInputEvents();
+
+	void updateContinuousUpdates();
+	bool sendEnableContinuousUpdates( bool enable );
+	bool handleFenceMessage( rfbClient* client );
 
 	// hooks for LibVNCClient
 	static int8_t hookInitFrameBuffer( rfbClient* client );
@@ -221,6 +289,8 @@ private:
 	std::atomic<State> m_state{State::Disconnected};
 	std::atomic<FramebufferState> m_framebufferState{FramebufferState::Invalid};
 	QAtomicInteger<uint> m_controlFlags{};
+	bool m_continuousUpdatesSupported{false};
+	bool m_continuousUpdatesEnabled{false};
 
 	// connection parameters and data
 	rfbClient* m_client{nullptr};
@@ -235,12 +305,47 @@ private:
 	QWaitCondition m_updateIntervalSleeper{};
 	QAtomicInt m_framebufferUpdateInterval{0};
 	QElapsedTimer m_framebufferUpdateWatchdog{};
+	QElapsedTimer m_messageTimer{};
+
+	// link quality measurement and adaptive encoding (accessed by the connection thread only,
+	// except for the statistics which are protected by a mutex)
+	EncodingLevel m_encodingLevel{EncodingLevel::Lossless};
+	bool m_encodingLevelChanged{false};
+	EncodingLevel m_fixedEncodingLevel{EncodingLevel::Lossless};
+	bool m_encodingLevelFixed{false};
+	QElapsedTimer m_linkEvaluationTimer{};
+	qint64 m_linkEvaluationDuration{0};
+	qint64 m_linkEvaluationPixelCount{0};
+	int m_slowLinkEvaluations{0};
+	int m_fastLinkEvaluations{0};
+	mutable QMutex m_linkStatisticsMutex{};
+	LinkStatistics m_linkStatistics{};
+
+	// telemetry (only collected while enabled globally)
+	QMutex m_telemetryMutex{};
+	VncConnectionTelemetry m_telemetry{};
+	QElapsedTimer m_connectedTimer{};
+	qint64 m_pendingRectCount{0};
 
 	// queue for RFB and custom events
 	QQueue<VncEvent *> m_eventQueue{};
 
-	// framebuffer data and thread synchronization objects
+	// allocation-free queue for keyboard and pointer events which are sent in batches - while it is
+	// full, events are appended to the overflow queue (protected by the event queue mutex) until the
+	// connection thread has drained both queues in order so that no release event gets lost or reordered
+	VncInputEventQueue m_inputEventQueue{};
+	QQueue<VncInputEventQueue::Event> m_inputEventOverflowQueue{};
+	std::atomic<bool> m_inputEventQueueOverflow{false};
+	QElapsedTimer m_inputEventTimer{};
+
+	// framebuffer data and thread synchronization objects - the back buffer wraps the memory LibVNCClient
+	// decodes into and is accessed by the connection thread only while readers get (shallow copies of)
+	// the front buffer which is updated from the back buffer once a framebuffer update has been completed
+	QImage m_backBuffer{};
+	QRegion m_backBufferUpdatedRegion{};
 	QImage m_image{};
+	QImage m_spareBuffer{};
+	QRegion m_spareBufferOutdatedRegion{};
 	QImage m_scaledScreen{};
 	QSize m_scaledSize{};
 	QReadWriteLock m_imgLock{};
@@ -0,0 +1,141 @@
+/*
+ * VncConnectionTelemetry.cpp - implementation of VncConnectionTelemetry
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "PlatformUserFunctions.h"
+#include "VncConnectionTelemetry.h"
+
+
+// upper bounds of histogram buckets in milliseconds - last bucket collects all longer durations
+static constexpr std::array<int, VncConnectionTelemetry::UpdateDurationBucketCount - 1> __updateDurationBucketLimits{
+	1, 2, 5, 10, 20, 50, 100 };
+
+
+VncConnectionTelemetry& VncConnectionTelemetry::operator+=( const VncConnectionTelemetry& other )
+{
+	connectionAttempts += other.connectionAttempts;
+	connections += other.connections;
+	// connections are running in parallel
+	connectedTime = qMax( connectedTime, other.connectedTime );
+	framebufferUpdates += other.framebufferUpdates;
+	rects += other.rects;
+	updatedPixels += other.updatedPixels;
+	updateDuration += other.updateDuration;
+	publishDuration += other.publishDuration;
+
+	for( int i = 0; i < UpdateDurationBucketCount; ++i )
+	{
+		updateDurationHistogram[size_t(i)] += other.updateDurationHistogram[size_t(i)];
+	}
+
+	eventsSent += other.eventsSent;
+	eventQueueDepth += other.eventQueueDepth;
+	maximumEventQueueDepth = qMax( maximumEventQueueDepth, other.maximumEventQueueDepth );
+	inputEvents += other.inputEvents;
+	coalescedInputEvents += other.coalescedInputEvents;
+	inputWrites += other.inputWrites;
+	inputLatency += other.inputLatency;
+	maximumInputLatency = qMax( maximumInputLatency, other.maximumInputLatency );
+	encodingLevelChanges += other.encodingLevelChanges;
+
+	return *this;
+}
+
+
+
+void VncConnectionTelemetry::addUpdateDuration( qint64 duration )
+{
+	updateDuration += duration;
+
+	const auto milliseconds = duration / 1000000;
+
+	size_t bucket = 0;
+	while( bucket < __updateDurationBucketLimits.size() && milliseconds >= __updateDurationBucketLimits[bucket] )
+	{
+		++bucket;
+	}
+
+	++updateDurationHistogram[bucket];
+}
+
+
+
+QString VncConnectionTelemetry::updateDurationBucketName( int bucket )
+{
+	if( bucket < 0 || bucket >= UpdateDurationBucketCount )
+	{
+		return {};
+	}
+
+	if( bucket == UpdateDurationBucketCount - 1 )
+	{
+		return QStringLiteral(">=%1ms").arg( __updateDurationBucketLimits[size_t(bucket - 1)] );
+	}
+
+	return QStringLiteral("<%1ms").arg( __updateDurationBucketLimits[size_t(bucket)] );
+}
+
+
+
+QJsonObject VncConnectionTelemetry::toJson() const
+{
+	QJsonObject histogram;
+	for( int i = 0; i < UpdateDurationBucketCount; ++i )
+	{
+		histogram[updateDurationBucketName( i )] = updateDurationHistogram[size_t(i)];
+	}
+
+	const auto seconds = double(connectedTime) / 1000;
+
+	return {
+		{ QStringLiteral("connectionAttempts"), connectionAttempts },
+		{ QStringLiteral("reconnects"), reconnects() },
+		{ QStringLiteral("connectedTime"), connectedTime },
+		{ QStringLiteral("framebufferUpdates"), framebufferUpdates },
+		{ QStringLiteral("framebufferUpdatesPerSecond"), seconds > 0 ? double(framebufferUpdates) / seconds : 0.0 },
+		{ QStringLiteral("rects"), rects },
+		{ QStringLiteral("updatedPixels"), updatedPixels },
+		{ QStringLiteral("averageUpdateDuration"), framebufferUpdates > 0 ?
+													   double(updateDuration) / framebufferUpdates / 1000000 : 0.0 },
+		{ QStringLiteral("averagePublishDuration"), framebufferUpdates > 0 ?
+														double(publishDuration) / framebufferUpdates / 1000000 : 0.0 },
+		{ QStringLiteral("updateDurationHistogram"), histogram },
+		{ QStringLiteral("eventsSent"), eventsSent },
+		{ QStringLiteral("eventQueueDepth"), eventQueueDepth },
+		{ QStringLiteral("maximumEventQueueDepth"), maximumEventQueueDepth },
+		{ QStringLiteral("inputEvents"), inputEvents },
+		{ QStringLiteral("coalescedInputEvents"), coalescedInputEvents },
+		{ QStringLiteral("inputWrites"), inputWrites },
+		{ QStringLiteral("averageInputLatency"), inputEvents > 0 ? double(inputLatency) / inputEvents / 1000000 : 0.0 },
+		{ QStringLiteral("maximumInputLatency"), double(maximumInputLatency) / 1000000 },
+		{ QStringLiteral("encodingLevelChanges"), encodingLevelChanges },
+	};
+}
+
+
+
+QString VncConnectionTelemetry::ipcServerName()
+{
+	// one server per user so veyon-cli always talks to the master of the invoking user
+	return QStringLiteral("VeyonMasterTelemetry-%1").arg( qHash( VeyonCore::platform().userFunctions().currentUser() ) );
+}
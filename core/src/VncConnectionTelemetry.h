@@ -0,0 +1,81 @@
+/*
+ * VncConnectionTelemetry.h - declaration of VncConnectionTelemetry
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <array>
+
+#include <QJsonObject>
+
+#include "VeyonCore.h"
+
+// performance counters of a VNC connection which are only collected while telemetry is enabled
+class VEYON_CORE_EXPORT VncConnectionTelemetry
+{
+public:
+	static constexpr int UpdateDurationBucketCount = 8;
+
+	// requests accepted by the telemetry server of a running master (see ipcServerName())
+	enum class IpcCommand
+	{
+		Dump,
+		Enable,
+		Disable
+	};
+
+	qint64 connectionAttempts{0};
+	qint64 connections{0};
+	qint64 connectedTime{0}; // milliseconds
+	qint64 framebufferUpdates{0};
+	qint64 rects{0};
+	qint64 updatedPixels{0};
+	qint64 updateDuration{0}; // nanoseconds for receiving and decoding updates
+	qint64 publishDuration{0}; // nanoseconds for publishing updates to the front buffer
+	std::array<qint64, UpdateDurationBucketCount> updateDurationHistogram{};
+	qint64 eventsSent{0};
+	int eventQueueDepth{0};
+	int maximumEventQueueDepth{0};
+	qint64 inputEvents{0};
+	qint64 coalescedInputEvents{0};
+	qint64 inputWrites{0};
+	qint64 inputLatency{0}; // nanoseconds from enqueueing input events until writing them to the socket
+	qint64 maximumInputLatency{0}; // nanoseconds
+	qint64 encodingLevelChanges{0};
+
+	qint64 reconnects() const
+	{
+		return qMax<qint64>( 0, connections - 1 );
+	}
+
+	VncConnectionTelemetry& operator+=( const VncConnectionTelemetry& other );
+
+	void addUpdateDuration( qint64 duration );
+
+	static QString updateDurationBucketName( int bucket );
+
+	QJsonObject toJson() const;
+
+	static QString ipcServerName();
+
+} ;
@@ -0,0 +1,64 @@
+/*
+ * VncInputEventQueue.h - declaration of VncInputEventQueue class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "MpscQueue.h"
+
+// keyboard or pointer event - events are plain values so enqueueing them
+// does not require any heap allocations
+struct VncInputEvent
+{
+	enum class Type : quint8
+	{
+		Key,
+		Pointer
+	};
+
+	Type type{Type::Pointer};
+	bool pressed{false};
+	int x{0};
+	int y{0};
+	uint buttonMask{0};
+	uint key{0};
+	qint64 timestamp{0}; // nanoseconds, used for measuring input-to-wire latency
+};
+
+
+// bounded lock-free queue for input events with multiple producers (UI threads)
+// and a single consumer (VNC connection thread)
+class VncInputEventQueue : public MpscQueue<VncInputEvent>
+{
+public:
+	using Event = VncInputEvent;
+
+	// must be a power of two
+	static constexpr int DefaultSize = 1024;
+
+	explicit VncInputEventQueue( int size = DefaultSize ) :
+		MpscQueue( size_t(size) )
+	{
+	}
+
+} ;
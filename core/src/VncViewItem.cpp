@@ -71,15 +71,28 @@ QSGNode* VncViewItem::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* up
 
 	const auto texture = dynamic_cast<QSGImageTexture *>( node->texture() );
 
-	if( viewport().isValid() )
+	const auto screen = m_computerControlInterface->screen();
+	const auto sourceRect = viewport().isValid() ? viewport() : screen.rect();
+
+	if( viewport() == m_textureViewport && texture->textureSize() == sourceRect.size() )
 	{
-		texture->setImage( m_computerControlInterface->screen().copy( viewport() ) );
+		// only upload changed areas to the existing texture - they're copied straight
+		// from the shared screen so there's no need to copy the whole viewport
+		if( m_dirtyRegion.isEmpty() == false )
+		{
+			texture->updateImage( screen, sourceRect, m_dirtyRegion.translated( -sourceRect.topLeft() ) );
+			node->markDirty( QSGNode::DirtyMaterial );
+		}
 	}
 	else
 	{
-		texture->setImage( m_computerControlInterface->screen() );
+		texture->setImage( sourceRect == screen.rect() ? screen : screen.copy( sourceRect ) );
+		node->markDirty( QSGNode::DirtyMaterial );
 	}
 
+	m_textureViewport = viewport();
+	m_dirtyRegion = {};
+
 	node->setRect( boundingRect() );
 
 	return node;
@@ -101,6 +114,15 @@ QSize VncViewItem::viewSize() const
 
 
 
+void VncViewItem::updateImage( int x, int y, int w, int h )
+{
+	m_dirtyRegion += QRect( x, y, w, h );
+
+	VncView::updateImage( x, y, w, h );
+}
+
+
+
 void VncViewItem::updateView( int x, int y, int w, int h )
 {
 	Q_UNUSED(x)
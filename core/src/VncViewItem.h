@@ -40,6 +40,7 @@ public:
 
 protected:
 	virtual void updateView( int x, int y, int w, int h ) override;
+	void updateImage( int x, int y, int w, int h ) override;
 	virtual QSize viewSize() const override;
 	virtual void setViewCursor( const QCursor& cursor ) override;
 
@@ -50,4 +51,8 @@ private:
 	ComputerControlInterface::UpdateMode m_previousUpdateMode;
 	QSize m_framebufferSize;
 
+	// framebuffer areas which have changed since the last texture update
+	QRegion m_dirtyRegion;
+	QRect m_textureViewport;
+
 };
@@ -178,6 +178,12 @@ void VncViewWidget::updateImage( int x, int y, int w, int h )
 
 	}
 
+	m_scaledImageOutdatedRegion += QRect( x, y, w, h );
+	if( m_scaledImageOutdatedRegion.rectCount() > MaxScaledImageUpdateRects )
+	{
+		m_scaledImageOutdatedRegion = m_scaledImageOutdatedRegion.boundingRect();
+	}
+
 	VncView::updateImage( x, y, w, h );
 }
 
@@ -284,11 +290,16 @@ void VncViewWidget::paintEvent( QPaintEvent* paintEvent )
 
 	if( isScaledView() )
 	{
-		// repaint everything in scaled mode to avoid artifacts at rectangle boundaries
-		p.drawImage( QRect( QPoint( 0, 0 ), scaledSize() ), image, source );
+		updateScaledImage( image, source );
+
+		const auto rect = paintEvent->rect() & m_scaledImage.rect();
+		p.drawImage( rect.topLeft(), m_scaledImage, rect );
 	}
 	else
 	{
+		m_scaledImage = {};
+		m_scaledImageOutdatedRegion = {};
+
 		p.drawImage( { 0, 0 }, image, source );
 	}
 
@@ -335,6 +346,65 @@ void VncViewWidget::resizeEvent( QResizeEvent* event )
 
 
 
+void VncViewWidget::updateScaledImage( const QImage& image, const QRect& source )
+{
+	const auto size = scaledSize();
+
+	if( m_scaledImage.size() != size || m_scaledImageSource != source )
+	{
+		m_scaledImage = QImage( size, QImage::Format_RGB32 );
+		m_scaledImageSource = source;
+		m_scaledImageOutdatedRegion = {};
+
+		QPainter painter( &m_scaledImage );
+		painter.setRenderHint( QPainter::SmoothPixmapTransform );
+		painter.drawImage( m_scaledImage.rect(), image, source );
+		return;
+	}
+
+	if( m_scaledImageOutdatedRegion.isEmpty() )
+	{
+		return;
+	}
+
+	const auto scaleX = qreal( size.width() ) / source.width();
+	const auto scaleY = qreal( size.height() ) / source.height();
+
+	QPainter painter( &m_scaledImage );
+	painter.setRenderHint( QPainter::SmoothPixmapTransform );
+
+	for( const auto& outdatedRect : m_scaledImageOutdatedRegion )
+	{
+		const auto updateRect = outdatedRect & source;
+		if( updateRect.isEmpty() )
+		{
+			continue;
+		}
+
+		// affected pixels of the scaled image
+		const QRect targetRect( QPoint( qFloor( ( updateRect.left() - source.left() ) * scaleX ),
+										qFloor( ( updateRect.top() - source.top() ) * scaleY ) ),
+								QPoint( qCeil( ( updateRect.right() + 1 - source.left() ) * scaleX ) - 1,
+										qCeil( ( updateRect.bottom() + 1 - source.top() ) * scaleY ) - 1 ) );
+
+		// draw a slightly larger area clipped to the affected pixels so that interpolation
+		// uses the same neighboring pixels as when rescaling the full image
+		const auto guardedSource = updateRect.adjusted( -ScaledImageGuardBand, -ScaledImageGuardBand,
+														ScaledImageGuardBand, ScaledImageGuardBand ) & source;
+		const QRectF guardedTarget( ( guardedSource.x() - source.x() ) * scaleX,
+									( guardedSource.y() - source.y() ) * scaleY,
+									guardedSource.width() * scaleX,
+									guardedSource.height() * scaleY );
+
+		painter.setClipRect( targetRect );
+		painter.drawImage( guardedTarget, image, guardedSource );
+	}
+
+	m_scaledImageOutdatedRegion = {};
+}
+
+
+
 void VncViewWidget::updateConnectionState()
 {
 	if( m_establishingConnectionWidget )
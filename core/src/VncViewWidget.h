@@ -67,6 +67,12 @@ protected:
 
 private:
 	void updateConnectionState();
+	void updateScaledImage( const QImage& image, const QRect& source );
+
+	// guard band (in framebuffer pixels) around updated rectangles to sample from when
+	// rescaling them in order to avoid seams due to interpolation at rectangle boundaries
+	static constexpr int ScaledImageGuardBand = 1;
+	static constexpr int MaxScaledImageUpdateRects = 64;
 
 	VeyonConnection* m_veyonConnection{nullptr};
 
@@ -75,6 +81,11 @@ private:
 
 	ProgressWidget* m_establishingConnectionWidget{nullptr};
 
+	// cached scaled framebuffer which is updated for changed areas only
+	QImage m_scaledImage{};
+	QRect m_scaledImageSource{};
+	QRegion m_scaledImageOutdatedRegion{};
+
 	static constexpr int MouseBorderSignalDelay = 500;
 	QTimer m_mouseBorderSignalTimer{this};
 
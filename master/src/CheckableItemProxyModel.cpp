@@ -95,16 +95,14 @@ bool CheckableItemProxyModel::setData( const QModelIndex& index, const QVariant&
 		return QIdentityProxyModel::setData( index, value, role );
 	}
 
-	const auto uuid = indexToUuid( index );
 	const auto checkState = value.value<Qt::CheckState>();
 
-	if( qAsConst(m_checkStates)[uuid] != checkState )
+	if( setCheckState( indexToUuid( index.parent() ), indexToUuid( index ), checkState ) )
 	{
-		m_checkStates[uuid] = checkState;
 		Q_EMIT dataChanged( index, index, { Qt::CheckStateRole } );
 
 		setChildData( index, checkState );
-		setParentData( index.parent(), checkState );
+		setParentData( index.parent() );
 	}
 
 	return true;
@@ -117,10 +115,17 @@ void CheckableItemProxyModel::updateNewRows(const QModelIndex &parent, int first
 	// also set newly inserted items checked if parent is checked
 	if( parent.isValid() && data( parent, Qt::CheckStateRole ).value<Qt::CheckState>() == Qt::Checked )
 	{
+		const auto parentUuid = indexToUuid( parent );
+
 		for( int i = first; i <= last; ++i )
 		{
-			setData( index( i, 0, parent ), Qt::Checked, Qt::CheckStateRole );
+			const auto childIndex = index( i, 0, parent );
+			setCheckState( parentUuid, indexToUuid( childIndex ), Qt::Checked );
+			setChildData( childIndex, Qt::Checked );
 		}
+
+		// parent stays checked as all of its children are checked now
+		Q_EMIT dataChanged( index( first, 0, parent ), index( last, 0, parent ), { Qt::CheckStateRole } );
 	}
 }
 
@@ -128,9 +133,25 @@ void CheckableItemProxyModel::updateNewRows(const QModelIndex &parent, int first
 
 void CheckableItemProxyModel::removeRowStates(const QModelIndex &parent, int first, int last)
 {
+	CheckStateCounts removedCounts;
+
 	for( int i = first; i <= last; ++i )
 	{
-		m_checkStates.remove( QIdentityProxyModel::data( index( i, 0, parent ), m_uidRole ).toUuid() );
+		const auto childIndex = index( i, 0, parent );
+		const auto uuid = indexToUuid( childIndex );
+
+		removedCounts.update( m_checkStates.take( uuid ), 1 );
+
+		// descendants go away along with the row without notifications of their own
+		removeRowStates( childIndex, 0, rowCount( childIndex ) - 1 );
+		m_childCheckStateCounts.remove( uuid );
+	}
+
+	const auto counts = m_childCheckStateCounts.find( indexToUuid( parent ) );
+	if( counts != m_childCheckStateCounts.end() )
+	{
+		counts->checked -= removedCounts.checked;
+		counts->partiallyChecked -= removedCounts.partiallyChecked;
 	}
 }
 
@@ -158,19 +179,20 @@ void CheckableItemProxyModel::loadStates( const QJsonArray& data )
 	beginResetModel();
 
 	m_checkStates.clear();
+	m_childCheckStateCounts.clear();
+
+	QSet<QUuid> checkedUids;
+	checkedUids.reserve( data.size() );
 
 	for( const auto& item : data )
 	{
-		const QUuid uid = QUuid( item.toString() );
-		const auto indexList = match( index( 0, 0 ), m_uidRole, uid, 1, // clazy:exclude=inefficient-qlist
-									  Qt::MatchExactly | Qt::MatchRecursive );
-		if( indexList.isEmpty() == false &&
-				hasChildren( indexList.first() ) == false )
-		{
-			setData( indexList.first(), Qt::Checked, Qt::CheckStateRole );
-		}
+		checkedUids.insert( QUuid( item.toString() ) );
 	}
 
+	// traverse the model once and derive states of parents from their children
+	// instead of searching the whole model for every checked item
+	loadChildStates( {}, checkedUids );
+
 	endResetModel();
 }
 
@@ -178,11 +200,61 @@ void CheckableItemProxyModel::loadStates( const QJsonArray& data )
 
 QUuid CheckableItemProxyModel::indexToUuid( const QModelIndex& index ) const
 {
+	if( index.isValid() == false )
+	{
+		return {};
+	}
+
 	return QIdentityProxyModel::data( index, m_uidRole ).toUuid();
 }
 
 
 
+bool CheckableItemProxyModel::setCheckState( const QUuid& parentUuid, const QUuid& uuid, Qt::CheckState checkState )
+{
+	const auto it = m_checkStates.constFind( uuid );
+	const auto previousCheckState = it != m_checkStates.constEnd() ? it.value() : Qt::Unchecked;
+
+	if( previousCheckState == checkState )
+	{
+		return false;
+	}
+
+	auto& counts = m_childCheckStateCounts[parentUuid]; // clazy:exclude=detaching-member
+	counts.update( previousCheckState, -1 );
+	counts.update( checkState, 1 );
+
+	m_checkStates[uuid] = checkState;
+
+	return true;
+}
+
+
+
+Qt::CheckState CheckableItemProxyModel::childrenCheckState( const QUuid& uuid, int childCount ) const
+{
+	if( childCount <= 0 )
+	{
+		return Qt::Unchecked;
+	}
+
+	const auto counts = m_childCheckStateCounts.value( uuid );
+
+	if( counts.checked >= childCount )
+	{
+		return Qt::Checked;
+	}
+
+	if( counts.checked > 0 || counts.partiallyChecked > 0 )
+	{
+		return Qt::PartiallyChecked;
+	}
+
+	return Qt::Unchecked;
+}
+
+
+
 bool CheckableItemProxyModel::setChildData( const QModelIndex& index, Qt::CheckState checkState )
 {
 	bool modified = false;
@@ -192,6 +264,7 @@ bool CheckableItemProxyModel::setChildData( const QModelIndex& index, Qt::CheckS
 		fetchMore( index );
 	}
 
+	const auto uuid = indexToUuid( index );
 	const auto childCount = rowCount( index );
 
 	if( childCount > 0 )
@@ -199,11 +272,9 @@ bool CheckableItemProxyModel::setChildData( const QModelIndex& index, Qt::CheckS
 		for( int i = 0; i < childCount; ++i )
 		{
 			const auto childIndex = this->index( i, 0, index );
-			const auto childUuid = indexToUuid( childIndex );
 
-			if( qAsConst(m_checkStates)[childUuid] != checkState )
+			if( setCheckState( uuid, indexToUuid( childIndex ), checkState ) )
 			{
-				m_checkStates[childUuid] = checkState;
 				modified = true;
 			}
 
@@ -224,31 +295,44 @@ bool CheckableItemProxyModel::setChildData( const QModelIndex& index, Qt::CheckS
 
 
 
-void CheckableItemProxyModel::setParentData( const QModelIndex& index, Qt::CheckState checkState )
+void CheckableItemProxyModel::setParentData( const QModelIndex& index )
 {
 	if( index.isValid() == false )
 	{
 		return;
 	}
 
-	const auto childCount = rowCount( index );
+	const auto uuid = indexToUuid( index );
+	const auto parent = index.parent();
 
-	for( int i = 0; i < childCount; ++i )
+	if( setCheckState( indexToUuid( parent ), uuid, childrenCheckState( uuid, rowCount( index ) ) ) )
 	{
-		if( data( this->index( i, 0, index ), Qt::CheckStateRole ).value<Qt::CheckState>() != checkState )
-		{
-			checkState = Qt::PartiallyChecked;
-			break;
-		}
+		Q_EMIT dataChanged( index, index, { Qt::CheckStateRole } );
+
+		setParentData( parent );
 	}
+}
+
 
-	const auto uuid = indexToUuid( index );
 
-	if( qAsConst(m_checkStates)[uuid] != checkState )
+void CheckableItemProxyModel::loadChildStates( const QModelIndex& parent, const QSet<QUuid>& checkedUids )
+{
+	const auto parentUuid = indexToUuid( parent );
+	const auto childCount = rowCount( parent );
+
+	for( int i = 0; i < childCount; ++i )
 	{
-		m_checkStates[uuid] = checkState;
-		Q_EMIT dataChanged( index, index, { Qt::CheckStateRole } );
+		const auto childIndex = index( i, 0, parent );
+		const auto childUuid = indexToUuid( childIndex );
 
-		setParentData( index.parent(), checkState );
+		if( hasChildren( childIndex ) )
+		{
+			loadChildStates( childIndex, checkedUids );
+			setCheckState( parentUuid, childUuid, childrenCheckState( childUuid, rowCount( childIndex ) ) );
+		}
+		else if( checkedUids.contains( childUuid ) )
+		{
+			setCheckState( parentUuid, childUuid, Qt::Checked );
+		}
 	}
 }
@@ -26,6 +26,7 @@
 
 #include <QJsonArray>
 #include <QIdentityProxyModel>
+#include <QSet>
 #include <QUuid>
 
 class CheckableItemProxyModel : public QIdentityProxyModel
@@ -48,14 +49,41 @@ public:
 	QJsonArray saveStates();
 	void loadStates( const QJsonArray& data );
 
+	Qt::CheckState checkState( const QUuid& uid ) const
+	{
+		return m_checkStates.value( uid, Qt::Unchecked );
+	}
+
 private:
+	// number of checked and partially checked children of an item so its
+	// tri-state can be derived without querying all of its children
+	struct CheckStateCounts
+	{
+		int checked{0};
+		int partiallyChecked{0};
+
+		void update( Qt::CheckState checkState, int delta )
+		{
+			switch( checkState )
+			{
+			case Qt::Checked: checked += delta; break;
+			case Qt::PartiallyChecked: partiallyChecked += delta; break;
+			default: break;
+			}
+		}
+	};
+
 	QUuid indexToUuid( const QModelIndex& index ) const;
+	bool setCheckState( const QUuid& parentUuid, const QUuid& uuid, Qt::CheckState checkState );
+	Qt::CheckState childrenCheckState( const QUuid& uuid, int childCount ) const;
 	bool setChildData( const QModelIndex &index, Qt::CheckState checkState );
-	void setParentData( const QModelIndex &index, Qt::CheckState checkState );
+	void setParentData( const QModelIndex &index );
+	void loadChildStates( const QModelIndex& parent, const QSet<QUuid>& checkedUids );
 
 	int m_uidRole{-1};
 	int m_exceptionRole{-1};
 	QVariant m_exceptionData{};
 	QHash<QUuid, Qt::CheckState> m_checkStates;
+	QHash<QUuid, CheckStateCounts> m_childCheckStateCounts;
 
 };
@@ -23,6 +23,7 @@
  */
 
 #include <QPainter>
+#include <QTimer>
 
 #include "ComputerControlListModel.h"
 #include "ComputerManager.h"
@@ -194,16 +195,19 @@ void ComputerControlListModel::updateComputerScreenSize()
 
 	for( auto& controlInterface : m_computerControlInterfaces )
 	{
-		controlInterface->setScaledScreenSize( newSize );
+		if( controlInterface->scaledScreenSize() != newSize )
+		{
+			controlInterface->setScaledScreenSize( newSize );
+		}
 	}
 
 	if( m_computerScreenSize != newSize )
 	{
 		m_computerScreenSize = newSize;
 
-		for( int i = 0; i < rowCount(); ++i )
+		if( rowCount() > 0 )
 		{
-			updateScreen( index( i ) );
+			Q_EMIT dataChanged( index( 0 ), index( rowCount() - 1 ), { Qt::DecorationRole, ImageIdRole, ScreenRole } );
 		}
 
 		Q_EMIT computerScreenSizeChanged();
@@ -241,76 +245,143 @@ ComputerControlInterface::Pointer ComputerControlListModel::computerControlInter
 
 void ComputerControlListModel::reload()
 {
-	beginResetModel();
+	const auto computerList = m_master->computerManager().selectedComputers();
 
-	const auto computerList = m_master->computerManager().selectedComputers( QModelIndex() );
+	// keep interfaces (and thereby their connections) of computers which did not change
+	QHash<NetworkObject::Uid, ComputerControlInterface::Pointer> currentInterfaces;
+	currentInterfaces.reserve( m_computerControlInterfaces.size() );
 
-	m_computerControlInterfaces.clear();
-	m_computerControlInterfaces.reserve( computerList.size() );
+	for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+	{
+		currentInterfaces[controlInterface->computer().networkObjectUid()] = controlInterface;
+	}
 
-	int row = 0;
+	ComputerControlInterfaceList controlInterfaces;
+	ComputerControlInterfaceList addedInterfaces;
+	ComputerControlInterfaceList removedInterfaces;
+	controlInterfaces.reserve( computerList.size() );
 
 	for( const auto& computer : computerList )
 	{
-		const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-		m_computerControlInterfaces.append( controlInterface );
-		startComputerControlInterface( controlInterface.data() );
-		++row;
+		auto controlInterface = currentInterfaces.take( computer.networkObjectUid() );
+		if( controlInterface.isNull() || isSameComputer( controlInterface->computer(), computer ) == false )
+		{
+			if( controlInterface.isNull() == false )
+			{
+				removedInterfaces.append( controlInterface );
+			}
+
+			controlInterface = ComputerControlInterface::Pointer::create( computer );
+			addedInterfaces.append( controlInterface );
+		}
+
+		controlInterfaces.append( controlInterface );
 	}
 
+	for( auto it = currentInterfaces.constBegin(), end = currentInterfaces.constEnd(); it != end; ++it )
+	{
+		removedInterfaces.append( it.value() );
+	}
+
+	beginResetModel();
+	m_computerControlInterfaces = controlInterfaces;
 	endResetModel();
+
+	for( const auto& controlInterface : qAsConst(addedInterfaces) )
+	{
+		startComputerControlInterface( controlInterface.data() );
+	}
+
+	stopComputerControlInterfaces( removedInterfaces );
+
+	updateComputerScreenSize();
 }
 
 
 
 void ComputerControlListModel::update()
 {
-	const auto newComputerList = m_master->computerManager().selectedComputers( QModelIndex() );
+	const auto newComputerList = m_master->computerManager().selectedComputers();
 
-	int row = 0;
+	QHash<NetworkObject::Uid, Computer> newComputers;
+	newComputers.reserve( newComputerList.size() );
 
-	for( auto it = m_computerControlInterfaces.begin(); it != m_computerControlInterfaces.end(); ) // clazy:exclude=detaching-member
+	for( const auto& computer : newComputerList )
 	{
-		if( newComputerList.contains( (*it)->computer() ) == false )
+		newComputers[computer.networkObjectUid()] = computer;
+	}
+
+	// drop computers which are selected already from the hash so it only contains new computers
+	// afterwards while all other interfaces are removed in contiguous ranges
+	QVector<bool> retained( m_computerControlInterfaces.count(), false );
+
+	for( int row = 0; row < m_computerControlInterfaces.count(); ++row )
+	{
+		const auto& computer = m_computerControlInterfaces.at( row )->computer();
+		const auto it = newComputers.find( computer.networkObjectUid() );
+		if( it != newComputers.end() && isSameComputer( computer, it.value() ) )
 		{
-			stopComputerControlInterface( *it );
+			newComputers.erase( it );
+			retained[row] = true;
+		}
+	}
+
+	ComputerControlInterfaceList removedInterfaces;
 
-			beginRemoveRows( QModelIndex(), row, row );
-			it = m_computerControlInterfaces.erase( it );
-			endRemoveRows();
+	for( int last = m_computerControlInterfaces.count() - 1; last >= 0; )
+	{
+		if( retained.at( last ) )
+		{
+			--last;
+			continue;
 		}
-		else
+
+		int first = last;
+		while( first > 0 && retained.at( first-1 ) == false )
 		{
-			++it;
-			++row;
+			--first;
 		}
+
+		beginRemoveRows( QModelIndex(), first, last );
+		removedInterfaces += m_computerControlInterfaces.mid( first, last - first + 1 );
+		m_computerControlInterfaces.remove( first, last - first + 1 );
+		endRemoveRows();
+
+		last = first - 1;
 	}
 
-	row = 0;
+	// append newly selected computers as a single range - views sort the model on their own
+	ComputerControlInterfaceList addedInterfaces;
+	addedInterfaces.reserve( newComputers.size() );
 
 	for( const auto& computer : newComputerList )
 	{
-		if( row < m_computerControlInterfaces.count() && m_computerControlInterfaces[row]->computer() != computer )
+		if( newComputers.contains( computer.networkObjectUid() ) )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.insert( row, controlInterface );
-			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
+			addedInterfaces.append( ComputerControlInterface::Pointer::create( computer ) );
 		}
-		else if( row >= m_computerControlInterfaces.count() )
+	}
+
+	if( addedInterfaces.isEmpty() == false )
+	{
+		const auto first = m_computerControlInterfaces.count();
+
+		beginInsertRows( QModelIndex(), first, first + addedInterfaces.count() - 1 );
+		m_computerControlInterfaces += addedInterfaces;
+		endInsertRows();
+
+		for( const auto& controlInterface : qAsConst(addedInterfaces) )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.append( controlInterface );
 			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
 		}
-
-		++row;
 	}
 
-	updateComputerScreenSize();
+	stopComputerControlInterfaces( removedInterfaces );
+
+	if( addedInterfaces.isEmpty() == false || removedInterfaces.isEmpty() == false )
+	{
+		updateComputerScreenSize();
+	}
 }
 
 
@@ -384,14 +455,43 @@ void ComputerControlListModel::startComputerControlInterface( ComputerControlInt
 
 
 
-void ComputerControlListModel::stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface )
+void ComputerControlListModel::stopComputerControlInterfaces( const ComputerControlInterfaceList& controlInterfaces )
 {
-	m_master->stopAllModeFeatures( { controlInterface } );
+	if( controlInterfaces.isEmpty() )
+	{
+		return;
+	}
+
+	// interfaces are not part of the model anymore so make sure they do not refer to it
+	for( const auto& controlInterface : controlInterfaces )
+	{
+		controlInterface->disconnect( this );
+	}
+
+	// stop all interfaces in one batch once control returns to the event loop so the
+	// model and the views reflect the new selection immediately
+	QTimer::singleShot( 0, this, [this, controlInterfaces]() {
+		m_master->stopAllModeFeatures( controlInterfaces );
+
+		for( const auto& controlInterface : controlInterfaces )
+		{
+			controlInterface->disconnect( &m_master->computerManager() );
 
-	controlInterface->disconnect( &m_master->computerManager() );
+			controlInterface->setUserInformation( {}, {}, -1 );
+			m_master->computerManager().updateUser( controlInterface );
+		}
+	} );
+}
 
-	controlInterface->setUserInformation( {}, {}, -1 );
-	m_master->computerManager().updateUser( controlInterface );
+
+
+bool ComputerControlListModel::isSameComputer( const Computer& computer, const Computer& other )
+{
+	return computer.networkObjectUid() == other.networkObjectUid() &&
+			computer.name() == other.name() &&
+			computer.hostAddress() == other.hostAddress() &&
+			computer.macAddress() == other.macAddress() &&
+			computer.location() == other.location();
 }
 
 
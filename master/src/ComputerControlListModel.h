@@ -84,7 +84,9 @@ private:
 	void updateUser( const QModelIndex& index );
 
 	void startComputerControlInterface( ComputerControlInterface* controlInterface );
-	void stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface );
+	void stopComputerControlInterfaces( const ComputerControlInterfaceList& controlInterfaces );
+
+	static bool isSameComputer( const Computer& computer, const Computer& other );
 
 	double averageAspectRatio() const;
 
@@ -69,6 +69,13 @@ ComputerManager::ComputerManager( UserConfig& config, QObject* parent ) :
 								 QHostInfo::localDomainName().toLower() );
 	}
 
+	// emit a single selection change notification per user action even if checking
+	// an item changes the states of many items
+	m_computerSelectionChangedTimer.setSingleShot( true );
+	m_computerSelectionChangedTimer.setInterval( 0 );
+	connect( &m_computerSelectionChangedTimer, &QTimer::timeout,
+			 this, &ComputerManager::computerSelectionChanged );
+
 	initNetworkObjectLayer();
 	initLocations();
 	initComputerTreeModel();
@@ -108,7 +115,7 @@ bool ComputerManager::saveComputerAndUsersList( const QString& fileName )
 {
 	QStringList lines( tr( "Computer name;Hostname;User" ) );
 
-	const auto computers = selectedComputers( QModelIndex() );
+	const auto computers = selectedComputers();
 
 	for( const auto& computer : computers )
 	{
@@ -167,7 +174,7 @@ void ComputerManager::checkChangedData( const QModelIndex& topLeft, const QModel
 
 	if( roles.contains( Qt::CheckStateRole ) )
 	{
-		Q_EMIT computerSelectionChanged();
+		m_computerSelectionChangedTimer.start();
 	}
 }
 
@@ -185,7 +192,7 @@ void ComputerManager::initLocations()
 		vDebug() << "initializing locations for host address" << address.toString();
 	}
 
-	m_currentLocations.append( findLocationOfComputer( m_localHostNames, m_localHostAddresses, QModelIndex() ) );
+	m_currentLocations.append( findLocationOfComputer( m_localHostNames, m_localHostAddresses ) );
 
 	vDebug() << "found locations" << m_currentLocations;
 
@@ -273,9 +280,12 @@ void ComputerManager::initComputerTreeModel()
 	QJsonArray checkedNetworkObjects;
 	if( VeyonCore::config().autoSelectCurrentLocation() )
 	{
+		const auto& rootObject = m_networkObjectDirectory->object( 0, m_networkObjectDirectory->rootId() );
+
 		for( const auto& location : qAsConst( m_currentLocations ) )
 		{
-			const auto computersAtLocation = getComputersAtLocation( location );
+			ComputerList computersAtLocation;
+			getComputersAtLocation( location, rootObject, computersAtLocation );
 			for( const auto& computer : computersAtLocation )
 			{
 				checkedNetworkObjects += computer.networkObjectUid().toString();
@@ -297,9 +307,9 @@ void ComputerManager::initComputerTreeModel()
 	connect( computerTreeModel(), &QAbstractItemModel::dataChanged,
 			 this, &ComputerManager::checkChangedData );
 	connect( computerTreeModel(), &QAbstractItemModel::rowsInserted,
-			 this, &ComputerManager::computerSelectionChanged );
+			 this, [this]() { m_computerSelectionChangedTimer.start(); } );
 	connect( computerTreeModel(), &QAbstractItemModel::rowsRemoved,
-			 this, &ComputerManager::computerSelectionChanged );
+			 this, [this]() { m_computerSelectionChangedTimer.start(); } );
 }
 
 
@@ -314,36 +324,37 @@ void ComputerManager::updateLocationFilterList()
 
 
 
-QString ComputerManager::findLocationOfComputer( const QStringList& hostNames, const QList<QHostAddress>& hostAddresses, const QModelIndex& parent )
+ComputerList ComputerManager::selectedComputers()
 {
-	QAbstractItemModel* model = networkObjectModel();
+	ComputerList computers;
 
-	int rows = model->rowCount( parent );
+	addSelectedComputers( m_networkObjectDirectory->object( 0, m_networkObjectDirectory->rootId() ), computers );
 
-	for( int i = 0; i < rows; ++i )
-	{
-		QModelIndex entryIndex = model->index( i, 0, parent );
+	return computers;
+}
 
-		auto objectType = static_cast<NetworkObject::Type>( model->data( entryIndex, NetworkObjectModel::TypeRole ).toInt() );
 
-		if( objectType == NetworkObject::Type::Location ||
-			objectType == NetworkObject::Type::DesktopGroup )
-		{
-			const auto location = findLocationOfComputer( hostNames, hostAddresses, entryIndex );
-			if( location.isEmpty() == false )
-			{
-				return location;
-			}
-		}
-		else if( objectType == NetworkObject::Type::Host )
+
+QString ComputerManager::findLocationOfComputer( const QStringList& hostNames, const QList<QHostAddress>& hostAddresses )
+{
+	auto hosts = hostNames;
+	for( const auto& hostAddress : hostAddresses )
+	{
+		hosts.append( hostAddress.toString() );
+	}
+
+	for( const auto& host : qAsConst(hosts) )
+	{
+		const auto hostObjectIds = m_networkObjectDirectory->hostObjectIds( host );
+		for( const auto hostObjectId : hostObjectIds )
 		{
-			QString currentHost = model->data( entryIndex, NetworkObjectModel::HostAddressRole ).toString().toLower();
-			QHostAddress currentHostAddress;
+			const auto locationId = m_networkObjectDirectory->parentId( hostObjectId );
+			const auto& location = m_networkObjectDirectory->object( m_networkObjectDirectory->parentId( locationId ), locationId );
 
-			if( hostNames.contains( currentHost ) ||
-					( currentHostAddress.setAddress( currentHost ) && hostAddresses.contains( currentHostAddress ) ) )
+			if( location.type() == NetworkObject::Type::Location ||
+				location.type() == NetworkObject::Type::DesktopGroup )
 			{
-				return model->data( parent, NetworkObjectModel::NameRole ).toString();
+				return location.name();
 			}
 		}
 	}
@@ -353,116 +364,68 @@ QString ComputerManager::findLocationOfComputer( const QStringList& hostNames, c
 
 
 
-ComputerList ComputerManager::getComputersAtLocation( const QString& locationName, const QModelIndex& parent )
+void ComputerManager::getComputersAtLocation( const QString& locationName, const NetworkObject& parent, ComputerList& computers )
 {
-	QAbstractItemModel* model = computerTreeModel();
+	const auto& objects = m_networkObjectDirectory->objects( parent );
 
-	int rows = model->rowCount( parent );
-
-	ComputerList computers;
-
-	for( int i = 0; i < rows; ++i )
+	for( const auto& object : objects )
 	{
-		QModelIndex entryIndex = model->index( i, 0, parent );
-
-		auto objectType = static_cast<NetworkObject::Type>( model->data( entryIndex, NetworkObjectModel::TypeRole ).toInt() );
-
-		switch( objectType )
+		switch( object.type() )
 		{
 		case NetworkObject::Type::Location:
 		case NetworkObject::Type::DesktopGroup:
-			if( model->data( entryIndex, NetworkObjectModel::NameRole ).toString() == locationName )
+			if( object.name() == locationName )
 			{
-				computers += getComputersAtLocation( locationName, entryIndex );
+				getComputersAtLocation( locationName, object, computers );
 			}
 			break;
 		case NetworkObject::Type::Host:
-			computers += Computer( model->data( entryIndex, NetworkObjectModel::UidRole ).toUuid(),
-								   model->data( entryIndex, NetworkObjectModel::NameRole ).toString(),
-								   model->data( entryIndex, NetworkObjectModel::HostAddressRole ).toString(),
-								   model->data( entryIndex, NetworkObjectModel::MacAddressRole ).toString() );
+			computers += Computer( object.uid(), object.name(),
+								   object.property( NetworkObject::Property::HostAddress ).toString(),
+								   object.property( NetworkObject::Property::MacAddress ).toString() );
 			break;
 		default: break;
 		}
 	}
-
-	return computers;
 }
 
 
 
-ComputerList ComputerManager::selectedComputers( const QModelIndex& parent )
+void ComputerManager::addSelectedComputers( const NetworkObject& parent, ComputerList& computers )
 {
-	QAbstractItemModel* model = computerTreeModel();
-
-	int rows = model->rowCount( parent );
-
-	ComputerList computers;
+	// walk the directory instead of the (proxied) models - check states only exist for objects
+	// which are visible in the computer tree model so hidden objects are skipped as well
+	const auto& objects = m_networkObjectDirectory->objects( parent );
 
-	for( int i = 0; i < rows; ++i )
+	for( const auto& object : objects )
 	{
-		QModelIndex entryIndex = model->index( i, 0, parent );
-
-		if( model->data( entryIndex, NetworkObjectModel::CheckStateRole ).value<Qt::CheckState>() == Qt::Unchecked )
+		if( m_computerTreeModel->checkState( object.uid() ) == Qt::Unchecked )
 		{
 			continue;
 		}
 
-		auto objectType = static_cast<NetworkObject::Type>( model->data( entryIndex, NetworkObjectModel::TypeRole ).toInt() );
-
-		switch( objectType )
+		switch( object.type() )
 		{
 		case NetworkObject::Type::Location:
 		case NetworkObject::Type::DesktopGroup:
-			computers += selectedComputers( entryIndex );
+			addSelectedComputers( object, computers );
 			break;
 		case NetworkObject::Type::Host:
-			computers += Computer( model->data( entryIndex, NetworkObjectModel::UidRole ).toUuid(),
-								   model->data( entryIndex, NetworkObjectModel::NameRole ).toString(),
-								   model->data( entryIndex, NetworkObjectModel::HostAddressRole ).toString(),
-								   model->data( entryIndex, NetworkObjectModel::MacAddressRole ).toString(),
-								   model->data( parent, NetworkObjectModel::NameRole ).toString() );
+			computers += Computer( object.uid(), object.name(),
+								   object.property( NetworkObject::Property::HostAddress ).toString(),
+								   object.property( NetworkObject::Property::MacAddress ).toString(),
+								   parent.name() );
 			break;
 		default: break;
 		}
 	}
-
-	return computers;
 }
 
 
 
-QModelIndex ComputerManager::findNetworkObject( NetworkObject::Uid networkObjectUid, const QModelIndex& parent )
+QModelIndex ComputerManager::findNetworkObject( NetworkObject::Uid networkObjectUid )
 {
-	QAbstractItemModel* model = networkObjectModel();
-
-	int rows = model->rowCount( parent );
-
-	for( int i = 0; i < rows; ++i )
-	{
-		QModelIndex entryIndex = model->index( i, 0, parent );
-
-		auto objectType = static_cast<NetworkObject::Type>( model->data( entryIndex, NetworkObjectModel::TypeRole ).toInt() );
-
-		if( objectType == NetworkObject::Type::Location ||
-			objectType == NetworkObject::Type::DesktopGroup )
-		{
-			QModelIndex index = findNetworkObject( networkObjectUid, entryIndex );
-			if( index.isValid() )
-			{
-				return index;
-			}
-		}
-		else if( objectType == NetworkObject::Type::Host )
-		{
-			if( model->data( entryIndex, NetworkObjectModel::UidRole ).toUuid() == networkObjectUid )
-			{
-				return entryIndex;
-			}
-		}
-	}
-
-	return {};
+	return m_networkObjectModel->indexOf( networkObjectUid );
 }
 
 
@@ -24,8 +24,11 @@
 
 #pragma once
 
+#include <QTimer>
+
 #include "CheckableItemProxyModel.h"
 #include "ComputerControlInterface.h"
+#include "NetworkObjectTreeModel.h"
 
 class QHostAddress;
 class NetworkObjectDirectory;
@@ -50,7 +53,7 @@ public:
 		return m_computerTreeModel;
 	}
 
-	ComputerList selectedComputers( const QModelIndex& parent );
+	ComputerList selectedComputers();
 
 	void addLocation( const QString& location );
 	void removeLocation( const QString& location );
@@ -71,11 +74,12 @@ private:
 	void initComputerTreeModel();
 	void updateLocationFilterList();
 
-	QString findLocationOfComputer( const QStringList& hostNames, const QList<QHostAddress>& hostAddresses, const QModelIndex& parent );
+	QString findLocationOfComputer( const QStringList& hostNames, const QList<QHostAddress>& hostAddresses );
 
-	ComputerList getComputersAtLocation( const QString& locationName, const QModelIndex& parent = QModelIndex() );
+	void getComputersAtLocation( const QString& locationName, const NetworkObject& parent, ComputerList& computers );
+	void addSelectedComputers( const NetworkObject& parent, ComputerList& computers );
 
-	QModelIndex findNetworkObject( NetworkObject::Uid networkObjectUid, const QModelIndex& parent = QModelIndex() );
+	QModelIndex findNetworkObject( NetworkObject::Uid networkObjectUid );
 
 	QModelIndex mapToUserNameModelIndex( const QModelIndex& networkObjectIndex );
 
@@ -84,7 +88,7 @@ private:
 	UserConfig& m_config;
 
 	NetworkObjectDirectory* m_networkObjectDirectory;
-	QAbstractItemModel* m_networkObjectModel;
+	NetworkObjectTreeModel* m_networkObjectModel;
 	NetworkObjectOverlayDataModel* m_networkObjectOverlayDataModel;
 	CheckableItemProxyModel* m_computerTreeModel;
 	NetworkObjectFilterProxyModel* m_networkObjectFilterProxyModel;
@@ -95,4 +99,6 @@ private:
 	QStringList m_localHostNames;
 	QList<QHostAddress> m_localHostAddresses;
 
+	QTimer m_computerSelectionChangedTimer{this};
+
 };
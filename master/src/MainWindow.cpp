@@ -44,6 +44,7 @@
 #include "NetworkObjectDirectoryManager.h"
 #include "SlideshowPanel.h"
 #include "SpotlightPanel.h"
+#include "TelemetryPanel.h"
 #include "ToolButton.h"
 #include "VeyonConfiguration.h"
 #include "VeyonMaster.h"
@@ -96,6 +97,7 @@ MainWindow::MainWindow( VeyonMaster &masterCore, QWidget* parent ) :
 	auto screenshotManagementPanel = new ScreenshotManagementPanel();
 	auto slideshowPanel = new SlideshowPanel( m_master.userConfig(), ui->computerMonitoringWidget );
 	auto spotlightPanel = new SpotlightPanel( m_master.userConfig(), ui->computerMonitoringWidget );
+	auto telemetryPanel = new TelemetryPanel( m_master );
 
 	slideshowSpotlightSplitter->addWidget( slideshowPanel );
 	slideshowSpotlightSplitter->addWidget( spotlightPanel );
@@ -110,6 +112,7 @@ MainWindow::MainWindow( VeyonMaster &masterCore, QWidget* parent ) :
 	mainSplitter->addWidget( computerSelectPanel );
 	mainSplitter->addWidget( screenshotManagementPanel );
 	mainSplitter->addWidget( monitoringSplitter );
+	mainSplitter->addWidget( telemetryPanel );
 
 	mainSplitter->setStretchFactor( mainSplitter->indexOf(monitoringSplitter), 1 );
 
@@ -118,7 +121,8 @@ MainWindow::MainWindow( VeyonMaster &masterCore, QWidget* parent ) :
 		{ computerSelectPanel, ui->computerSelectPanelButton },
 		{ screenshotManagementPanel, ui->screenshotManagementPanelButton },
 		{ slideshowPanel, ui->slideshowPanelButton },
-		{ spotlightPanel, ui->spotlightPanelButton }
+		{ spotlightPanel, ui->spotlightPanelButton },
+		{ telemetryPanel, ui->telemetryPanelButton }
 	};
 
 	for( auto it = panelButtons.constBegin(), end = panelButtons.constEnd(); it != end; ++it )
@@ -226,6 +226,19 @@ Qt::ItemFlags NetworkObjectTreeModel::flags( const QModelIndex& index ) const
 
 
 
+QModelIndex NetworkObjectTreeModel::indexOf( NetworkObject::Uid uid ) const
+{
+	const auto modelId = m_directory->modelId( uid );
+	if( modelId )
+	{
+		return objectIndex( modelId );
+	}
+
+	return {};
+}
+
+
+
 void NetworkObjectTreeModel::beginInsertObjects( const NetworkObject& parent, int index, int count )
 {
 	beginInsertRows( objectIndex( parent.modelId() ), index, index+count-1 );
@@ -51,6 +51,8 @@ public:
 
 	Qt::ItemFlags flags( const QModelIndex& index ) const override;
 
+	QModelIndex indexOf( NetworkObject::Uid uid ) const;
+
 private:
 	void beginInsertObjects( const NetworkObject& parent, int index, int count );
 	void endInsertObjects();
@@ -0,0 +1,105 @@
+/*
+ * ScaledScreenCache.cpp - implementation of ScaledScreenCache
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "ScaledScreenCache.h"
+
+
+void ScaledScreenCache::setSize( QSize size )
+{
+	if( size != m_size )
+	{
+		m_size = size;
+		clear();
+	}
+}
+
+
+
+QImage ScaledScreenCache::scaledScreen( const ComputerControlInterface::Pointer& controlInterface )
+{
+	if( controlInterface.isNull() || m_size.isEmpty() )
+	{
+		return {};
+	}
+
+	if( controlInterface->state() != ComputerControlInterface::State::Connected ||
+		controlInterface->hasValidFramebuffer() == false )
+	{
+		remove( controlInterface );
+		return {};
+	}
+
+	const auto timestamp = controlInterface->timestamp();
+
+	auto it = m_entries.find( controlInterface.data() );
+	if( it != m_entries.end() &&
+		it->controlInterface == controlInterface &&
+		it->timestamp == timestamp )
+	{
+		return it->image;
+	}
+
+	const auto image = scale( controlInterface );
+	if( image.isNull() == false )
+	{
+		m_entries[controlInterface.data()] = { controlInterface, timestamp, image };
+	}
+
+	return image;
+}
+
+
+
+void ScaledScreenCache::remove( const ComputerControlInterface::Pointer& controlInterface )
+{
+	m_entries.remove( controlInterface.data() );
+}
+
+
+
+void ScaledScreenCache::clear()
+{
+	m_entries.clear();
+}
+
+
+
+QImage ScaledScreenCache::scale( const ComputerControlInterface::Pointer& controlInterface ) const
+{
+	const auto screen = controlInterface->screen();
+	if( screen.isNull() )
+	{
+		return {};
+	}
+
+	// reuse the image scaled by the connection if it already has the size we need
+	const auto scaledScreen = controlInterface->scaledScreen();
+	if( scaledScreen.isNull() == false &&
+		scaledScreen.size() == screen.size().scaled( m_size, Qt::KeepAspectRatio ) )
+	{
+		return scaledScreen;
+	}
+
+	return screen.scaled( m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+}
@@ -0,0 +1,59 @@
+/*
+ * ScaledScreenCache.h - header file for ScaledScreenCache
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QImage>
+
+#include "ComputerControlInterface.h"
+
+// caches screens scaled to a fixed size per computer and only rescales them
+// after the computer's framebuffer has been updated
+class ScaledScreenCache
+{
+public:
+	ScaledScreenCache() = default;
+
+	void setSize( QSize size );
+
+	QImage scaledScreen( const ComputerControlInterface::Pointer& controlInterface );
+
+	void remove( const ComputerControlInterface::Pointer& controlInterface );
+	void clear();
+
+private:
+	QImage scale( const ComputerControlInterface::Pointer& controlInterface ) const;
+
+	struct Entry
+	{
+		QWeakPointer<ComputerControlInterface> controlInterface;
+		int timestamp{0};
+		QImage image;
+	};
+
+	QSize m_size;
+	QHash<const ComputerControlInterface *, Entry> m_entries;
+
+};
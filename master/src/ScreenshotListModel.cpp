@@ -0,0 +1,146 @@
+/*
+ * ScreenshotListModel.cpp - lazily populated list model of indexed screenshots
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "ScreenshotListModel.h"
+
+
+ScreenshotListModel::ScreenshotListModel( const QString& directory, QObject* parent ) :
+	QAbstractListModel( parent ),
+	m_index( directory )
+{
+}
+
+
+
+void ScreenshotListModel::reload()
+{
+	if( m_index.update() == false )
+	{
+		return;
+	}
+
+	beginResetModel();
+
+	m_fileNames = m_index.entries().keys();
+
+	// keep previously fetched pages available
+	m_fetchedCount = qMin( qMax( m_fetchedCount, int(PageSize) ), m_fileNames.count() );
+
+	endResetModel();
+}
+
+
+
+QString ScreenshotListModel::fileName( const QModelIndex& index ) const
+{
+	if( index.isValid() == false || index.row() >= m_fetchedCount )
+	{
+		return {};
+	}
+
+	return m_fileNames.at( index.row() );
+}
+
+
+
+QModelIndex ScreenshotListModel::indexOf( const QString& fileName )
+{
+	const auto row = m_fileNames.indexOf( fileName );
+	if( row < 0 )
+	{
+		return {};
+	}
+
+	while( row >= m_fetchedCount )
+	{
+		fetchMore( {} );
+	}
+
+	return index( row );
+}
+
+
+
+int ScreenshotListModel::rowCount( const QModelIndex& parent ) const
+{
+	if( parent.isValid() )
+	{
+		return 0;
+	}
+
+	return m_fetchedCount;
+}
+
+
+
+QVariant ScreenshotListModel::data( const QModelIndex& index, int role ) const
+{
+	if( index.isValid() == false || index.row() >= m_fetchedCount )
+	{
+		return {};
+	}
+
+	const auto& fileName = m_fileNames.at( index.row() );
+
+	switch( role )
+	{
+	case Qt::DisplayRole:
+		return fileName;
+
+	case Qt::ToolTipRole:
+	{
+		const auto entry = m_index.entries().value( fileName );
+		return QStringLiteral( "%1@%2 %3 %4" ).arg( entry.user, entry.host, entry.date,
+													 QString( entry.time ).replace( QLatin1Char('-'), QLatin1Char(':') ) );
+	}
+
+	default:
+		break;
+	}
+
+	return {};
+}
+
+
+
+bool ScreenshotListModel::canFetchMore( const QModelIndex& parent ) const
+{
+	return parent.isValid() == false && m_fetchedCount < m_fileNames.count();
+}
+
+
+
+void ScreenshotListModel::fetchMore( const QModelIndex& parent )
+{
+	if( canFetchMore( parent ) == false )
+	{
+		return;
+	}
+
+	const auto count = qMin( int(PageSize), m_fileNames.count() - m_fetchedCount );
+
+	beginInsertRows( {}, m_fetchedCount, m_fetchedCount + count - 1 );
+	m_fetchedCount += count;
+	endInsertRows();
+}
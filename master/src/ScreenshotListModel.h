@@ -0,0 +1,55 @@
+/*
+ * ScreenshotListModel.h - lazily populated list model of indexed screenshots
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+
+#include "ScreenshotIndex.h"
+
+class ScreenshotListModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	explicit ScreenshotListModel( const QString& directory, QObject* parent = nullptr );
+
+	void reload();
+
+	QString fileName( const QModelIndex& index ) const;
+	QModelIndex indexOf( const QString& fileName );
+
+	int rowCount( const QModelIndex& parent = QModelIndex() ) const override;
+	QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const override;
+
+	bool canFetchMore( const QModelIndex& parent ) const override;
+	void fetchMore( const QModelIndex& parent ) override;
+
+private:
+	static constexpr int PageSize = 100;
+
+	ScreenshotIndex m_index;
+	QStringList m_fileNames{};
+	int m_fetchedCount{0};
+
+};
@@ -25,6 +25,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QtConcurrent>
 
 #include "Filesystem.h"
 #include "ScreenshotManagementPanel.h"
@@ -37,14 +38,16 @@
 
 ScreenshotManagementPanel::ScreenshotManagementPanel( QWidget *parent ) :
 	QWidget( parent ),
-	ui( new Ui::ScreenshotManagementPanel )
+	ui( new Ui::ScreenshotManagementPanel ),
+	m_model( VeyonCore::filesystem().screenshotDirectoryPath(), this )
 {
 	ui->setupUi( this );
 
 	VeyonCore::filesystem().ensurePathExists( VeyonCore::config().screenshotDirectory() );
 
 	m_fsWatcher.addPath( VeyonCore::config().screenshotDirectory() );
-	connect( &m_fsWatcher, &QFileSystemWatcher::directoryChanged, this, &ScreenshotManagementPanel::updateModel );
+	connect( &m_fsWatcher, &QFileSystemWatcher::directoryChanged,
+			 &m_reloadTimer, QOverload<>::of(&QTimer::start) );
 
 	m_reloadTimer.setInterval( FsModelResetDelay );
 	m_reloadTimer.setSingleShot( true );
@@ -53,8 +56,15 @@ ScreenshotManagementPanel::ScreenshotManagementPanel( QWidget *parent ) :
 	connect( &VeyonCore::filesystem(), &Filesystem::screenshotDirectoryModified,
 			 &m_reloadTimer, QOverload<>::of(&QTimer::start) );
 
+	// lay out and fetch items lazily in order to keep the panel responsive with thousands of screenshots
+	ui->list->setUniformItemSizes( true );
+	ui->list->setLayoutMode( QListView::Batched );
 	ui->list->setModel( &m_model );
 
+	connect( &m_previewWatcher, &QFutureWatcher<QImage>::finished, this, [this]() {
+		setPreview( Screenshot( m_previewFileName, m_previewWatcher.result() ) );
+	} );
+
 	connect( ui->list->selectionModel(), &QItemSelectionModel::currentRowChanged,
 			 this, &ScreenshotManagementPanel::updateScreenshot );
 	connect( ui->list, &QListView::activated, this, &ScreenshotManagementPanel::showScreenshot );
@@ -100,41 +110,50 @@ void ScreenshotManagementPanel::resizeEvent( QResizeEvent* event )
 
 void ScreenshotManagementPanel::updateModel()
 {
-	const auto currentFile = m_model.data( ui->list->currentIndex(), Qt::DisplayRole ).toString();
-
-	const QDir dir{ VeyonCore::filesystem().screenshotDirectoryPath() };
-	const auto files = dir.entryList( { QStringLiteral("*.png") },
-									  QDir::Filter::Files, QDir::SortFlag::Name );
+	const auto currentFile = m_model.fileName( ui->list->currentIndex() );
 
-	m_model.setStringList( files );
+	// only reads index records appended since the last update instead of scanning the directory
+	m_model.reload();
 
-	ui->list->setCurrentIndex( m_model.index( files.indexOf( currentFile ) ) );
+	ui->list->setCurrentIndex( m_model.indexOf( currentFile ) );
 }
 
 
 
 QString ScreenshotManagementPanel::filePath( const QModelIndex& index ) const
 {
-	return VeyonCore::filesystem().screenshotDirectoryPath() + QDir::separator() + m_model.data( index, Qt::DisplayRole ).toString();
+	return VeyonCore::filesystem().screenshotDirectoryPath() + QDir::separator() + m_model.fileName( index );
 }
 
 
 
 void ScreenshotManagementPanel::updateScreenshot( const QModelIndex& index )
 {
-	setPreview( Screenshot( filePath( index ) ) );
+	// load (or create) thumbnail in background - a previously started load is superseded
+	const auto fileName = filePath( index );
+	m_previewFileName = fileName;
+	m_previewWatcher.setFuture( QtConcurrent::run( [fileName]() { return Screenshot::loadThumbnail( fileName ); } ) );
 }
 
 
 
 void ScreenshotManagementPanel::screenshotDoubleClicked( const QModelIndex& index )
 {
-	auto screenshotWindow = new QLabel;
-	screenshotWindow->setPixmap( filePath( index ) );
-	screenshotWindow->setScaledContents( true );
-	screenshotWindow->setWindowTitle( QFileInfo( filePath( index ) ).fileName() );
-	screenshotWindow->setAttribute( Qt::WA_DeleteOnClose, true );
-	screenshotWindow->showNormal();
+	const auto fileName = filePath( index );
+
+	// decode full image in background
+	auto imageWatcher = new QFutureWatcher<QImage>( this );
+	connect( imageWatcher, &QFutureWatcher<QImage>::finished, this, [imageWatcher, fileName]() {
+		auto screenshotWindow = new QLabel;
+		screenshotWindow->setPixmap( QPixmap::fromImage( imageWatcher->result() ) );
+		screenshotWindow->setScaledContents( true );
+		screenshotWindow->setWindowTitle( QFileInfo( fileName ).fileName() );
+		screenshotWindow->setAttribute( Qt::WA_DeleteOnClose, true );
+		screenshotWindow->showNormal();
+
+		imageWatcher->deleteLater();
+	} );
+	imageWatcher->setFuture( QtConcurrent::run( [fileName]() { return QImage( fileName ); } ) );
 }
 
 
@@ -163,6 +182,8 @@ void ScreenshotManagementPanel::deleteScreenshot()
 	for( const auto& index : selection )
 	{
 		QFile::remove( filePath( index ) );
+		Screenshot::removeThumbnail( filePath( index ) );
+		ScreenshotIndex::removeScreenshot( filePath( index ) );
 	}
 
 	updateModel();
@@ -25,10 +25,13 @@
 #pragma once
 
 #include <QFileSystemWatcher>
-#include <QStringListModel>
+#include <QFutureWatcher>
+#include <QImage>
 #include <QTimer>
 #include <QWidget>
 
+#include "ScreenshotListModel.h"
+
 class QModelIndex;
 class Screenshot;
 
@@ -61,11 +64,14 @@ private:
 
 	Ui::ScreenshotManagementPanel* ui;
 
-	QStringListModel m_model{this};
+	ScreenshotListModel m_model;
 	QFileSystemWatcher m_fsWatcher{this};
 
 	QTimer m_reloadTimer{this};
 
+	QString m_previewFileName{};
+	QFutureWatcher<QImage> m_previewWatcher{this};
+
 	static constexpr auto FsModelResetDelay = 1000;
 
 } ;
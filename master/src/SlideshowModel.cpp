@@ -60,6 +60,7 @@ SlideshowModel::SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent
 void SlideshowModel::setIconSize( QSize size )
 {
 	m_iconSize = size;
+	m_scaledScreenCache.setSize( m_iconSize );
 
 	Q_EMIT dataChanged( index( 0, 0 ), index( rowCount() - 1, 0 ), { Qt::DisplayRole, Qt::DecorationRole } );
 }
@@ -81,13 +82,16 @@ QVariant SlideshowModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto screen = sourceModel()->data( sourceIndex, ComputerListModel::ScreenRole ).value<QImage>();
-		if( screen.isNull() )
+		const auto scaledScreen = m_scaledScreenCache.scaledScreen(
+			sourceModel()->data( sourceIndex, ComputerListModel::ControlInterfaceRole )
+				.value<ComputerControlInterface::Pointer>() );
+		if( scaledScreen.isNull() == false )
 		{
-			screen = sourceModel()->data( sourceIndex, Qt::DecorationRole ).value<QImage>();
+			return scaledScreen;
 		}
 
-		return screen.scaled( m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+		return sourceModel()->data( sourceIndex, Qt::DecorationRole ).value<QImage>()
+			.scaled( m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
@@ -198,5 +202,8 @@ void SlideshowModel::setCurrentRow( int row )
 		m_currentControlInterface.clear();
 	}
 
+	// only the current computer is shown so there's no need to keep other scaled screens
+	m_scaledScreenCache.clear();
+
 	invalidateFilter();
 }
@@ -28,6 +28,7 @@
 #include <QTimer>
 
 #include "ComputerControlInterface.h"
+#include "ScaledScreenCache.h"
 
 class SlideshowModel : public QSortFilterProxyModel
 {
@@ -51,6 +52,7 @@ private:
 	void setCurrentRow( int row );
 
 	QSize m_iconSize;
+	mutable ScaledScreenCache m_scaledScreenCache;
 
 	QTimer m_timer;
 
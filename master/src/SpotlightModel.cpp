@@ -36,6 +36,7 @@ SpotlightModel::SpotlightModel( QAbstractItemModel* sourceModel, QObject* parent
 void SpotlightModel::setIconSize( QSize size )
 {
 	m_iconSize = size;
+	m_scaledScreenCache.setSize( m_iconSize );
 
 	Q_EMIT dataChanged( index( 0, 0 ), index( rowCount() - 1, 0 ), { Qt::DisplayRole, Qt::DecorationRole } );
 }
@@ -72,6 +73,7 @@ void SpotlightModel::add( const ComputerControlInterface::Pointer& controlInterf
 void SpotlightModel::remove( const ComputerControlInterface::Pointer& controlInterface )
 {
 	m_controlInterfaces.removeAll( controlInterface );
+	m_scaledScreenCache.remove( controlInterface );
 
 	controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Monitoring );
 
@@ -90,13 +92,16 @@ QVariant SpotlightModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto screen = sourceModel()->data( sourceIndex, ComputerListModel::ScreenRole ).value<QImage>();
-		if( screen.isNull() )
+		const auto scaledScreen = m_scaledScreenCache.scaledScreen(
+			sourceModel()->data( sourceIndex, ComputerListModel::ControlInterfaceRole )
+				.value<ComputerControlInterface::Pointer>() );
+		if( scaledScreen.isNull() == false )
 		{
-			screen = sourceModel()->data( sourceIndex, Qt::DecorationRole ).value<QImage>();
+			return scaledScreen;
 		}
 
-		return screen.scaled( m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+		return sourceModel()->data( sourceIndex, Qt::DecorationRole ).value<QImage>()
+			.scaled( m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
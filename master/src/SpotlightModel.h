@@ -27,6 +27,7 @@
 #include <QSortFilterProxyModel>
 
 #include "ComputerControlListModel.h"
+#include "ScaledScreenCache.h"
 
 class SpotlightModel : public QSortFilterProxyModel
 {
@@ -49,6 +50,7 @@ protected:
 
 private:
 	QSize m_iconSize;
+	mutable ScaledScreenCache m_scaledScreenCache;
 	bool m_updateInRealtime;
 
 	ComputerControlInterfaceList m_controlInterfaces;
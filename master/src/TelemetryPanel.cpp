@@ -0,0 +1,216 @@
+/*
+ * TelemetryPanel.cpp - implementation of TelemetryPanel
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMessageBox>
+
+#include "ComputerControlListModel.h"
+#include "EnumHelper.h"
+#include "TelemetryPanel.h"
+#include "VeyonMaster.h"
+
+#include "ui_TelemetryPanel.h"
+
+
+TelemetryPanel::TelemetryPanel( VeyonMaster& master, QWidget* parent ) :
+	QWidget( parent ),
+	ui( new Ui::TelemetryPanel ),
+	m_master( master )
+{
+	ui->setupUi( this );
+
+	ui->tableWidget->setColumnCount( ColumnCount );
+	ui->tableWidget->setHorizontalHeaderLabels( {
+		tr("Computer"), tr("State"), tr("Reconnects"), tr("Updates"), tr("Updates/s"), tr("Rects"),
+		tr("Update time (ms)"), tr("Publish time (ms)"), tr("Events sent"), tr("Event queue (max)"),
+		tr("Encoding changes") } );
+
+	ui->enableCheckBox->setChecked( VncConnection::isTelemetryEnabled() );
+
+	connect( ui->enableCheckBox, &QCheckBox::toggled, this, &TelemetryPanel::updateTelemetryState );
+	connect( ui->exportButton, &QPushButton::clicked, this, &TelemetryPanel::exportJson );
+
+	m_refreshTimer.setInterval( RefreshInterval );
+	connect( &m_refreshTimer, &QTimer::timeout, this, &TelemetryPanel::refresh );
+
+	updateTelemetryState( ui->enableCheckBox->isChecked() );
+
+	m_server.start();
+}
+
+
+
+TelemetryPanel::~TelemetryPanel()
+{
+	delete ui;
+}
+
+
+
+QJsonObject TelemetryPanel::dump() const
+{
+	QJsonArray computers;
+	VncConnectionTelemetry total;
+
+	for( const auto& controlInterface : m_master.computerControlListModel().computerControlInterfaces() )
+	{
+		const auto telemetry = controlInterface->telemetry();
+		total += telemetry;
+
+		computers.append( QJsonObject{
+			{ QStringLiteral("name"), controlInterface->computer().name() },
+			{ QStringLiteral("host"), controlInterface->computer().hostAddress() },
+			{ QStringLiteral("state"), EnumHelper::toString( controlInterface->state() ) },
+			{ QStringLiteral("telemetry"), telemetry.toJson() }
+		} );
+	}
+
+	return {
+		{ QStringLiteral("computers"), computers },
+		{ QStringLiteral("total"), total.toJson() }
+	};
+}
+
+
+
+void TelemetryPanel::setTelemetryEnabled( bool enabled )
+{
+	// updates the telemetry state through the toggled() signal
+	ui->enableCheckBox->setChecked( enabled );
+}
+
+
+
+void TelemetryPanel::updateTelemetryState( bool enabled )
+{
+	VncConnection::setTelemetryEnabled( enabled );
+
+	if( enabled )
+	{
+		m_refreshTimer.start();
+		m_refreshElapsedTimer.restart();
+	}
+	else
+	{
+		m_refreshTimer.stop();
+	}
+
+	ui->exportButton->setEnabled( enabled );
+}
+
+
+
+void TelemetryPanel::refresh()
+{
+	if( isVisible() == false )
+	{
+		return;
+	}
+
+	const auto& controlInterfaces = m_master.computerControlListModel().computerControlInterfaces();
+
+	const auto elapsedSeconds = double( m_refreshElapsedTimer.restart() ) / 1000;
+
+	auto table = ui->tableWidget;
+	table->setRowCount( controlInterfaces.count() + 1 );
+
+	const auto setRow = [table]( int row, const QString& name, const QString& state,
+								 const VncConnectionTelemetry& telemetry, double updatesPerSecond ) {
+		const auto setCell = [table, row]( int column, const QString& text ) {
+			auto item = table->item( row, column );
+			if( item == nullptr )
+			{
+				item = new QTableWidgetItem;
+				table->setItem( row, column, item );
+			}
+			item->setText( text );
+		};
+
+		const auto updates = qMax<qint64>( 1, telemetry.framebufferUpdates );
+
+		setCell( ColumnComputer, name );
+		setCell( ColumnState, state );
+		setCell( ColumnReconnects, QString::number( telemetry.reconnects() ) );
+		setCell( ColumnUpdates, QString::number( telemetry.framebufferUpdates ) );
+		setCell( ColumnUpdatesPerSecond, QString::number( updatesPerSecond, 'f', 1 ) );
+		setCell( ColumnRects, QString::number( telemetry.rects ) );
+		setCell( ColumnAverageUpdateDuration, QString::number( double(telemetry.updateDuration) / updates / 1000000, 'f', 2 ) );
+		setCell( ColumnAveragePublishDuration, QString::number( double(telemetry.publishDuration) / updates / 1000000, 'f', 2 ) );
+		setCell( ColumnEventsSent, QString::number( telemetry.eventsSent ) );
+		setCell( ColumnEventQueueDepth, QStringLiteral("%1 (%2)").arg( telemetry.eventQueueDepth ).arg( telemetry.maximumEventQueueDepth ) );
+		setCell( ColumnEncodingLevelChanges, QString::number( telemetry.encodingLevelChanges ) );
+	};
+
+	const auto rate = [elapsedSeconds]( qint64 current, qint64 previous ) {
+		return elapsedSeconds > 0 ? double( qMax<qint64>( 0, current - previous ) ) / elapsedSeconds : 0.0;
+	};
+
+	QHash<const ComputerControlInterface *, qint64> updateCounts;
+	updateCounts.reserve( controlInterfaces.count() );
+
+	VncConnectionTelemetry total;
+	int row = 0;
+
+	for( const auto& controlInterface : controlInterfaces )
+	{
+		const auto telemetry = controlInterface->telemetry();
+		total += telemetry;
+
+		const auto previousUpdateCount = m_previousUpdateCounts.value( controlInterface.data(), telemetry.framebufferUpdates );
+		updateCounts[controlInterface.data()] = telemetry.framebufferUpdates;
+
+		setRow( row++, controlInterface->computer().name(), EnumHelper::toString( controlInterface->state() ),
+				telemetry, rate( telemetry.framebufferUpdates, previousUpdateCount ) );
+	}
+
+	setRow( row, tr("Total"), {}, total, rate( total.framebufferUpdates, m_previousTotalUpdateCount ) );
+
+	m_previousUpdateCounts = updateCounts;
+	m_previousTotalUpdateCount = total.framebufferUpdates;
+}
+
+
+
+void TelemetryPanel::exportJson()
+{
+	const auto fileName = QFileDialog::getSaveFileName( this, tr( "Select output filename" ),
+														QDir::homePath(), tr( "JSON files (*.json)" ) );
+	if( fileName.isEmpty() )
+	{
+		return;
+	}
+
+	QFile file( fileName );
+	if( file.open( QFile::WriteOnly | QFile::Truncate ) == false ||
+		file.write( QJsonDocument( dump() ).toJson() ) < 0 )
+	{
+		QMessageBox::critical( this, tr( "File error"),
+							   tr( "Could not write the telemetry data to %1! "
+								   "Please check the file access permissions." ).arg( fileName ) );
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * TelemetryPanel.h - declaration of TelemetryPanel
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QTimer>
+#include <QWidget>
+
+#include "TelemetryServer.h"
+
+class ComputerControlInterface;
+class VeyonMaster;
+
+namespace Ui {
+class TelemetryPanel;
+}
+
+class TelemetryPanel : public QWidget
+{
+	Q_OBJECT
+public:
+	explicit TelemetryPanel( VeyonMaster& master, QWidget* parent = nullptr );
+	~TelemetryPanel() override;
+
+	QJsonObject dump() const;
+
+	void setTelemetryEnabled( bool enabled );
+
+private:
+	enum Columns {
+		ColumnComputer,
+		ColumnState,
+		ColumnReconnects,
+		ColumnUpdates,
+		ColumnUpdatesPerSecond,
+		ColumnRects,
+		ColumnAverageUpdateDuration,
+		ColumnAveragePublishDuration,
+		ColumnEventsSent,
+		ColumnEventQueueDepth,
+		ColumnEncodingLevelChanges,
+		ColumnCount
+	};
+
+	void updateTelemetryState( bool enabled );
+	void refresh();
+	void exportJson();
+
+	static constexpr int RefreshInterval = 1000;
+
+	Ui::TelemetryPanel* ui;
+
+	VeyonMaster& m_master;
+
+	TelemetryServer m_server{*this};
+
+	QTimer m_refreshTimer{this};
+	QElapsedTimer m_refreshElapsedTimer{};
+	QHash<const ComputerControlInterface *, qint64> m_previousUpdateCounts{};
+	qint64 m_previousTotalUpdateCount{0};
+
+} ;
@@ -0,0 +1,107 @@
+/*
+ * TelemetryServer.cpp - implementation of TelemetryServer class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QJsonDocument>
+#include <QLocalSocket>
+
+#include "TelemetryPanel.h"
+#include "TelemetryServer.h"
+#include "VariantArrayMessage.h"
+#include "VncConnection.h"
+
+
+TelemetryServer::TelemetryServer( TelemetryPanel& panel, QObject* parent ) :
+	QObject( parent ),
+	m_panel( panel )
+{
+	m_server.setSocketOptions( QLocalServer::UserAccessOption );
+
+	connect( &m_server, &QLocalServer::newConnection, this, &TelemetryServer::acceptConnections );
+}
+
+
+
+void TelemetryServer::start()
+{
+	const auto serverName = VncConnectionTelemetry::ipcServerName();
+
+	if( m_server.listen( serverName ) )
+	{
+		return;
+	}
+
+	// remove stale socket of a crashed master unless another master of the same user is still serving it
+	QLocalSocket socket;
+	socket.connectToServer( serverName );
+	if( socket.waitForConnected( ConnectTimeout ) == false &&
+		QLocalServer::removeServer( serverName ) &&
+		m_server.listen( serverName ) )
+	{
+		return;
+	}
+
+	vWarning() << "can't listen" << m_server.errorString();
+}
+
+
+
+void TelemetryServer::acceptConnections()
+{
+	while( m_server.hasPendingConnections() )
+	{
+		auto socket = m_server.nextPendingConnection();
+
+		connect( socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater );
+		connect( socket, &QLocalSocket::readyRead, this, [this, socket]() { handleRequest( socket ); } );
+	}
+}
+
+
+
+void TelemetryServer::handleRequest( QLocalSocket* socket )
+{
+	VariantArrayMessage request( socket );
+
+	if( request.isReadyForReceive() == false || request.receive() == false )
+	{
+		return;
+	}
+
+	switch( static_cast<VncConnectionTelemetry::IpcCommand>( request.read().toInt() ) )
+	{
+	case VncConnectionTelemetry::IpcCommand::Enable:
+		m_panel.setTelemetryEnabled( true );
+		break;
+	case VncConnectionTelemetry::IpcCommand::Disable:
+		m_panel.setTelemetryEnabled( false );
+		break;
+	default:
+		break;
+	}
+
+	VariantArrayMessage response( socket );
+	response.write( VncConnection::isTelemetryEnabled() );
+	response.write( QJsonDocument( m_panel.dump() ).toJson() );
+	response.send();
+}
@@ -0,0 +1,51 @@
+/*
+ * TelemetryServer.h - declaration of TelemetryServer class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QLocalServer>
+
+class QLocalSocket;
+class TelemetryPanel;
+
+// local server which allows veyon-cli to dump and control the VNC connection telemetry of a running master
+class TelemetryServer : public QObject
+{
+	Q_OBJECT
+public:
+	explicit TelemetryServer( TelemetryPanel& panel, QObject* parent = nullptr );
+	~TelemetryServer() override = default;
+
+	void start();
+
+private:
+	static constexpr int ConnectTimeout = 1000;
+
+	void acceptConnections();
+	void handleRequest( QLocalSocket* socket );
+
+	TelemetryPanel& m_panel;
+	QLocalServer m_server{this};
+
+} ;
@@ -42,9 +42,14 @@ void BuiltinDirectory::update()
 	m_configuration.reloadFromStore();
 
 	const auto networkObjects = m_configuration.networkObjects();
+	if( networkObjects == m_networkObjects )
+	{
+		return;
+	}
 
-	NetworkObjectUidList groupUids;
-	NetworkObject rootObject{ NetworkObject::Type::Root };
+	// group all objects by their parent in a single pass
+	NetworkObjectList locationObjects;
+	QHash<NetworkObject::Uid, NetworkObjectList> childObjects;
 
 	for( const auto& networkObjectValue : networkObjects )
 	{
@@ -52,35 +57,20 @@ void BuiltinDirectory::update()
 
 		if( networkObject.type() == NetworkObject::Type::Location )
 		{
-			groupUids.append( networkObject.uid() ); // clazy:exclude=reserve-candidates
-
-			addOrUpdateObject( networkObject, rootObject );
-
-			updateLocation( networkObject, networkObjects );
+			locationObjects.append( networkObject ); // clazy:exclude=reserve-candidates
+		}
+		else
+		{
+			childObjects[networkObject.parentUid()].append( networkObject );
 		}
 	}
 
-	removeObjects( rootObject, [groupUids]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Location && groupUids.contains( object.uid() ) == false; } );
-}
-
+	replaceObjects( locationObjects, NetworkObject( NetworkObject::Type::Root ) );
 
-
-void BuiltinDirectory::updateLocation( const NetworkObject& locationObject, const QJsonArray& networkObjects )
-{
-	NetworkObjectUidList computerUids;
-
-	for( const auto& networkObjectValue : networkObjects )
+	for( const auto& locationObject : qAsConst(locationObjects) )
 	{
-		NetworkObject networkObject( networkObjectValue.toObject() );
-
-		if( networkObject.parentUid() == locationObject.uid() )
-		{
-			computerUids.append( networkObject.uid() ); // clazy:exclude=reserve-candidates
-			addOrUpdateObject( networkObject, locationObject );
-		}
+		replaceObjects( childObjects.value( locationObject.uid() ), locationObject );
 	}
 
-	removeObjects( locationObject, [computerUids]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Host && computerUids.contains( object.uid() ) == false; } );
+	m_networkObjects = networkObjects;
 }
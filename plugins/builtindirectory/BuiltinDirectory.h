@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QJsonArray>
+
 #include "NetworkObjectDirectory.h"
 
 class BuiltinDirectoryConfiguration;
@@ -37,8 +39,7 @@ public:
 	void update() override;
 
 private:
-	void updateLocation( const NetworkObject& locationObject, const QJsonArray& networkObjects );
-
 	BuiltinDirectoryConfiguration& m_configuration;
+	QJsonArray m_networkObjects;
 
 };
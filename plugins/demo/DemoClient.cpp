@@ -23,19 +23,28 @@
  */
 
 #include <QApplication>
+#include <QHostAddress>
 #include <QDesktopWidget>
 #include <QIcon>
 #include <QLayout>
 
 #include "DemoClient.h"
+#include "DemoConfiguration.h"
+#include "DemoMulticastClient.h"
+#include "DemoMulticastProtocol.h"
 #include "VeyonConfiguration.h"
 #include "LockWidget.h"
 #include "PlatformCoreFunctions.h"
 #include "VncViewWidget.h"
 
 
-DemoClient::DemoClient( const QString& host, int port, bool fullscreen, const QRect& viewport, QObject* parent ) :
+DemoClient::DemoClient( const QString& host, int port, bool fullscreen, const QRect& viewport,
+						const DemoAuthentication& authentication, const DemoConfiguration& configuration,
+						QObject* parent ) :
 	QObject( parent ),
+	m_host( host ),
+	m_port( port ),
+	m_viewport( viewport ),
 	m_toplevel( nullptr )
 {
 	if( fullscreen )
@@ -57,17 +66,28 @@ DemoClient::DemoClient( const QString& host, int port, bool fullscreen, const QR
 		m_toplevel->resize( QApplication::desktop()->availableGeometry( m_toplevel ).size() - QSize( 10, 30 ) );
 	}
 
-	m_vncView = new VncViewWidget( host, port, m_toplevel, VncView::DemoMode, viewport );
-
 	auto toplevelLayout = new QVBoxLayout;
 	toplevelLayout->setContentsMargins( 0, 0, 0, 0 );
 	toplevelLayout->setSpacing( 0 );
-	toplevelLayout->addWidget( m_vncView );
 
 	m_toplevel->setLayout( toplevelLayout );
 
 	connect( m_toplevel, &QObject::destroyed, this, &DemoClient::viewDestroyed );
-	connect( m_vncView, &VncViewWidget::sizeHintChanged, this, &DemoClient::resizeToplevelWidget );
+
+	if( configuration.isMulticastEnabled() )
+	{
+		// the view is created as soon as the multicast client received the
+		// initial key frame or the multicast transport turned out to be unavailable
+		m_multicastClient = new DemoMulticastClient( host, DemoMulticastProtocol::port( configuration, port ),
+													 authentication, configuration, this );
+		connect( m_multicastClient, &DemoMulticastClient::ready, this, &DemoClient::startMulticastView );
+		connect( m_multicastClient, &DemoMulticastClient::failed, this, &DemoClient::startDirectView );
+		m_multicastClient->start();
+	}
+	else
+	{
+		startDirectView();
+	}
 
 	m_toplevel->move( 0, 0 );
 	if( fullscreen )
@@ -91,6 +111,45 @@ DemoClient::~DemoClient()
 	VeyonCore::platform().coreFunctions().restoreScreenSaverSettings();
 
 	delete m_toplevel;
+
+	// make sure the local relay connection is stopped only after the view is gone
+	delete m_multicastClient;
+}
+
+
+
+void DemoClient::createView( const QString& host, int port )
+{
+	if( m_toplevel == nullptr || m_vncView )
+	{
+		return;
+	}
+
+	m_vncView = new VncViewWidget( host, port, m_toplevel, VncView::DemoMode, m_viewport );
+
+	m_toplevel->layout()->addWidget( m_vncView );
+
+	connect( m_vncView, &VncViewWidget::sizeHintChanged, this, &DemoClient::resizeToplevelWidget );
+}
+
+
+
+void DemoClient::startMulticastView()
+{
+	createView( QHostAddress( QHostAddress::LocalHost ).toString(), m_multicastClient->serverPort() );
+}
+
+
+
+void DemoClient::startDirectView()
+{
+	if( m_multicastClient )
+	{
+		m_multicastClient->deleteLater();
+		m_multicastClient = nullptr;
+	}
+
+	createView( m_host, m_port );
 }
 
 
@@ -110,6 +169,11 @@ void DemoClient::viewDestroyed( QObject* obj )
 
 void DemoClient::resizeToplevelWidget()
 {
+	if( m_vncView == nullptr )
+	{
+		return;
+	}
+
 	if( m_toplevel->windowState() & Qt::WindowFullScreen )
 	{
 		m_vncView->resize( m_toplevel->size() );
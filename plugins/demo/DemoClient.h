@@ -26,20 +26,34 @@
 
 #include <QObject>
 
+class DemoAuthentication;
+class DemoConfiguration;
+class DemoMulticastClient;
 class VncViewWidget;
 
 class DemoClient : public QObject
 {
 	Q_OBJECT
 public:
-	DemoClient( const QString& host, int port, bool fullscreen, const QRect& viewport, QObject* parent = nullptr );
+	DemoClient( const QString& host, int port, bool fullscreen, const QRect& viewport,
+				const DemoAuthentication& authentication, const DemoConfiguration& configuration,
+				QObject* parent = nullptr );
 	~DemoClient() override;
 
 private:
+	void createView( const QString& host, int port );
+	void startMulticastView();
+	void startDirectView();
+
 	void viewDestroyed( QObject* obj );
 	void resizeToplevelWidget();
 
+	const QString m_host;
+	const int m_port;
+	const QRect m_viewport;
+
 	QWidget* m_toplevel;
-	VncViewWidget* m_vncView;
+	VncViewWidget* m_vncView{nullptr};
+	DemoMulticastClient* m_multicastClient{nullptr};
 
 } ;
@@ -32,6 +32,13 @@
 	OP( DemoConfiguration, m_configuration, int, framebufferUpdateInterval, setFramebufferUpdateInterval, "FramebufferUpdateInterval", "Demo", 100, Configuration::Property::Flag::Advanced )	\
 	OP( DemoConfiguration, m_configuration, int, keyFrameInterval, setKeyFrameInterval, "KeyFrameInterval", "Demo", 10, Configuration::Property::Flag::Advanced )	\
 	OP( DemoConfiguration, m_configuration, int, memoryLimit, setMemoryLimit, "MemoryLimit", "Demo", 128, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, bool, isMulticastEnabled, setMulticastEnabled, "MulticastEnabled", "Demo", false, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, QString, multicastGroup, setMulticastGroup, "MulticastGroup", "Demo", QStringLiteral("239.255.86.1"), Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, int, multicastPort, setMulticastPort, "MulticastPort", "Demo", 11450, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, int, multicastTimeToLive, setMulticastTimeToLive, "MulticastTimeToLive", "Demo", 1, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, int, multicastSendRate, setMulticastSendRate, "MulticastSendRate", "Demo", 100, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, bool, isRelayTreeEnabled, setRelayTreeEnabled, "RelayTreeEnabled", "Demo", false, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, int, relayFanOut, setRelayFanOut, "RelayFanOut", "Demo", 4, Configuration::Property::Flag::Advanced )	\
 
 // clazy:excludeall=missing-qobject-macro
 
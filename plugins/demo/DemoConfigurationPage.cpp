@@ -22,9 +22,12 @@
  *
  */
 
+#include <QMessageBox>
+
 #include "DemoConfiguration.h"
 #include "DemoConfigurationPage.h"
 #include "Configuration/UiMapping.h"
+#include "PlatformNetworkFunctions.h"
 
 #include "ui_DemoConfigurationPage.h"
 
@@ -63,4 +66,21 @@ void DemoConfigurationPage::connectWidgetsToProperties()
 
 void DemoConfigurationPage::applyConfiguration()
 {
+	// the multicast datagrams (UDP) and the side channel (TCP) use a session specific port each
+	const auto firstPort = m_configuration.multicastPort();
+	const auto lastPort = firstPort + qMax( 1, VeyonCore::config().maximumSessionCount() ) - 1;
+	const auto enabled = m_configuration.isMulticastEnabled() && VeyonCore::config().isFirewallExceptionEnabled();
+
+	auto& network = VeyonCore::platform().networkFunctions();
+
+	if( network.configureFirewallPortException( QStringLiteral("Veyon Demo Multicast"),
+												PlatformNetworkFunctions::Protocol::UDP,
+												firstPort, lastPort, enabled ) == false ||
+		network.configureFirewallPortException( QStringLiteral("Veyon Demo Multicast Side Channel"),
+												PlatformNetworkFunctions::Protocol::TCP,
+												firstPort, lastPort, enabled ) == false )
+	{
+		QMessageBox::critical( this, tr( "Demo" ),
+							   tr( "Could not configure the firewall exception for the multicast transport." ) );
+	}
 }
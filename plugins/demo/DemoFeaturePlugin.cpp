@@ -22,6 +22,7 @@
  *
  */
 
+#include <QEventLoop>
 #include <QMessageBox>
 #include <QScreen>
 
@@ -104,7 +105,10 @@ DemoFeaturePlugin::DemoFeaturePlugin( QObject* parent ) :
 		m_shareOwnScreenFullScreenFeature, m_shareOwnScreenWindowFeature,
 		m_shareUserScreenFullScreenFeature, m_shareUserScreenWindowFeature
 	} ),
-	m_configuration( &VeyonCore::config() )
+	m_configuration( &VeyonCore::config() ),
+	m_commands( {
+{ QStringLiteral("relaytest"), tr( "Run a chain of relaying demo servers locally and print their statistics" ) },
+				} )
 {
 	connect( qGuiApp, &QGuiApplication::screenAdded, this, &DemoFeaturePlugin::addScreen );
 	connect( qGuiApp, &QGuiApplication::screenRemoved, this, &DemoFeaturePlugin::removeScreen );
@@ -144,9 +148,9 @@ bool DemoFeaturePlugin::startFeature( VeyonMasterInterface& master, const Featur
 						{ master.localSessionControlInterface().weakPointer() } );
 
 		// start demo clients
-		controlFeature( feature == m_shareOwnScreenFullScreenFeature ? m_demoClientFullScreenFeature.uid()
-																	 : m_demoClientWindowFeature.uid(),
-						Operation::Start, {}, computerControlInterfaces );
+		startDemoClients( feature == m_shareOwnScreenFullScreenFeature ? m_demoClientFullScreenFeature.uid()
+																	   : m_demoClientWindowFeature.uid(),
+						  {}, computerControlInterfaces );
 
 		return true;
 	}
@@ -198,9 +202,9 @@ bool DemoFeaturePlugin::startFeature( VeyonMasterInterface& master, const Featur
 			{ argToString(Argument::DemoServerPort), demoServerPort },
 		};
 
-		controlFeature( feature == m_shareUserScreenFullScreenFeature ? m_demoClientFullScreenFeature.uid()
-																	  : m_demoClientWindowFeature.uid(),
-						Operation::Start, demoClientArgs, userDemoControlInterfaces );
+		startDemoClients( feature == m_shareUserScreenFullScreenFeature ? m_demoClientFullScreenFeature.uid()
+																		: m_demoClientWindowFeature.uid(),
+						  demoClientArgs, userDemoControlInterfaces );
 
 		controlFeature( m_demoClientWindowFeature.uid(), Operation::Start, demoClientArgs,
 						{ master.localSessionControlInterface().weakPointer() } );
@@ -263,10 +267,20 @@ bool DemoFeaturePlugin::handleFeatureMessage( VeyonServerInterface& server,
 		if( message.command() == StartDemoServer )
 		{
 			// add VNC server password to message
-			server.featureWorkerManager().
-				sendMessageToManagedSystemWorker(
-					FeatureMessage{ message }
-						.addArgument( Argument::VncServerPassword, VeyonCore::authenticationCredentials().internalVncServerPassword().toByteArray() ) );
+			auto startMessage = FeatureMessage{ message }
+				.addArgument( Argument::VncServerPassword, VeyonCore::authenticationCredentials().internalVncServerPassword().toByteArray() );
+
+			m_relayDemoServer = message.argument( Argument::UpstreamDemoServerPort ).toInt() > 0;
+
+			// relay for the demo server on the master computer? then use peer address as upstream host
+			auto socket = qobject_cast<QTcpSocket *>( messageContext.ioDevice() );
+			if( m_relayDemoServer && socket &&
+				message.argument( Argument::UpstreamDemoServerHost ).toString().isEmpty() )
+			{
+				startMessage.addArgument( Argument::UpstreamDemoServerHost, socket->peerAddress().toString() );
+			}
+
+			server.featureWorkerManager().sendMessageToManagedSystemWorker( startMessage );
 		}
 		else if( message.command() != StopDemoServer ||
 				 server.featureWorkerManager().isWorkerRunning( m_demoServerFeature.uid() ) )
@@ -283,9 +297,10 @@ bool DemoFeaturePlugin::handleFeatureMessage( VeyonServerInterface& server,
 	{
 		// if a demo server is started, it's likely that the demo accidentally was
 		// started on master computer as well therefore we deny starting a demo on
-		// hosts on which a demo server is running - exception: debug mode
+		// hosts on which a demo server is running - exceptions: relaying demo servers and debug mode
 		if( message.featureUid() == m_demoClientFullScreenFeature.uid() &&
 			server.featureWorkerManager().isWorkerRunning( m_demoServerFeature.uid() ) &&
+			m_relayDemoServer == false &&
 			VeyonCore::config().logLevel() < Logger::LogLevel::Debug )
 		{
 			return false;
@@ -339,12 +354,27 @@ bool DemoFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worker, cons
 			{
 				setAccessToken( message.argument( Argument::DemoAccessToken ).toByteArray() );
 
-				m_demoServer = new DemoServer( message.argument( Argument::VncServerPort ).toInt(),
-											   message.argument( Argument::VncServerPassword ).toByteArray(),
-											   *this,
-											   m_configuration,
-											   message.argument( Argument::DemoServerPort ).toInt(),
-											   this );
+				const auto upstreamDemoServerPort = message.argument( Argument::UpstreamDemoServerPort ).toInt();
+				if( upstreamDemoServerPort > 0 )
+				{
+					m_demoServer = new DemoServer( message.argument( Argument::UpstreamDemoServerHost ).toString(),
+												   upstreamDemoServerPort,
+												   {},
+												   *this,
+												   m_configuration,
+												   message.argument( Argument::DemoServerPort ).toInt(),
+												   this );
+				}
+				else
+				{
+					m_demoServer = new DemoServer( {},
+												   message.argument( Argument::VncServerPort ).toInt(),
+												   message.argument( Argument::VncServerPassword ).toByteArray(),
+												   *this,
+												   m_configuration,
+												   message.argument( Argument::DemoServerPort ).toInt(),
+												   this );
+				}
 			}
 			return true;
 
@@ -376,7 +406,8 @@ bool DemoFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worker, cons
 				const auto viewport = message.argument( Argument::Viewport ).toRect();
 
 				vDebug() << "connecting with master" << demoServerHost;
-				m_demoClient = new DemoClient( demoServerHost, demoServerPort, isFullscreenDemo, viewport );
+				m_demoClient = new DemoClient( demoServerHost, demoServerPort, isFullscreenDemo, viewport,
+											   *this, m_configuration );
 			}
 			return true;
 
@@ -405,6 +436,95 @@ ConfigurationPage* DemoFeaturePlugin::createConfigurationPage()
 
 
 
+QStringList DemoFeaturePlugin::commands() const
+{
+	return m_commands.keys();
+}
+
+
+
+QString DemoFeaturePlugin::commandHelp( const QString& command ) const
+{
+	return m_commands.value( command );
+}
+
+
+
+CommandLinePluginInterface::RunResult DemoFeaturePlugin::handle_relaytest( const QStringList& arguments )
+{
+	if( arguments.count() < 2 )
+	{
+		printUsage( commandLineModuleName(), QStringLiteral("relaytest"),
+					{ { QStringLiteral("VNC-PORT"), {} }, { QStringLiteral("VNC-PASSWORD"), {} } },
+					{ { QStringLiteral("RELAYS"), {} }, { QStringLiteral("DURATION"), {} } } );
+		return NotEnoughArguments;
+	}
+
+	const auto vncServerPort = arguments[0].toInt();
+	const auto relayCount = qMax( 1, arguments.value( 2, QStringLiteral("3") ).toInt() );
+	const auto duration = qMax( 1, arguments.value( 3, QStringLiteral("10") ).toInt() );
+	const auto basePort = VeyonCore::config().demoServerPort() + VeyonCore::sessionId();
+	const auto localHost = QHostAddress( QHostAddress::LocalHost ).toString();
+
+	initializeCredentials();
+
+	// the first server reads from the VNC server while each further server relays its predecessor
+	QVector<DemoServer *> servers{
+		new DemoServer( {}, vncServerPort, arguments[1].toUtf8(), *this, m_configuration, basePort, this )
+	};
+
+	for( int i = 1; i <= relayCount; ++i )
+	{
+		servers.append( new DemoServer( localHost, basePort + i - 1, {}, *this, m_configuration, basePort + i, this ) );
+	}
+
+	QEventLoop eventLoop;
+	QTimer::singleShot( duration * 1000, &eventLoop, &QEventLoop::quit );
+	eventLoop.exec();
+
+	TableRows tableRows;
+	tableRows.reserve( servers.size() );
+
+	for( int i = 0; i < servers.size(); ++i )
+	{
+		auto server = servers[i];
+
+		server->lockDataForRead();
+
+		qint64 size = 0;
+		const auto& messages = server->framebufferUpdateMessages();
+		for( const auto& message : messages )
+		{
+			size += message.size();
+		}
+
+		tableRows.append( { i == 0 ? tr( "Source" ) : tr( "Relay %1" ).arg( i ),
+							QString::number( basePort + i ),
+							QString::number( server->keyFrame() ),
+							QString::number( messages.count() ),
+							QString::number( size ) } );
+
+		server->unlockData();
+	}
+
+	printTable( Table( { tr("SERVER"), tr("PORT"), tr("KEY FRAME"), tr("MESSAGES"), tr("BYTES") }, tableRows ) );
+
+	qDeleteAll( servers );
+
+	// a relay which did not receive any data at all indicates a broken chain
+	for( const auto& row : qAsConst(tableRows) )
+	{
+		if( row.value( 3 ).toInt() == 0 )
+		{
+			return Failed;
+		}
+	}
+
+	return Successful;
+}
+
+
+
 void DemoFeaturePlugin::addScreen( QScreen* screen )
 {
 	m_screens = QGuiApplication::screens();
@@ -527,11 +647,20 @@ bool DemoFeaturePlugin::controlDemoServer( Operation operation, const QVariantMa
 		const auto demoAccessToken = arguments.value( argToString(Argument::DemoAccessToken),
 													  accessToken().toByteArray() ).toByteArray();
 
-		sendFeatureMessage( FeatureMessage{ m_demoServerFeature.uid(), StartDemoServer }
-								.addArgument( Argument::DemoAccessToken, demoAccessToken )
-								.addArgument( Argument::VncServerPort, vncServerPort )
-								.addArgument( Argument::DemoServerPort, demoServerPort ),
-							computerControlInterfaces );
+		FeatureMessage message{ m_demoServerFeature.uid(), StartDemoServer };
+		message.addArgument( Argument::DemoAccessToken, demoAccessToken )
+			.addArgument( Argument::VncServerPort, vncServerPort )
+			.addArgument( Argument::DemoServerPort, demoServerPort );
+
+		const auto upstreamDemoServerPort = arguments.value( argToString(Argument::UpstreamDemoServerPort) ).toInt();
+		if( upstreamDemoServerPort > 0 )
+		{
+			message.addArgument( Argument::UpstreamDemoServerHost,
+								 arguments.value( argToString(Argument::UpstreamDemoServerHost) ).toString() )
+				.addArgument( Argument::UpstreamDemoServerPort, upstreamDemoServerPort );
+		}
+
+		sendFeatureMessage( message, computerControlInterfaces );
 
 		return true;
 	}
@@ -615,4 +744,74 @@ bool DemoFeaturePlugin::controlDemoClient( Feature::Uid featureUid, Operation op
 }
 
 
+
+void DemoFeaturePlugin::startDemoClients( Feature::Uid featureUid, const QVariantMap& arguments,
+										 const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	const auto fanOut = m_configuration.relayFanOut();
+
+	if( m_configuration.isRelayTreeEnabled() == false || fanOut < 1 ||
+		computerControlInterfaces.size() <= fanOut )
+	{
+		controlFeature( featureUid, Operation::Start, arguments, computerControlInterfaces );
+		return;
+	}
+
+	// organize clients in a complete tree in breadth-first order where each node serves
+	// at most fanOut further clients through a relaying demo server, i.e. the parent of
+	// client n is client n / fanOut - 1 with -1 referring to the actual demo server
+	const auto count = computerControlInterfaces.size();
+
+	for( int index = 0; index < count; ++index )
+	{
+		const auto& computerControlInterface = computerControlInterfaces[index];
+		const auto parentIndex = index / fanOut - 1;
+
+		auto clientArgs = arguments;
+		if( parentIndex >= 0 )
+		{
+			const auto& parent = computerControlInterfaces[parentIndex];
+			clientArgs[argToString(Argument::DemoServerHost)] = HostAddress::parseHost( parent->computer().hostAddress() );
+			clientArgs[argToString(Argument::DemoServerPort)] = demoServerPort( parent );
+		}
+
+		// any children? then start a relaying demo server and connect local demo client to it
+		if( ( index + 1 ) * fanOut < count )
+		{
+			const auto relayPort = demoServerPort( computerControlInterface );
+
+			controlFeature( m_demoServerFeature.uid(), Operation::Start,
+							{
+								{ argToString(Argument::DemoServerPort), relayPort },
+								{ argToString(Argument::UpstreamDemoServerHost), clientArgs.value( argToString(Argument::DemoServerHost) ) },
+								{ argToString(Argument::UpstreamDemoServerPort),
+								  clientArgs.value( argToString(Argument::DemoServerPort),
+													VeyonCore::config().demoServerPort() + VeyonCore::sessionId() ) },
+							},
+							{ computerControlInterface } );
+
+			clientArgs[argToString(Argument::DemoServerHost)] = QHostAddress( QHostAddress::LocalHost ).toString();
+			clientArgs[argToString(Argument::DemoServerPort)] = relayPort;
+		}
+
+		controlFeature( featureUid, Operation::Start, clientArgs, { computerControlInterface } );
+	}
+}
+
+
+
+int DemoFeaturePlugin::demoServerPort( const ComputerControlInterface::Pointer& computerControlInterface )
+{
+	auto port = VeyonCore::config().demoServerPort();
+
+	const auto primaryServerPort = HostAddress::parsePortNumber( computerControlInterface->computer().hostAddress() );
+	if( primaryServerPort > 0 )
+	{
+		port += primaryServerPort - VeyonCore::config().veyonServerPort();
+	}
+
+	return port;
+}
+
+
 IMPLEMENT_CONFIG_PROXY(DemoConfiguration)
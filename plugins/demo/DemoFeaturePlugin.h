@@ -27,6 +27,8 @@
 #include <QGuiApplication>
 
 #include "AuthenticationPluginInterface.h"
+#include "CommandLineIO.h"
+#include "CommandLinePluginInterface.h"
 #include "ConfigurationPagePluginInterface.h"
 #include "DemoAuthentication.h"
 #include "DemoConfiguration.h"
@@ -37,13 +39,15 @@ class QScreen;
 class DemoServer;
 class DemoClient;
 
-class DemoFeaturePlugin : public QObject, FeatureProviderInterface, PluginInterface, ConfigurationPagePluginInterface, DemoAuthentication
+class DemoFeaturePlugin : public QObject, FeatureProviderInterface, PluginInterface, ConfigurationPagePluginInterface,
+		CommandLinePluginInterface, DemoAuthentication, CommandLineIO
 {
 	Q_OBJECT
 	Q_PLUGIN_METADATA(IID "io.veyon.Veyon.Plugins.Demo")
 	Q_INTERFACES(PluginInterface
 				 FeatureProviderInterface
 				 ConfigurationPagePluginInterface
+				 CommandLinePluginInterface
 				 AuthenticationPluginInterface)
 public:
 	enum class Argument {
@@ -56,7 +60,9 @@ public:
 		ViewportX,
 		ViewportY,
 		ViewportWidth,
-		ViewportHeight
+		ViewportHeight,
+		UpstreamDemoServerHost,
+		UpstreamDemoServerPort
 	};
 	Q_ENUM(Argument)
 
@@ -115,6 +121,22 @@ public:
 
 	ConfigurationPage* createConfigurationPage() override;
 
+	QString commandLineModuleName() const override
+	{
+		return QStringLiteral( "demo" );
+	}
+
+	QString commandLineModuleHelp() const override
+	{
+		return description();
+	}
+
+	QStringList commands() const override;
+	QString commandHelp( const QString& command ) const override;
+
+private Q_SLOTS:
+	CommandLinePluginInterface::RunResult handle_relaytest( const QStringList& arguments );
+
 private:
 	static constexpr auto ScreenSelectionNone = 0;
 
@@ -130,6 +152,11 @@ private:
 	bool controlDemoClient( Feature::Uid featureUid, Operation operation, const QVariantMap& arguments,
 						   const ComputerControlInterfaceList& computerControlInterfaces );
 
+	void startDemoClients( Feature::Uid featureUid, const QVariantMap& arguments,
+						   const ComputerControlInterfaceList& computerControlInterfaces );
+
+	static int demoServerPort( const ComputerControlInterface::Pointer& computerControlInterface );
+
 	enum Commands {
 		StartDemoServer,
 		StopDemoServer,
@@ -156,7 +183,10 @@ private:
 
 	QStringList m_demoClientHosts{};
 
+	QMap<QString, QString> m_commands;
+
 	DemoServer* m_demoServer{nullptr};
+	bool m_relayDemoServer{false};
 	DemoClient* m_demoClient{nullptr};
 
 };
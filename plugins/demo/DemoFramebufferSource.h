@@ -0,0 +1,56 @@
+/*
+ * DemoFramebufferSource.h - interface for providers of demo framebuffer updates
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+class DemoConfiguration;
+
+// interface used by DemoServerConnection for reading the server init message and
+// the framebuffer update messages of the current key frame - implemented by the demo
+// server itself and by the multicast client which relays multicast updates locally
+class DemoFramebufferSource
+{
+public:
+	using MessageList = QVector<QByteArray>;
+
+	virtual ~DemoFramebufferSource() = default;
+
+	virtual const DemoConfiguration& configuration() const = 0;
+
+	virtual const QByteArray& serverInitMessage() const = 0;
+
+	virtual void lockDataForRead() = 0;
+	virtual void unlockData() = 0;
+
+	virtual int keyFrame() const = 0;
+	virtual const MessageList& framebufferUpdateMessages() const = 0;
+
+	// called by connection threads when a client requests a non-incremental update
+	// which should be answered by a fresh key frame soon
+	virtual void requestFullFramebufferUpdate() = 0;
+
+} ;
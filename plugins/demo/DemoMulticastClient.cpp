@@ -0,0 +1,482 @@
+/*
+ * DemoMulticastClient.cpp - implementation of DemoMulticastClient class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "DemoAuthentication.h"
+#include "DemoConfiguration.h"
+#include "DemoMulticastClient.h"
+#include "DemoServerConnection.h"
+#include "VariantArrayMessage.h"
+
+
+DemoMulticastClient::DemoMulticastClient( const QString& host, int port, const DemoAuthentication& authentication,
+										  const DemoConfiguration& configuration, QObject* parent ) :
+	QTcpServer( parent ),
+	m_authentication( authentication ),
+	m_configuration( configuration ),
+	m_host( host ),
+	m_port( static_cast<quint16>( port ) )
+{
+	connect( &m_serverSocket, &QTcpSocket::connected, this, [this]() { m_authentication.authenticate( &m_serverSocket ); } );
+	connect( &m_serverSocket, &QTcpSocket::readyRead, this, &DemoMulticastClient::readFromServer );
+	connect( &m_serverSocket, &QTcpSocket::disconnected, this, &DemoMulticastClient::handleServerDisconnect );
+
+	connect( &m_udpSocket, &QUdpSocket::readyRead, this, &DemoMulticastClient::readDatagrams );
+
+	m_connectTimer.setSingleShot( true );
+	connect( &m_connectTimer, &QTimer::timeout, this, &DemoMulticastClient::fail );
+
+	connect( &m_repairTimer, &QTimer::timeout, this, &DemoMulticastClient::repair );
+}
+
+
+
+DemoMulticastClient::~DemoMulticastClient()
+{
+	m_serverSocket.disconnect( this );
+
+	for( const auto& connection : qAsConst(m_connections) )
+	{
+		if( connection )
+		{
+			connection->quit();
+			connection->wait( ConnectionThreadWaitTime );
+		}
+	}
+}
+
+
+
+void DemoMulticastClient::start()
+{
+	const QHostAddress groupAddress( m_configuration.multicastGroup() );
+
+	if( listen( QHostAddress::LocalHost, 0 ) == false ||
+		m_udpSocket.bind( QHostAddress( QHostAddress::AnyIPv4 ), m_port,
+						  QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint ) == false ||
+		m_udpSocket.joinMulticastGroup( groupAddress ) == false )
+	{
+		vWarning() << "could not join multicast group" << groupAddress.toString() << "port" << m_port
+				   << m_udpSocket.errorString() << errorString();
+		QTimer::singleShot( 0, this, &DemoMulticastClient::fail );
+		return;
+	}
+
+	m_udpSocket.setSocketOption( QAbstractSocket::ReceiveBufferSizeSocketOption, DemoMulticastProtocol::SocketBufferSize );
+
+	m_stallTimer.start();
+	m_connectTimer.start( ConnectTimeout );
+
+	connectToServer();
+}
+
+
+
+void DemoMulticastClient::incomingConnection( qintptr socketDescriptor )
+{
+	m_pendingConnections.append( quintptr( socketDescriptor ) );
+
+	if( m_ready )
+	{
+		acceptPendingConnections();
+	}
+}
+
+
+
+void DemoMulticastClient::acceptPendingConnections()
+{
+	while( m_pendingConnections.isEmpty() == false )
+	{
+		m_connections.append( new DemoServerConnection( this, m_authentication, m_pendingConnections.takeFirst() ) );
+	}
+}
+
+
+
+void DemoMulticastClient::connectToServer()
+{
+	m_remainingKeyFrameMessages = -1;
+	m_repairTimer.stop();
+
+	m_serverSocket.connectToHost( m_host, m_port );
+}
+
+
+
+void DemoMulticastClient::handleServerDisconnect()
+{
+	if( m_ready == false )
+	{
+		fail();
+		return;
+	}
+
+	// keep showing the last frame and try to resume once the server is available again
+	vWarning() << "lost connection to multicast side channel of" << m_host;
+
+	QTimer::singleShot( ReconnectInterval, this, &DemoMulticastClient::connectToServer );
+}
+
+
+
+void DemoMulticastClient::fail()
+{
+	if( m_ready || m_failed )
+	{
+		return;
+	}
+
+	vWarning() << "multicast transport unavailable for demo server" << m_host;
+
+	m_failed = true;
+	m_connectTimer.stop();
+	m_serverSocket.disconnect( this );
+	m_serverSocket.abort();
+
+	Q_EMIT failed();
+}
+
+
+
+void DemoMulticastClient::readFromServer()
+{
+	while( receiveServerMessage() )
+	{
+	}
+}
+
+
+
+bool DemoMulticastClient::receiveServerMessage()
+{
+	VariantArrayMessage message( &m_serverSocket );
+	if( message.isReadyForReceive() == false || message.receive() == false )
+	{
+		return false;
+	}
+
+	switch( static_cast<DemoMulticastProtocol::Command>( message.read().toInt() ) ) // Flawfinder: ignore
+	{
+	case DemoMulticastProtocol::Command::KeyFrame:
+	{
+		const auto serverInitMessage = message.read().toByteArray(); // Flawfinder: ignore
+		const auto keyFrame = message.read().toUInt(); // Flawfinder: ignore
+		const auto nextSequence = message.read().toUInt(); // Flawfinder: ignore
+		const auto messageCount = message.read().toInt(); // Flawfinder: ignore
+		beginKeyFrame( serverInitMessage, keyFrame, nextSequence, messageCount );
+		return true;
+	}
+
+	case DemoMulticastProtocol::Command::KeyFrameMessage:
+		if( m_remainingKeyFrameMessages > 0 )
+		{
+			m_dataLock.lockForWrite();
+			m_framebufferUpdateMessages.append( message.read().toByteArray() ); // Flawfinder: ignore
+			m_dataLock.unlock();
+
+			if( --m_remainingKeyFrameMessages == 0 )
+			{
+				finishKeyFrame();
+			}
+		}
+		return true;
+
+	case DemoMulticastProtocol::Command::Datagrams:
+	{
+		const auto datagrams = message.read().toList(); // Flawfinder: ignore
+		for( const auto& datagram : datagrams )
+		{
+			processDatagram( datagram.toByteArray() );
+		}
+		return true;
+	}
+
+	default:
+		break;
+	}
+
+	vWarning() << "invalid command from server";
+
+	return true;
+}
+
+
+
+void DemoMulticastClient::beginKeyFrame( const QByteArray& serverInitMessage, quint32 keyFrame,
+										 quint32 nextSequence, int messageCount )
+{
+	m_dataLock.lockForWrite();
+
+	// the local VNC view only receives the server init message once
+	if( m_serverInitMessage.isEmpty() )
+	{
+		m_serverInitMessage = serverInitMessage;
+	}
+
+	m_framebufferUpdateMessages.clear();
+	m_framebufferUpdateMessages.reserve( messageCount );
+	m_serverKeyFrame = keyFrame;
+	++m_keyFrame;
+
+	m_dataLock.unlock();
+
+	// discard everything already contained in the key frame
+	while( m_pendingDatagrams.isEmpty() == false && m_pendingDatagrams.firstKey() < nextSequence )
+	{
+		m_pendingDatagrams.erase( m_pendingDatagrams.begin() );
+	}
+
+	m_nextSequence = nextSequence;
+	m_endSequence = m_pendingDatagrams.isEmpty() ? nextSequence : m_pendingDatagrams.lastKey() + 1;
+	m_currentMessage.clear();
+	m_nextFragmentIndex = 0;
+
+	m_remainingKeyFrameMessages = messageCount;
+
+	if( m_remainingKeyFrameMessages <= 0 )
+	{
+		m_remainingKeyFrameMessages = 0;
+		finishKeyFrame();
+	}
+}
+
+
+
+void DemoMulticastClient::finishKeyFrame()
+{
+	if( m_ready == false )
+	{
+		vDebug() << "received initial key frame from" << m_host;
+
+		m_ready = true;
+		m_connectTimer.stop();
+
+		Q_EMIT ready();
+	}
+
+	acceptPendingConnections();
+
+	m_stallTimer.restart();
+
+	deliverPendingDatagrams();
+}
+
+
+
+void DemoMulticastClient::requestKeyFrame()
+{
+	if( m_remainingKeyFrameMessages < 0 )
+	{
+		// already waiting for a key frame
+		return;
+	}
+
+	m_remainingKeyFrameMessages = -1;
+	m_repairTimer.stop();
+
+	VariantArrayMessage message( &m_serverSocket );
+	message.write( static_cast<int>( DemoMulticastProtocol::Command::RequestKeyFrame ) );
+	message.send();
+}
+
+
+
+void DemoMulticastClient::readDatagrams()
+{
+	while( m_udpSocket.hasPendingDatagrams() )
+	{
+		QByteArray datagram( int( qMax<qint64>( 0, m_udpSocket.pendingDatagramSize() ) ), 0 );
+		if( m_udpSocket.readDatagram( datagram.data(), datagram.size() ) == datagram.size() ) // Flawfinder: ignore
+		{
+			processDatagram( datagram );
+		}
+	}
+}
+
+
+
+void DemoMulticastClient::processDatagram( const QByteArray& datagram )
+{
+	DemoMulticastProtocol::Header header;
+	QByteArray payload;
+
+	if( DemoMulticastProtocol::decode( datagram, header, payload ) == false )
+	{
+		return;
+	}
+
+	if( header.fragmentCount == 0 )
+	{
+		// heartbeat announcing the next sequence number
+		m_endSequence = qMax( m_endSequence, header.sequence );
+	}
+	else if( header.sequence >= m_nextSequence &&
+			 m_pendingDatagrams.size() < MaximumPendingDatagrams )
+	{
+		m_pendingDatagrams.insert( header.sequence, { header, payload } );
+		m_endSequence = qMax( m_endSequence, header.sequence + 1 );
+	}
+
+	deliverPendingDatagrams();
+}
+
+
+
+void DemoMulticastClient::deliverPendingDatagrams()
+{
+	const auto previousSequence = m_nextSequence;
+
+	// datagrams can't be applied before the key frame they refer to is complete
+	while( m_remainingKeyFrameMessages == 0 &&
+		   m_pendingDatagrams.isEmpty() == false &&
+		   m_pendingDatagrams.firstKey() == m_nextSequence )
+	{
+		const auto datagram = m_pendingDatagrams.take( m_nextSequence );
+		++m_nextSequence;
+
+		appendFragment( datagram.header, datagram.payload );
+	}
+
+	// only give up repairing if no progress has been made for some time
+	if( m_nextSequence != previousSequence )
+	{
+		m_stallTimer.restart();
+	}
+
+	if( m_remainingKeyFrameMessages != 0 || m_nextSequence >= m_endSequence )
+	{
+		m_repairTimer.stop();
+	}
+	else if( m_repairTimer.isActive() == false )
+	{
+		// give reordered datagrams some time to arrive before requesting retransmission
+		m_stallTimer.restart();
+		m_repairTimer.start( RepairInterval );
+	}
+}
+
+
+
+void DemoMulticastClient::appendFragment( const DemoMulticastProtocol::Header& header, const QByteArray& payload )
+{
+	if( header.fragmentIndex == 0 )
+	{
+		m_currentMessage.clear();
+	}
+	else if( header.fragmentIndex != m_nextFragmentIndex )
+	{
+		vWarning() << "unexpected fragment" << header.fragmentIndex << "of message" << header.messageIndex;
+		requestKeyFrame();
+		return;
+	}
+
+	m_currentMessage.append( payload );
+	m_nextFragmentIndex = header.fragmentIndex + 1;
+
+	if( m_nextFragmentIndex == header.fragmentCount )
+	{
+		appendMessage( header.keyFrame, header.messageIndex, m_currentMessage );
+
+		m_currentMessage.clear();
+		m_nextFragmentIndex = 0;
+	}
+}
+
+
+
+void DemoMulticastClient::appendMessage( quint32 keyFrame, quint32 messageIndex, const QByteArray& message )
+{
+	bool consistent = false;
+
+	m_dataLock.lockForWrite();
+
+	if( keyFrame != m_serverKeyFrame && messageIndex == 0 )
+	{
+		m_framebufferUpdateMessages.clear();
+		m_serverKeyFrame = keyFrame;
+		++m_keyFrame;
+	}
+
+	if( keyFrame == m_serverKeyFrame &&
+		messageIndex == quint32( m_framebufferUpdateMessages.size() ) )
+	{
+		m_framebufferUpdateMessages.append( message );
+		consistent = true;
+	}
+
+	m_dataLock.unlock();
+
+	if( consistent == false )
+	{
+		vWarning() << "missing messages before message" << messageIndex << "of key frame" << keyFrame;
+		requestKeyFrame();
+	}
+}
+
+
+
+void DemoMulticastClient::repair()
+{
+	if( m_remainingKeyFrameMessages != 0 || m_nextSequence >= m_endSequence )
+	{
+		m_repairTimer.stop();
+		return;
+	}
+
+	if( m_stallTimer.elapsed() > KeyFrameRequestTimeout )
+	{
+		vDebug() << "repair timed out - requesting key frame";
+		requestKeyFrame();
+		return;
+	}
+
+	QVariantList ranges;
+	int count = 0;
+	auto sequence = m_nextSequence;
+
+	while( sequence < m_endSequence && count < MaximumNackCount )
+	{
+		if( m_pendingDatagrams.contains( sequence ) )
+		{
+			++sequence;
+			continue;
+		}
+
+		const auto first = sequence;
+		while( sequence < m_endSequence && count < MaximumNackCount &&
+			   m_pendingDatagrams.contains( sequence ) == false )
+		{
+			++sequence;
+			++count;
+		}
+
+		ranges.append( first );
+		ranges.append( sequence - first );
+	}
+
+	VariantArrayMessage message( &m_serverSocket );
+	message.write( static_cast<int>( DemoMulticastProtocol::Command::Nack ) );
+	message.write( ranges );
+	message.send();
+}
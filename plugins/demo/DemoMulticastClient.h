@@ -0,0 +1,160 @@
+/*
+ * DemoMulticastClient.h - header file for DemoMulticastClient class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QPointer>
+#include <QReadWriteLock>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include "DemoFramebufferSource.h"
+#include "DemoMulticastProtocol.h"
+
+class DemoAuthentication;
+class DemoServerConnection;
+
+// receives the framebuffer updates of a demo server via multicast, reassembles
+// them and relays them to a local VNC view through a local demo server connection
+class DemoMulticastClient : public QTcpServer, public DemoFramebufferSource
+{
+	Q_OBJECT
+public:
+	DemoMulticastClient( const QString& host, int port, const DemoAuthentication& authentication,
+						 const DemoConfiguration& configuration, QObject* parent = nullptr );
+	~DemoMulticastClient() override;
+
+	void start();
+
+	const DemoConfiguration& configuration() const override
+	{
+		return m_configuration;
+	}
+
+	const QByteArray& serverInitMessage() const override
+	{
+		return m_serverInitMessage;
+	}
+
+	void lockDataForRead() override
+	{
+		m_dataLock.lockForRead();
+	}
+
+	void unlockData() override
+	{
+		m_dataLock.unlock();
+	}
+
+	int keyFrame() const override
+	{
+		return m_keyFrame;
+	}
+
+	const MessageList& framebufferUpdateMessages() const override
+	{
+		return m_framebufferUpdateMessages;
+	}
+
+	void requestFullFramebufferUpdate() override
+	{
+		// the local VNC view is served the complete current key frame anyway while
+		// the multicast transport requests new key frames on its own
+	}
+
+Q_SIGNALS:
+	void ready();
+	void failed();
+
+private:
+	static constexpr int ConnectTimeout = 5000;
+	static constexpr int ReconnectInterval = 1000;
+	static constexpr int ConnectionThreadWaitTime = 5000;
+	static constexpr int RepairInterval = 100;
+	static constexpr int KeyFrameRequestTimeout = 3000;
+	static constexpr int MaximumNackCount = 1024;
+	static constexpr int MaximumPendingDatagrams = 65536;
+
+	struct Datagram
+	{
+		DemoMulticastProtocol::Header header;
+		QByteArray payload;
+	} ;
+
+	void incomingConnection( qintptr socketDescriptor ) override;
+	void acceptPendingConnections();
+
+	void connectToServer();
+	void handleServerDisconnect();
+	void fail();
+
+	void readFromServer();
+	bool receiveServerMessage();
+	void beginKeyFrame( const QByteArray& serverInitMessage, quint32 keyFrame, quint32 nextSequence, int messageCount );
+	void finishKeyFrame();
+	void requestKeyFrame();
+
+	void readDatagrams();
+	void processDatagram( const QByteArray& datagram );
+	void deliverPendingDatagrams();
+	void appendFragment( const DemoMulticastProtocol::Header& header, const QByteArray& payload );
+	void appendMessage( quint32 keyFrame, quint32 messageIndex, const QByteArray& message );
+	void repair();
+
+	const DemoAuthentication& m_authentication;
+	const DemoConfiguration& m_configuration;
+	const QString m_host;
+	const quint16 m_port;
+
+	QTcpSocket m_serverSocket{this};
+	QUdpSocket m_udpSocket{this};
+	QTimer m_connectTimer{this};
+	QTimer m_repairTimer{this};
+	QElapsedTimer m_stallTimer{};
+
+	bool m_ready{false};
+	bool m_failed{false};
+
+	QList<quintptr> m_pendingConnections{};
+	QList<QPointer<DemoServerConnection>> m_connections{};
+
+	QReadWriteLock m_dataLock{};
+	QByteArray m_serverInitMessage{};
+	int m_keyFrame{0};
+	MessageList m_framebufferUpdateMessages{};
+
+	quint32 m_serverKeyFrame{0};
+	quint32 m_nextSequence{0};
+	quint32 m_endSequence{0};
+	int m_remainingKeyFrameMessages{-1};
+
+	QMap<quint32, Datagram> m_pendingDatagrams{};
+	QByteArray m_currentMessage{};
+	int m_nextFragmentIndex{0};
+
+} ;
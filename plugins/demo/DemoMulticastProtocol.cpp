@@ -0,0 +1,89 @@
+/*
+ * DemoMulticastProtocol.cpp - implementation of DemoMulticastProtocol class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QtEndian>
+
+#include "DemoConfiguration.h"
+#include "DemoMulticastProtocol.h"
+
+
+QByteArray DemoMulticastProtocol::encode( const Header& header, const char* payload, int payloadSize )
+{
+	QByteArray datagram( HeaderSize + payloadSize, 0 );
+	auto data = reinterpret_cast<uchar *>( datagram.data() );
+
+	qToBigEndian<quint32>( Magic, data );
+	qToBigEndian<quint32>( header.sequence, data + 4 );
+	qToBigEndian<quint32>( header.keyFrame, data + 8 );
+	qToBigEndian<quint32>( header.messageIndex, data + 12 );
+	qToBigEndian<quint16>( header.fragmentIndex, data + 16 );
+	qToBigEndian<quint16>( header.fragmentCount, data + 18 );
+
+	if( payloadSize > 0 )
+	{
+		memcpy( datagram.data() + HeaderSize, payload, size_t( payloadSize ) );
+	}
+
+	return datagram;
+}
+
+
+
+bool DemoMulticastProtocol::decode( const QByteArray& datagram, Header& header, QByteArray& payload )
+{
+	if( datagram.size() < HeaderSize || datagram.size() > MaximumDatagramSize )
+	{
+		return false;
+	}
+
+	const auto data = reinterpret_cast<const uchar *>( datagram.constData() );
+
+	if( qFromBigEndian<quint32>( data ) != Magic )
+	{
+		return false;
+	}
+
+	header.sequence = qFromBigEndian<quint32>( data + 4 );
+	header.keyFrame = qFromBigEndian<quint32>( data + 8 );
+	header.messageIndex = qFromBigEndian<quint32>( data + 12 );
+	header.fragmentIndex = qFromBigEndian<quint16>( data + 16 );
+	header.fragmentCount = qFromBigEndian<quint16>( data + 18 );
+
+	if( header.fragmentCount > 0 && header.fragmentIndex >= header.fragmentCount )
+	{
+		return false;
+	}
+
+	payload = datagram.mid( HeaderSize );
+
+	return true;
+}
+
+
+
+int DemoMulticastProtocol::port( const DemoConfiguration& configuration, int demoServerPort )
+{
+	// apply the same session specific offset as for the demo server port
+	return configuration.multicastPort() + demoServerPort - VeyonCore::config().demoServerPort();
+}
@@ -0,0 +1,69 @@
+/*
+ * DemoMulticastProtocol.h - header file for DemoMulticastProtocol class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+class DemoConfiguration;
+
+// wire format of the optional multicast transport of the demo server
+//
+// each framebuffer update message is split into fragments which are sent as
+// sequenced datagrams to the configured multicast group - lost datagrams and
+// key frames for late joining clients are requested via a TCP side channel
+class DemoMulticastProtocol
+{
+public:
+	static constexpr quint32 Magic = 0x56444d43; // "VDMC"
+	static constexpr int HeaderSize = 20;
+	static constexpr int MaximumDatagramSize = 1400;
+	static constexpr int MaximumPayloadSize = MaximumDatagramSize - HeaderSize;
+	static constexpr int SocketBufferSize = 4*1024*1024;
+
+	// commands exchanged via the side channel
+	enum class Command
+	{
+		KeyFrame,		// server: header of a key frame, followed by the key frame's messages
+		KeyFrameMessage,	// server: single framebuffer update message of a key frame
+		Datagrams,		// server: retransmitted datagrams
+		Nack,			// client: request retransmission of lost datagrams
+		RequestKeyFrame	// client: request a new key frame in case repair is impossible
+	} ;
+
+	struct Header
+	{
+		quint32 sequence{0};
+		quint32 keyFrame{0};
+		quint32 messageIndex{0};
+		quint16 fragmentIndex{0};
+		quint16 fragmentCount{0}; // 0 for heartbeats announcing the next sequence number
+	} ;
+
+	static QByteArray encode( const Header& header, const char* payload, int payloadSize );
+	static bool decode( const QByteArray& datagram, Header& header, QByteArray& payload );
+
+	static int port( const DemoConfiguration& configuration, int demoServerPort );
+
+} ;
@@ -0,0 +1,360 @@
+/*
+ * DemoMulticastServer.cpp - implementation of DemoMulticastServer class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QTcpSocket>
+
+#include "DemoAuthentication.h"
+#include "DemoConfiguration.h"
+#include "DemoFramebufferSource.h"
+#include "DemoMulticastProtocol.h"
+#include "DemoMulticastServer.h"
+#include "TraceLog.h"
+#include "VariantArrayMessage.h"
+
+
+DemoMulticastServer::DemoMulticastServer( DemoFramebufferSource& source, const DemoAuthentication& authentication,
+										  const DemoConfiguration& configuration, int port, QObject* parent ) :
+	QTcpServer( parent ),
+	m_source( source ),
+	m_authentication( authentication ),
+	m_groupAddress( configuration.multicastGroup() ),
+	m_port( static_cast<quint16>( port ) ),
+	m_sendRate( qMax( 1, configuration.multicastSendRate() ) * 1000 / 8 )
+{
+	if( m_groupAddress.isMulticast() == false )
+	{
+		vCritical() << "invalid multicast group address" << configuration.multicastGroup();
+	}
+
+	if( m_udpSocket.bind( QHostAddress( QHostAddress::AnyIPv4 ), 0 ) == false )
+	{
+		vCritical() << "could not bind multicast socket:" << m_udpSocket.errorString();
+	}
+
+	m_udpSocket.setSocketOption( QAbstractSocket::MulticastTtlOption, configuration.multicastTimeToLive() );
+	// allow clients on the same host (e.g. the master's local demo window)
+	m_udpSocket.setSocketOption( QAbstractSocket::MulticastLoopbackOption, 1 );
+	m_udpSocket.setSocketOption( QAbstractSocket::SendBufferSizeSocketOption, DemoMulticastProtocol::SocketBufferSize );
+
+	connect( this, &QTcpServer::newConnection, this, &DemoMulticastServer::acceptRepairConnections );
+
+	if( listen( QHostAddress::Any, m_port ) == false )
+	{
+		vCritical() << "could not listen on multicast side channel port" << m_port;
+	}
+
+	connect( &m_heartbeatTimer, &QTimer::timeout, this, &DemoMulticastServer::sendHeartbeat );
+	m_heartbeatTimer.start( HeartbeatInterval );
+
+	m_sendTimer.setTimerType( Qt::PreciseTimer );
+	m_sendTimer.setInterval( SendInterval );
+	connect( &m_sendTimer, &QTimer::timeout, this, &DemoMulticastServer::sendQueuedDatagrams );
+
+	m_sendTokens = m_sendRate * MaximumBurstDuration;
+	m_sendRateTimer.start();
+
+	vDebug() << "sending to multicast group" << m_groupAddress.toString() << "port" << m_port;
+}
+
+
+
+DemoMulticastServer::~DemoMulticastServer()
+{
+	m_heartbeatTimer.stop();
+	m_sendTimer.stop();
+
+	if( m_sendErrorCount > 0 || m_droppedDatagramCount > 0 )
+	{
+		vWarning() << "failed to send" << m_sendErrorCount << "times, dropped" << m_droppedDatagramCount << "datagrams";
+	}
+
+	// side channel sockets are children of the server and must not access it while being destroyed
+	const auto sockets = findChildren<QTcpSocket *>();
+	for( auto socket : sockets )
+	{
+		socket->disconnect( this );
+	}
+}
+
+
+
+void DemoMulticastServer::sendFramebufferUpdateMessage( int keyFrame, int messageIndex, const QByteArray& message )
+{
+	const auto fragmentCount = qMax( 1, ( message.size() + DemoMulticastProtocol::MaximumPayloadSize - 1 ) /
+										DemoMulticastProtocol::MaximumPayloadSize );
+	if( fragmentCount > 0xffff )
+	{
+		// clients will notice the missing message and request a key frame via the side channel
+		vWarning() << "message too large for multicast transport:" << message.size();
+		return;
+	}
+
+	DemoMulticastProtocol::Header header;
+	header.keyFrame = quint32( keyFrame );
+	header.messageIndex = quint32( messageIndex );
+	header.fragmentCount = quint16( fragmentCount );
+
+	for( int fragment = 0; fragment < fragmentCount; ++fragment )
+	{
+		const auto offset = fragment * DemoMulticastProtocol::MaximumPayloadSize;
+
+		header.sequence = m_nextSequence++;
+		header.fragmentIndex = quint16( fragment );
+
+		queueDatagram( DemoMulticastProtocol::encode( header, message.constData() + offset,
+													 qMin( int( DemoMulticastProtocol::MaximumPayloadSize ), message.size() - offset ) ) );
+	}
+
+	TraceLog::record( TraceLog::Event::DemoServerSend, message.size(), fragmentCount, keyFrame );
+}
+
+
+
+void DemoMulticastServer::acceptRepairConnections()
+{
+	while( hasPendingConnections() )
+	{
+		auto socket = nextPendingConnection();
+
+		connect( socket, &QTcpSocket::readyRead, this, [=]() { readFromRepairClient( socket ); } );
+		connect( socket, &QTcpSocket::disconnected, this, [=]() {
+			m_authenticatedClients.remove( socket );
+			socket->deleteLater();
+		} );
+	}
+}
+
+
+
+void DemoMulticastServer::readFromRepairClient( QTcpSocket* socket )
+{
+	while( receiveRepairClientMessage( socket ) )
+	{
+	}
+}
+
+
+
+bool DemoMulticastServer::receiveRepairClientMessage( QTcpSocket* socket )
+{
+	VariantArrayMessage message( socket );
+	if( message.isReadyForReceive() == false || message.receive() == false )
+	{
+		return false;
+	}
+
+	// the first message of each client has to contain the demo access token
+	if( m_authenticatedClients.contains( socket ) == false )
+	{
+		if( m_authentication.hasCredentials() &&
+			message.read().toByteArray() == m_authentication.accessToken().toByteArray() ) // Flawfinder: ignore
+		{
+			m_authenticatedClients.insert( socket );
+			sendKeyFrame( socket );
+			return true;
+		}
+
+		vWarning() << "authentication of" << socket->peerAddress().toString() << "failed";
+		socket->close();
+		return false;
+	}
+
+	switch( static_cast<DemoMulticastProtocol::Command>( message.read().toInt() ) ) // Flawfinder: ignore
+	{
+	case DemoMulticastProtocol::Command::Nack:
+		retransmitDatagrams( socket, message.read().toList() ); // Flawfinder: ignore
+		return true;
+
+	case DemoMulticastProtocol::Command::RequestKeyFrame:
+		sendKeyFrame( socket );
+		return true;
+
+	default:
+		break;
+	}
+
+	vWarning() << "invalid command from" << socket->peerAddress().toString();
+	socket->close();
+
+	return false;
+}
+
+
+
+void DemoMulticastServer::sendKeyFrame( QTcpSocket* socket )
+{
+	if( m_authenticatedClients.contains( socket ) == false )
+	{
+		return;
+	}
+
+	if( m_source.serverInitMessage().isEmpty() )
+	{
+		// not yet connected to VNC server so try again later
+		QTimer::singleShot( KeyFrameRetryInterval, socket, [=]() { sendKeyFrame( socket ); } );
+		return;
+	}
+
+	m_source.lockDataForRead();
+
+	const auto& messages = m_source.framebufferUpdateMessages();
+
+	// all datagrams starting with the next sequence number continue the transmitted key frame
+	VariantArrayMessage keyFrameMessage( socket );
+	keyFrameMessage.write( static_cast<int>( DemoMulticastProtocol::Command::KeyFrame ) );
+	keyFrameMessage.write( m_source.serverInitMessage() );
+	keyFrameMessage.write( m_source.keyFrame() );
+	keyFrameMessage.write( m_nextSequence );
+	keyFrameMessage.write( messages.count() );
+	keyFrameMessage.send();
+
+	for( const auto& message : messages )
+	{
+		VariantArrayMessage updateMessage( socket );
+		updateMessage.write( static_cast<int>( DemoMulticastProtocol::Command::KeyFrameMessage ) );
+		updateMessage.write( message );
+		updateMessage.send();
+	}
+
+	m_source.unlockData();
+}
+
+
+
+void DemoMulticastServer::retransmitDatagrams( QTcpSocket* socket, const QVariantList& ranges )
+{
+	QVariantList datagrams;
+
+	for( int i = 0; i+1 < ranges.size(); i += 2 )
+	{
+		const auto first = ranges[i].toUInt();
+		const auto count = qMin( ranges[i+1].toUInt(), uint( MaximumHistorySize ) );
+
+		for( auto sequence = first; sequence != first + count; ++sequence )
+		{
+			const auto offset = sequence - m_historyFirstSequence;
+			if( sequence < m_historyFirstSequence || offset >= quint32( m_history.size() ) )
+			{
+				vDebug() << "datagram" << sequence << "no longer available - sending key frame";
+				sendKeyFrame( socket );
+				return;
+			}
+
+			datagrams.append( m_history.at( int( offset ) ) );
+		}
+	}
+
+	if( datagrams.isEmpty() == false )
+	{
+		VariantArrayMessage message( socket );
+		message.write( static_cast<int>( DemoMulticastProtocol::Command::Datagrams ) );
+		message.write( datagrams );
+		message.send();
+	}
+}
+
+
+
+void DemoMulticastServer::queueDatagram( const QByteArray& datagram )
+{
+	m_history.enqueue( datagram );
+
+	while( m_history.size() > MaximumHistorySize )
+	{
+		m_history.dequeue();
+		++m_historyFirstSequence;
+	}
+
+	m_sendQueue.enqueue( datagram );
+
+	// datagrams which never get sent are simply repaired through the side channel
+	while( m_sendQueue.size() > MaximumSendQueueSize )
+	{
+		m_sendQueue.dequeue();
+		++m_droppedDatagramCount;
+	}
+
+	if( m_sendTimer.isActive() == false )
+	{
+		sendQueuedDatagrams();
+	}
+}
+
+
+
+void DemoMulticastServer::sendQueuedDatagrams()
+{
+	// token bucket limiting the send rate so bursts of large updates do not overflow
+	// switch and receiver buffers - tokens only accumulate for a short period of time
+	m_sendTokens = qMin( m_sendTokens + m_sendRateTimer.restart() * m_sendRate,
+						 m_sendRate * MaximumBurstDuration );
+
+	while( m_sendQueue.isEmpty() == false && m_sendTokens >= m_sendQueue.head().size() )
+	{
+		const auto size = m_sendQueue.head().size();
+
+		if( m_udpSocket.writeDatagram( m_sendQueue.head(), m_groupAddress, m_port ) != size )
+		{
+			++m_sendErrorCount;
+
+			// retry with the next timer tick as most errors are caused by a full send buffer
+			if( ++m_sendAttempts < MaximumSendAttempts )
+			{
+				break;
+			}
+
+			vWarning() << "dropping datagram after" << m_sendAttempts << "failed attempts:" << m_udpSocket.errorString();
+
+			++m_droppedDatagramCount;
+		}
+		else
+		{
+			m_sendTokens -= size;
+		}
+
+		m_sendQueue.dequeue();
+		m_sendAttempts = 0;
+	}
+
+	if( m_sendQueue.isEmpty() )
+	{
+		m_sendTimer.stop();
+	}
+	else if( m_sendTimer.isActive() == false )
+	{
+		m_sendTimer.start();
+	}
+}
+
+
+
+void DemoMulticastServer::sendHeartbeat()
+{
+	// announce the next sequence number so clients can detect lost datagrams at the end of a burst -
+	// datagrams still waiting in the send queue must not be considered lost
+	DemoMulticastProtocol::Header header;
+	header.sequence = m_nextSequence - quint32( m_sendQueue.size() );
+
+	m_udpSocket.writeDatagram( DemoMulticastProtocol::encode( header, nullptr, 0 ), m_groupAddress, m_port );
+}
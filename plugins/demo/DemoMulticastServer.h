@@ -0,0 +1,96 @@
+/*
+ * DemoMulticastServer.h - header file for DemoMulticastServer class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QQueue>
+#include <QSet>
+#include <QTcpServer>
+#include <QTimer>
+#include <QUdpSocket>
+
+class DemoAuthentication;
+class DemoConfiguration;
+class DemoFramebufferSource;
+
+// sends the framebuffer updates of the demo server as sequenced datagrams to a
+// multicast group and serves the TCP side channel used by clients for requesting
+// lost datagrams and key frames
+class DemoMulticastServer : public QTcpServer
+{
+	Q_OBJECT
+public:
+	DemoMulticastServer( DemoFramebufferSource& source, const DemoAuthentication& authentication,
+						 const DemoConfiguration& configuration, int port, QObject* parent );
+	~DemoMulticastServer() override;
+
+	void sendFramebufferUpdateMessage( int keyFrame, int messageIndex, const QByteArray& message );
+
+private:
+	static constexpr int HeartbeatInterval = 500;
+	static constexpr int KeyFrameRetryInterval = 250;
+	static constexpr int MaximumHistorySize = 16384;
+	static constexpr int MaximumSendQueueSize = MaximumHistorySize / 2;
+	static constexpr int MaximumSendAttempts = 10;
+	static constexpr int MaximumBurstDuration = 10;
+	static constexpr int SendInterval = 1;
+
+	void acceptRepairConnections();
+	void readFromRepairClient( QTcpSocket* socket );
+	bool receiveRepairClientMessage( QTcpSocket* socket );
+
+	void sendKeyFrame( QTcpSocket* socket );
+	void retransmitDatagrams( QTcpSocket* socket, const QVariantList& ranges );
+
+	void queueDatagram( const QByteArray& datagram );
+	void sendQueuedDatagrams();
+	void sendHeartbeat();
+
+	DemoFramebufferSource& m_source;
+	const DemoAuthentication& m_authentication;
+
+	const QHostAddress m_groupAddress;
+	const quint16 m_port;
+	const qint64 m_sendRate; // bytes per millisecond
+
+	QUdpSocket m_udpSocket{this};
+	QTimer m_heartbeatTimer{this};
+
+	QTimer m_sendTimer{this};
+	QElapsedTimer m_sendRateTimer{};
+	qint64 m_sendTokens{0};
+	QQueue<QByteArray> m_sendQueue{};
+	int m_sendAttempts{0};
+	quint64 m_sendErrorCount{0};
+	quint64 m_droppedDatagramCount{0};
+
+	quint32 m_nextSequence{0};
+	quint32 m_historyFirstSequence{0};
+	QQueue<QByteArray> m_history{};
+
+	QSet<QTcpSocket *> m_authenticatedClients{};
+
+} ;
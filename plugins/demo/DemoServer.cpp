@@ -27,24 +27,35 @@
 
 #include <QTcpSocket>
 
+#include "DemoAuthentication.h"
 #include "DemoConfiguration.h"
+#include "DemoMulticastProtocol.h"
+#include "DemoMulticastServer.h"
 #include "DemoServer.h"
 #include "DemoServerConnection.h"
+#include "TraceLog.h"
 #include "VeyonConfiguration.h"
 #include "VncClientProtocol.h"
 
 
-DemoServer::DemoServer( int vncServerPort, const Password& vncServerPassword, const DemoAuthentication& authentication,
+DemoServer::DemoServer( const QString& upstreamHost, int vncServerPort, const Password& vncServerPassword,
+						const DemoAuthentication& authentication,
 						const DemoConfiguration& configuration, int demoServerPort, QObject *parent ) :
 	QTcpServer( parent ),
 	m_authentication( authentication ),
 	m_configuration( configuration ),
 	m_memoryLimit( m_configuration.memoryLimit() * 1024*1024 ),
 	m_keyFrameInterval( m_configuration.keyFrameInterval() * 1000 ),
+	m_upstreamHost( upstreamHost ),
 	m_vncServerPort( vncServerPort ),
 	m_vncServerSocket( new QTcpSocket( this ) ),
 	m_vncClientProtocol( new VncClientProtocol( m_vncServerSocket, vncServerPassword ) )
 {
+	if( m_upstreamHost.isEmpty() == false )
+	{
+		m_vncClientProtocol->setAuthenticationPlugin( m_authentication.pluginUid(), &m_authentication );
+	}
+
 	connect( m_vncServerSocket, &QTcpSocket::readyRead, this, &DemoServer::readFromVncServer );
 	connect( m_vncServerSocket, &QTcpSocket::disconnected, this, &DemoServer::reconnectToVncServer );
 
@@ -56,6 +67,13 @@ DemoServer::DemoServer( int vncServerPort, const Password& vncServerPassword, co
 		return;
 	}
 
+	// relaying demo servers are not required when broadcasting via multicast
+	if( m_configuration.isMulticastEnabled() && m_upstreamHost.isEmpty() )
+	{
+		m_multicastServer = new DemoMulticastServer( *this, m_authentication, m_configuration,
+													 DemoMulticastProtocol::port( m_configuration, demoServerPort ), this );
+	}
+
 	m_framebufferUpdateTimer.start( m_configuration.framebufferUpdateInterval() );
 
 	reconnectToVncServer();
@@ -79,6 +97,9 @@ DemoServer::~DemoServer()
 		l.front()->deleteLater();
 	}
 
+	vDebug() << "deleting multicast server";
+	delete m_multicastServer;
+
 	vDebug() << "deleting VNC client protocol";
 	delete m_vncClientProtocol;
 
@@ -141,7 +162,22 @@ void DemoServer::reconnectToVncServer()
 {
 	m_vncClientProtocol->start();
 
-	m_vncServerSocket->connectToHost( QHostAddress::LocalHost, static_cast<quint16>( m_vncServerPort ) );
+	if( m_upstreamHost.isEmpty() )
+	{
+		m_vncServerSocket->connectToHost( QHostAddress::LocalHost, static_cast<quint16>( m_vncServerPort ) );
+	}
+	else
+	{
+		m_vncServerSocket->connectToHost( m_upstreamHost, static_cast<quint16>( m_vncServerPort ) );
+	}
+
+	// upstream server (e.g. a relay on another computer) may not be listening yet so retry until connected
+	QTimer::singleShot( ReconnectInterval, this, [this]() {
+		if( m_vncServerSocket->state() == QAbstractSocket::UnconnectedState )
+		{
+			reconnectToVncServer();
+		}
+	} );
 }
 
 
@@ -246,12 +282,28 @@ void DemoServer::enqueueFramebufferUpdateMessage( const QByteArray& message )
 		++m_keyFrame;
 
 		m_framebufferUpdateMessages.clear();
+
+		if( isFullUpdate == false )
+		{
+			// the new key frame lacks the initial full update so request one as soon as
+			// possible - relays are served it by the upstream demo server connection
+			m_requestFullFramebufferUpdate = true;
+		}
 	}
 
 	m_framebufferUpdateMessages.append( message );
 
+	const auto messageIndex = m_framebufferUpdateMessages.size() - 1;
+
+	TraceLog::record( TraceLog::Event::DemoServerEnqueue, message.size(), queueSize, m_keyFrame );
+
 	m_dataLock.unlock();
 
+	if( m_multicastServer )
+	{
+		m_multicastServer->sendFramebufferUpdateMessage( m_keyFrame, messageIndex, message );
+	}
+
 	// we're about to reach memory limits?
 	if( framebufferUpdateMessageQueueSize() > m_memoryLimit )
 	{
@@ -30,49 +30,60 @@
 #include <QTcpServer>
 #include <QTimer>
 
+#include <atomic>
+
 #include "CryptoCore.h"
+#include "DemoFramebufferSource.h"
 
 class DemoAuthentication;
 class DemoConfiguration;
+class DemoMulticastServer;
 class QTcpServer;
 class QTcpSocket;
 class VncClientProtocol;
 
-class DemoServer : public QTcpServer
+class DemoServer : public QTcpServer, public DemoFramebufferSource
 {
 	Q_OBJECT
 public:
 	using Password = CryptoCore::PlaintextPassword;
-	using MessageList = QVector<QByteArray>;
 
-	DemoServer( int vncServerPort, const Password& vncServerPassword, const DemoAuthentication& authentication,
+	// an empty upstream host makes the demo server read from the local VNC server while otherwise
+	// it relays the updates of another demo server authenticating with the demo access token
+	DemoServer( const QString& upstreamHost, int vncServerPort, const Password& vncServerPassword,
+				const DemoAuthentication& authentication,
 				const DemoConfiguration& configuration, int demoServerPort, QObject *parent );
 	~DemoServer() override;
 
-	const DemoConfiguration& configuration() const
+	const DemoConfiguration& configuration() const override
 	{
 		return m_configuration;
 	}
 
-	const QByteArray& serverInitMessage() const;
+	const QByteArray& serverInitMessage() const override;
 
-	void lockDataForRead();
+	void lockDataForRead() override;
 
-	void unlockData()
+	void unlockData() override
 	{
 		m_dataLock.unlock();
 	}
 
-	int keyFrame() const
+	int keyFrame() const override
 	{
 		return m_keyFrame;
 	}
 
-	const MessageList& framebufferUpdateMessages() const
+	const MessageList& framebufferUpdateMessages() const override
 	{
 		return m_framebufferUpdateMessages;
 	}
 
+	void requestFullFramebufferUpdate() override
+	{
+		m_requestFullFramebufferUpdate = true;
+	}
+
 private:
 	void incomingConnection( qintptr socketDescriptor ) override;
 	void acceptPendingConnections();
@@ -90,22 +101,25 @@ private:
 	bool setVncServerEncodings();
 
 	static constexpr auto ConnectionThreadWaitTime = 5000;
+	static constexpr auto ReconnectInterval = 1000;
 
 	const DemoAuthentication& m_authentication;
 	const DemoConfiguration& m_configuration;
 	const qint64 m_memoryLimit;
 	const int m_keyFrameInterval;
+	const QString m_upstreamHost;
 	const int m_vncServerPort;
 
 	QList<quintptr> m_pendingConnections;
 	QTcpSocket* m_vncServerSocket;
 	VncClientProtocol* m_vncClientProtocol;
+	DemoMulticastServer* m_multicastServer{nullptr};
 
 	QReadWriteLock m_dataLock{};
 	QTimer m_framebufferUpdateTimer{this};
 	QElapsedTimer m_lastFullFramebufferUpdate{};
 	QElapsedTimer m_keyFrameTimer{};
-	bool m_requestFullFramebufferUpdate{false};
+	std::atomic<bool> m_requestFullFramebufferUpdate{false};
 
 	int m_keyFrame{0};
 	MessageList m_framebufferUpdateMessages{};
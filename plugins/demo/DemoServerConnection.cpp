@@ -28,11 +28,12 @@
 #include <QTcpSocket>
 
 #include "DemoConfiguration.h"
-#include "DemoServer.h"
+#include "DemoFramebufferSource.h"
 #include "DemoServerConnection.h"
+#include "TraceLog.h"
 
 
-DemoServerConnection::DemoServerConnection( DemoServer* demoServer,
+DemoServerConnection::DemoServerConnection( DemoFramebufferSource* demoServer,
 											const DemoAuthentication& authentication,
 											quintptr socketDescriptor ) :
 	QThread(),
@@ -144,10 +145,19 @@ bool DemoServerConnection::receiveClientMessage()
 			return false;
 		}
 
-		m_socket->read( m_rfbClientToServerMessageSizes[messageType] );
+		const auto message = m_socket->read( m_rfbClientToServerMessageSizes[messageType] );
 
 		if( messageType == rfbFramebufferUpdateRequest )
 		{
+			const auto request = reinterpret_cast<const rfbFramebufferUpdateRequestMsg *>( message.constData() );
+			if( message.size() == sz_rfbFramebufferUpdateRequestMsg && request->incremental == 0 && m_keyFrame >= 0 )
+			{
+				// send the complete current key frame again (e.g. to a relaying demo server which
+				// reset its queue after reaching its memory limit) and have a fresh one created
+				m_keyFrame = -1;
+				m_demoServer->requestFullFramebufferUpdate();
+			}
+
 			sendFramebufferUpdate();
 		}
 
@@ -175,12 +185,21 @@ void DemoServerConnection::sendFramebufferUpdate()
 	}
 
 	bool sentUpdates = false;
+	qint64 sentBytes = 0;
+	const auto firstMessageIndex = m_framebufferUpdateMessageIndex;
+
 	for( ; m_framebufferUpdateMessageIndex < framebufferUpdateMessageCount; ++m_framebufferUpdateMessageIndex )
 	{
-		m_socket->write( framebufferUpdateMessages[m_framebufferUpdateMessageIndex] );
+		sentBytes += m_socket->write( framebufferUpdateMessages[m_framebufferUpdateMessageIndex] );
 		sentUpdates = true;
 	}
 
+	if( sentUpdates )
+	{
+		TraceLog::record( TraceLog::Event::DemoServerSend, sentBytes,
+						  m_framebufferUpdateMessageIndex - firstMessageIndex, m_keyFrame );
+	}
+
 	m_demoServer->unlockData();
 
 	if( sentUpdates == false )
@@ -26,7 +26,7 @@
 
 #include "DemoServerProtocol.h"
 
-class DemoServer;
+class DemoFramebufferSource;
 
 // clazy:excludeall=ctor-missing-parent-argument
 
@@ -39,7 +39,7 @@ class DemoServerConnection : public QThread
 public:
 	static constexpr int ProtocolRetryTime = 250;
 
-	DemoServerConnection( DemoServer* demoServer, const DemoAuthentication& authentication, quintptr socketDescriptor );
+	DemoServerConnection( DemoFramebufferSource* demoServer, const DemoAuthentication& authentication, quintptr socketDescriptor );
 	~DemoServerConnection() = default;
 
 private:
@@ -51,7 +51,7 @@ private:
 	bool receiveClientMessage();
 
 	const DemoAuthentication& m_authentication;
-	DemoServer* m_demoServer;
+	DemoFramebufferSource* m_demoServer;
 
 	quintptr m_socketDescriptor;
 	QTcpSocket* m_socket{nullptr};
@@ -28,6 +28,7 @@
 #include <ldap.h>
 
 #include "ldapconnection.h"
+#include "ldapcontrol.h"
 #include "ldapoperation.h"
 #include "ldapserver.h"
 
@@ -119,6 +120,7 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 
 	int result = -1;
 	auto id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList( attributes ) );
+	++m_searchRequestCount;
 
 	if( id != -1 )
 	{
@@ -187,6 +189,121 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 
 
 
+LdapClient::Objects LdapClient::queryObjectsPaged( const QString& dn, const QStringList& attributes,
+												   const QString& filter, LdapClient::Scope scope )
+{
+	vDebug() << "called with" << dn << attributes << filter << scope;
+
+	if( m_state != Bound && reconnect() == false )
+	{
+		vCritical() << "not bound to server!";
+		return {};
+	}
+
+	if( dn.isEmpty() )
+	{
+		vCritical() << "DN is empty!";
+		return {};
+	}
+
+	if( attributes.isEmpty() )
+	{
+		vCritical() << "attributes empty!";
+		return {};
+	}
+
+	// entries may differ in the set of returned attributes, therefore match attribute names
+	// case-insensitively for each entry instead of only for the first result
+	QHash<QString, QString> requestedAttributeNames;
+	for( const auto& attribute : attributes )
+	{
+		requestedAttributeNames[attribute.toLower()] = attribute;
+	}
+
+	Objects entries;
+
+	int result = -1;
+	QByteArray cookie;
+
+	do
+	{
+		// do not mark the control as critical so servers without paging support
+		// simply return all results at once
+		auto pageControl = KLDAP::LdapControl::createPageControl( LdapPageSize, cookie );
+		pageControl.setCritical( false );
+		m_operation->setServerControls( { pageControl } );
+
+		const auto id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, attributes );
+		++m_searchRequestCount;
+
+		cookie.clear();
+
+		if( id == -1 )
+		{
+			result = -1;
+			break;
+		}
+
+		while( ( result = m_operation->waitForResult( id, LdapQueryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
+		{
+			const auto& object = m_operation->object();
+			auto& entry = entries[object.dn().toString()];
+
+			const auto objectAttributes = object.attributes();
+			for( auto it = objectAttributes.constBegin(), end = objectAttributes.constEnd(); it != end; ++it )
+			{
+				const auto attribute = requestedAttributeNames.constFind( it.key().toLower() );
+				if( attribute != requestedAttributeNames.constEnd() )
+				{
+					// convert result list from type QList<QByteArray> to QStringList
+					auto& values = entry[*attribute];
+					for( const auto& value : it.value() )
+					{
+						values += QString::fromUtf8( value );
+					}
+				}
+			}
+		}
+
+		if( result == -1 )
+		{
+			break;
+		}
+
+		const auto controls = m_operation->controls();
+		for( const auto& control : controls )
+		{
+			if( control.parsePageControl( cookie ) >= 0 )
+			{
+				break;
+			}
+		}
+	}
+	while( cookie.isEmpty() == false );
+
+	m_operation->setServerControls( {} );
+
+	vDebug() << "results:" << entries.count() << "objects";
+
+	if( result == -1 )
+	{
+		vWarning() << "LDAP search failed with code" << m_connection->ldapErrorCode();
+
+		if( m_state == Bound && m_queryRetry == false )
+		{
+			// close connection and try again
+			m_queryRetry = true;
+			m_state = Disconnected;
+			entries = queryObjectsPaged( dn, attributes, filter, scope );
+			m_queryRetry = false;
+		}
+	}
+
+	return entries;
+}
+
+
+
 QStringList LdapClient::queryAttributeValues( const QString& dn, const QString& attribute,
 											  const QString& filter, Scope scope )
 {
@@ -205,6 +322,30 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 		return {};
 	}
 
+	return searchAttributeValues( dn, attribute, filter, scope );
+}
+
+
+
+QStringList LdapClient::queryRootDseAttributeValues( const QString& attribute )
+{
+	vDebug() << "called with" << attribute;
+
+	if( m_state != Bound && reconnect() == false )
+	{
+		vCritical() << "not bound to server!";
+		return {};
+	}
+
+	// the root DSE is the entry with an empty DN
+	return searchAttributeValues( {}, attribute, QStringLiteral( "(objectclass=*)" ), Scope::Base );
+}
+
+
+
+QStringList LdapClient::searchAttributeValues( const QString& dn, const QString& attribute,
+											   const QString& filter, Scope scope )
+{
 	if( attribute.isEmpty() )
 	{
 		vCritical() << "attribute is empty!";
@@ -215,6 +356,7 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 
 	int result = -1;
 	int id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList( attribute ) );
+	++m_searchRequestCount;
 
 	if( id != -1 )
 	{
@@ -260,7 +402,10 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 			// close connection and try again
 			m_queryRetry = true;
 			m_state = Disconnected;
-			entries = queryAttributeValues( dn, attribute, filter, scope );
+			if( reconnect() )
+			{
+				entries = searchAttributeValues( dn, attribute, filter, scope );
+			}
 			m_queryRetry = false;
 		}
 	}
@@ -290,6 +435,7 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 
 	int result = -1;
 	int id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList() );
+	++m_searchRequestCount;
 
 	if( id != -1 )
 	{
@@ -344,6 +490,8 @@ QStringList LdapClient::queryObjectAttributes( const QString& dn )
 		return {};
 	}
 
+	++m_searchRequestCount;
+
 	if( m_operation->waitForResult( id, LdapQueryTimeout ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
 	{
 		const auto keys = m_operation->object().attributes().keys();
@@ -91,10 +91,17 @@ public:
 
 	Objects queryObjects( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope );
 
+	// retrieves all matching objects using the paged results control and stores attribute values
+	// under the requested (instead of the server's) attribute names
+	Objects queryObjectsPaged( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope );
+
 	QStringList queryAttributeValues( const QString &dn, const QString &attribute,
 									  const QString& filter = QStringLiteral( "(objectclass=*)" ),
 									  Scope scope = Scope::Base );
 
+	// queries attribute values of the root DSE (i.e. the entry with an empty DN)
+	QStringList queryRootDseAttributeValues( const QString& attribute );
+
 	QStringList queryDistinguishedNames( const QString& dn, const QString& filter, Scope scope );
 
 	QStringList queryObjectAttributes( const QString& dn );
@@ -121,11 +128,26 @@ public:
 
 	static QStringList toRDNs( const QString& dn );
 
+	// number of search requests sent to the server (one per page for paged queries)
+	int searchRequestCount() const
+	{
+		return m_searchRequestCount;
+	}
+
+	void resetSearchRequestCount()
+	{
+		m_searchRequestCount = 0;
+	}
+
 private:
 	static constexpr int LdapQueryTimeout = 3000;
+	static constexpr int LdapPageSize = 500;
 	static constexpr int LdapConnectionTimeout = 60*1000;
 	static constexpr auto LdapLibraryDebugAny = -1;
 
+	QStringList searchAttributeValues( const QString& dn, const QString& attribute,
+									   const QString& filter, Scope scope );
+
 	bool reconnect();
 	bool connectAndBind( const QUrl& url );
 	void initTLS();
@@ -146,6 +168,7 @@ private:
 	State m_state = Disconnected;
 
 	bool m_queryRetry = false;
+	int m_searchRequestCount = 0;
 
 	QString m_baseDn;
 	QString m_namingContextAttribute;
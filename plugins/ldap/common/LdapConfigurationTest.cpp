@@ -22,9 +22,13 @@
  *
  */
 
+#include <QElapsedTimer>
+
+#include "HostAddress.h"
 #include "LdapConfiguration.h"
 #include "LdapConfigurationTest.h"
 #include "LdapDirectory.h"
+#include "LdapNetworkObjectDirectory.h"
 
 
 LdapConfigurationTest::LdapConfigurationTest( LdapConfiguration& configuration ) :
@@ -508,7 +512,10 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerObjectByIpAddre
 
 		LdapDirectory ldapDirectory( m_configuration );
 
-		QString computerName = ldapDirectory.hostToLdapFormat( computerIpAddress );
+		// blocking is fine for this interactive test while hostToLdapFormat() only uses cached lookups -
+		// converting FQDNs to the LDAP format never requires a lookup
+		const auto fqdn = HostAddress( computerIpAddress ).convert( HostAddress::Type::FullyQualifiedDomainName );
+		QString computerName = fqdn.isEmpty() ? QString() : ldapDirectory.hostToLdapFormat( fqdn );
 
 		vDebug() << "[TEST][LDAP] Resolved IP address to computer name" << computerName;
 
@@ -537,10 +544,18 @@ LdapConfigurationTest::Result LdapConfigurationTest::testLocationEntries( const
 		vDebug() << "[TEST][LDAP] Testing location entries for" << locationName;
 
 		LdapDirectory ldapDirectory( m_configuration );
-		return reportLdapObjectQueryResults( LdapConfiguration::tr( "location entries" ),
-											 { LdapConfiguration::tr( "Computer groups filter" ),
-											  LdapConfiguration::tr( "Computer locations identification") },
-											 ldapDirectory.computerLocationEntries( locationName ), ldapDirectory );
+		const auto locationEntries = ldapDirectory.computerLocationEntries( locationName );
+
+		auto result = reportLdapObjectQueryResults( LdapConfiguration::tr( "location entries" ),
+													{ LdapConfiguration::tr( "Computer groups filter" ),
+													 LdapConfiguration::tr( "Computer locations identification") },
+													locationEntries, ldapDirectory );
+		if( result )
+		{
+			result.message += QStringLiteral("\n\n") + computerQueryStatistics( ldapDirectory, locationEntries );
+		}
+
+		return result;
 	}
 
 	return invalidTestValueSuppliedResult();
@@ -644,6 +659,51 @@ LdapConfigurationTest::Result LdapConfigurationTest::reportLdapFilterTestResult(
 
 
 
+QString LdapConfigurationTest::computerQueryStatistics( LdapDirectory& directory, const QStringList& computerDns )
+{
+	auto& client = directory.client();
+	QElapsedTimer timer;
+
+	// query computer objects one by one
+	client.resetSearchRequestCount();
+	timer.start();
+
+	for( const auto& computerDn : computerDns )
+	{
+		LdapNetworkObjectDirectory::computerToObject( &directory, computerDn );
+	}
+
+	const auto individualQueryTime = timer.elapsed();
+	const auto individualQueryCount = client.searchRequestCount();
+
+	// query all computer objects at once
+	QStringList attributes{ directory.computerDisplayNameAttribute(),
+							directory.computerHostNameAttribute(),
+							directory.computerMacAddressAttribute() };
+	attributes.removeAll( {} );
+	attributes.removeDuplicates();
+
+	client.resetSearchRequestCount();
+	timer.restart();
+
+	const auto computerObjectCount = directory.computerObjects( attributes ).count();
+
+	const auto bulkQueryTime = timer.elapsed();
+	const auto bulkQueryCount = client.searchRequestCount();
+
+	vDebug() << "[TEST][LDAP] Individual queries:" << computerDns.count() << "computers,"
+			 << individualQueryCount << "search requests," << individualQueryTime << "ms";
+	vDebug() << "[TEST][LDAP] Bulk query:" << computerObjectCount << "computers,"
+			 << bulkQueryCount << "search requests," << bulkQueryTime << "ms";
+
+	return LdapConfiguration::tr( "Querying %1 computers individually took %2 ms using %3 search requests. "
+								  "Querying all %4 computers at once took %5 ms using %6 search requests." )
+			.arg( computerDns.count() ).arg( individualQueryTime ).arg( individualQueryCount )
+			.arg( computerObjectCount ).arg( bulkQueryTime ).arg( bulkQueryCount );
+}
+
+
+
 QString LdapConfigurationTest::formatResultsString( const QStringList &results )
 {
 	static constexpr auto FirstResult = 0;
@@ -81,6 +81,7 @@ public:
 									  const QStringList &results, const LdapDirectory& directory );
 	Result reportLdapFilterTestResult( const QString &filterObjects, int count, const QString &errorDescription );
 
+	static QString computerQueryStatistics( LdapDirectory& directory, const QStringList& computerDns );
 	static QString formatResultsString( const QStringList& results );
 
 	LdapConfiguration& m_configuration;
@@ -434,14 +434,56 @@ QStringList LdapDirectory::computerLocationEntries( const QString& locationName
 
 
 
+/*!
+ * \brief Returns the given attributes of all computer objects using a single paged search
+ * \param attributes Names of the attributes to query
+ * \return Map of computer DNs to attribute values
+ */
+LdapClient::Objects LdapDirectory::computerObjects( const QStringList& attributes )
+{
+	return m_client.queryObjectsPaged( computersDn(), attributes,
+									   LdapClient::constructQueryFilter( m_computerHostNameAttribute, {}, m_computersFilter ),
+									   computerSearchScope() );
+}
+
+
+
+QString LdapDirectory::changeToken()
+{
+	// Active Directory: increases with every change committed on the queried domain controller
+	const auto highestCommittedUsn = m_client.queryRootDseAttributeValues( QStringLiteral("highestCommittedUSN") ).value( 0 );
+	if( highestCommittedUsn.isEmpty() == false )
+	{
+		return QStringLiteral("usn:") + highestCommittedUsn;
+	}
+
+	// OpenLDAP with syncprov overlay: updated with every change within the naming context
+	const auto contextCsns = m_client.queryAttributeValues( m_client.baseDn(), QStringLiteral("contextCSN") );
+	if( contextCsns.isEmpty() == false )
+	{
+		return QStringLiteral("csn:") + contextCsns.join( QLatin1Char(',') );
+	}
+
+	// neither attribute is available so changes can't be detected - always perform a full refresh
+	return {};
+}
+
+
+
 QString LdapDirectory::hostToLdapFormat( const QString& host )
 {
-	if( m_computerHostNameAsFQDN )
+	const auto targetType = m_computerHostNameAsFQDN ? HostAddress::Type::FullyQualifiedDomainName
+													 : HostAddress::Type::HostName;
+
+	// do not block the calling event loop - an empty result makes the caller
+	// find no computer until the lookup finished in the background
+	QString result;
+	if( HostAddress( host ).convertCached( targetType, &result ) == false )
 	{
-		return HostAddress( host ).convert( HostAddress::Type::FullyQualifiedDomainName );
+		vDebug() << "waiting for lookup of" << host;
 	}
 
-	return HostAddress( host ).convert( HostAddress::Type::HostName );
+	return result;
 }
 
 
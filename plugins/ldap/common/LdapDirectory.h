@@ -79,6 +79,11 @@ public:
 	QString groupMemberComputerIdentification( const QString& computerDn );
 
 	QStringList computerLocationEntries( const QString& locationName );
+	LdapClient::Objects computerObjects( const QStringList& attributes );
+
+	// returns an opaque value which changes whenever the directory has been modified
+	// or an empty string if the server does not provide such information
+	QString changeToken();
 
 	QString hostToLdapFormat( const QString& host );
 	QString computerObjectFromHost( const QString& host );
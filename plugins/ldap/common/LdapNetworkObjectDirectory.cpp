@@ -22,6 +22,8 @@
  *
  */
 
+#include <QElapsedTimer>
+
 #include "LdapConfiguration.h"
 #include "LdapDirectory.h"
 #include "LdapNetworkObjectDirectory.h"
@@ -71,40 +73,65 @@ NetworkObjectList LdapNetworkObjectDirectory::queryParents( const NetworkObject&
 
 void LdapNetworkObjectDirectory::update()
 {
+	// skip refresh entirely if the server indicates that nothing has been changed
+	const auto changeToken = m_ldapDirectory.changeToken();
+	if( changeToken.isEmpty() == false && changeToken == m_changeToken )
+	{
+		return;
+	}
+
+	QElapsedTimer updateTimer;
+	updateTimer.start();
+	m_ldapDirectory.client().resetSearchRequestCount();
+
+	// fetch attributes of all computers at once instead of querying each computer individually
+	const auto computerObjects = queryComputerObjects();
+
 	const auto locations = m_ldapDirectory.computerLocations();
-	const NetworkObject rootObject( NetworkObject::Type::Root );
+
+	NetworkObjectList locationObjects;
+	locationObjects.reserve( locations.size() );
 
 	for( const auto& location : qAsConst( locations ) )
 	{
-		const NetworkObject locationObject( NetworkObject::Type::Location, location );
+		locationObjects.append( NetworkObject( NetworkObject::Type::Location, location ) );
+	}
 
-		addOrUpdateObject( locationObject, rootObject );
+	replaceObjects( locationObjects, NetworkObject( NetworkObject::Type::Root ) );
 
-		updateLocation( locationObject );
+	for( const auto& locationObject : qAsConst( locationObjects ) )
+	{
+		updateLocation( locationObject, computerObjects );
 	}
 
-	removeObjects( NetworkObject( NetworkObject::Type::Root ), [locations]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Location && locations.contains( object.name() ) == false; } );
+	m_changeToken = changeToken;
+
+	vDebug() << "updated" << computerObjects.size() << "computers in" << locationObjects.size() << "locations within"
+			 << updateTimer.elapsed() << "ms using" << m_ldapDirectory.client().searchRequestCount() << "search requests";
 }
 
 
 
-void LdapNetworkObjectDirectory::updateLocation( const NetworkObject& locationObject )
+void LdapNetworkObjectDirectory::updateLocation( const NetworkObject& locationObject,
+												  const ComputerObjects& computerObjects )
 {
 	const auto computers = m_ldapDirectory.computerLocationEntries( locationObject.name() );
 
+	NetworkObjectList hostObjects;
+	hostObjects.reserve( computers.size() );
+
 	for( const auto& computer : qAsConst( computers ) )
 	{
-		const auto hostObject = computerToObject( &m_ldapDirectory, computer );
+		// fall back to an individual query for computers outside the bulk query scope
+		const auto it = computerObjects.constFind( computer.toLower() );
+		const auto hostObject = it != computerObjects.constEnd() ? *it : computerToObject( &m_ldapDirectory, computer );
 		if( hostObject.type() == NetworkObject::Type::Host )
 		{
-			addOrUpdateObject( hostObject, locationObject );
+			hostObjects.append( hostObject );
 		}
 	}
 
-	removeObjects( locationObject, [computers]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Host &&
-			   computers.contains( object.property( NetworkObject::Property::DirectoryAddress ).toString() ) == false; } );
+	replaceObjects( hostObjects, locationObject );
 }
 
 
@@ -191,47 +218,91 @@ NetworkObjectList LdapNetworkObjectDirectory::queryHosts( NetworkObject::Propert
 
 NetworkObject LdapNetworkObjectDirectory::computerToObject( LdapDirectory* directory, const QString& computerDn )
 {
-	auto displayNameAttribute = directory->computerDisplayNameAttribute();
-	if( displayNameAttribute.isEmpty() )
+	const auto attributeNames = computerAttributeNames( directory );
+
+	const auto computers = directory->client().queryObjects( computerDn, computerAttributeList( attributeNames ),
+															 directory->computersFilter(), LdapClient::Scope::Base );
+	if( computers.isEmpty() == false )
+	{
+		return computerToObject( attributeNames, computers.firstKey(), computers.first() );
+	}
+
+	return NetworkObject( NetworkObject::Type::None );
+}
+
+
+
+LdapNetworkObjectDirectory::ComputerObjects LdapNetworkObjectDirectory::queryComputerObjects()
+{
+	const auto attributeNames = computerAttributeNames( &m_ldapDirectory );
+	const auto computers = m_ldapDirectory.computerObjects( computerAttributeList( attributeNames ) );
+
+	ComputerObjects computerObjects;
+	computerObjects.reserve( computers.size() );
+
+	for( auto it = computers.constBegin(), end = computers.constEnd(); it != end; ++it )
 	{
-		displayNameAttribute = QStringLiteral("cn");
+		// DNs are case-insensitive and may be referenced differently e.g. in group member attributes
+		computerObjects[it.key().toLower()] = computerToObject( attributeNames, it.key(), it.value() );
 	}
 
-	auto hostNameAttribute = directory->computerHostNameAttribute();
-	if( hostNameAttribute.isEmpty() )
+	return computerObjects;
+}
+
+
+
+LdapNetworkObjectDirectory::ComputerAttributeNames LdapNetworkObjectDirectory::computerAttributeNames( LdapDirectory* directory )
+{
+	ComputerAttributeNames attributeNames{ directory->computerDisplayNameAttribute(),
+										   directory->computerHostNameAttribute(),
+										   directory->computerMacAddressAttribute() };
+
+	if( attributeNames.displayName.isEmpty() )
+	{
+		attributeNames.displayName = QStringLiteral("cn");
+	}
+
+	if( attributeNames.hostName.isEmpty() )
 	{
-		hostNameAttribute = QStringLiteral("cn");
+		attributeNames.hostName = QStringLiteral("cn");
 	}
 
-	QStringList computerAttributes{ displayNameAttribute, hostNameAttribute };
+	return attributeNames;
+}
+
+
 
-	auto macAddressAttribute = directory->computerMacAddressAttribute();
-	if( macAddressAttribute.isEmpty() == false )
+QStringList LdapNetworkObjectDirectory::computerAttributeList( const ComputerAttributeNames& attributeNames )
+{
+	QStringList computerAttributes{ attributeNames.displayName, attributeNames.hostName };
+
+	if( attributeNames.macAddress.isEmpty() == false )
 	{
-		computerAttributes.append( macAddressAttribute );
+		computerAttributes.append( attributeNames.macAddress );
 	}
 
 	computerAttributes.removeDuplicates();
 
-	const auto computers = directory->client().queryObjects( computerDn, computerAttributes,
-															 directory->computersFilter(), LdapClient::Scope::Base );
-	if( computers.isEmpty() == false )
-	{
-		const auto& computerDn = computers.firstKey();
-		const auto& computer = computers.first();
-		const auto displayName = computer[displayNameAttribute].value( 0 );
-		NetworkObject::Properties properties;
-		properties[NetworkObject::propertyKey(NetworkObject::Property::HostAddress)] =
-			computer[hostNameAttribute].value( 0 );
-		if( macAddressAttribute.isEmpty() == false )
-		{
-			properties[NetworkObject::propertyKey(NetworkObject::Property::MacAddress)] =
-				computer[macAddressAttribute].value( 0 );
-		}
-		properties[NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress)] = computerDn;
+	return computerAttributes;
+}
+
 
-		return NetworkObject{ NetworkObject::Type::Host, displayName, properties };
+
+NetworkObject LdapNetworkObjectDirectory::computerToObject( const ComputerAttributeNames& attributeNames,
+															const QString& computerDn,
+															const QMap<QString, QStringList>& computer )
+{
+	const auto displayName = computer.value( attributeNames.displayName ).value( 0 );
+
+	NetworkObject::Properties properties;
+	properties[NetworkObject::propertyKey(NetworkObject::Property::HostAddress)] =
+		computer.value( attributeNames.hostName ).value( 0 );
+	if( attributeNames.macAddress.isEmpty() == false )
+	{
+		properties[NetworkObject::propertyKey(NetworkObject::Property::MacAddress)] =
+			computer.value( attributeNames.macAddress ).value( 0 );
 	}
+	properties[NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress)] = computerDn;
 
-	return NetworkObject( NetworkObject::Type::None );
+	return NetworkObject{ NetworkObject::Type::Host, displayName, properties };
 }
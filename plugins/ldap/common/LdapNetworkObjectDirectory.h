@@ -40,11 +40,28 @@ public:
 	static NetworkObject computerToObject( LdapDirectory* directory, const QString& computerDn );
 
 private:
+	using ComputerObjects = QHash<QString, NetworkObject>;
+
+	struct ComputerAttributeNames
+	{
+		QString displayName;
+		QString hostName;
+		QString macAddress;
+	};
+
 	void update() override;
-	void updateLocation( const NetworkObject& locationObject );
+	void updateLocation( const NetworkObject& locationObject, const ComputerObjects& computerObjects );
+
+	ComputerObjects queryComputerObjects();
+
+	static ComputerAttributeNames computerAttributeNames( LdapDirectory* directory );
+	static QStringList computerAttributeList( const ComputerAttributeNames& attributeNames );
+	static NetworkObject computerToObject( const ComputerAttributeNames& attributeNames, const QString& computerDn,
+										   const QMap<QString, QStringList>& computer );
 
 	NetworkObjectList queryLocations( NetworkObject::Property property, const QVariant& value );
 	NetworkObjectList queryHosts( NetworkObject::Property property, const QVariant& value );
 
 	LdapDirectory m_ldapDirectory;
+	QString m_changeToken;
 };
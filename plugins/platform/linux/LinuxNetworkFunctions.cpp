@@ -51,6 +51,20 @@ bool LinuxNetworkFunctions::configureFirewallException( const QString& applicati
 
 
 
+bool LinuxNetworkFunctions::configureFirewallPortException( const QString& description, Protocol protocol,
+															int firstPort, int lastPort, bool enabled )
+{
+	Q_UNUSED(description)
+	Q_UNUSED(protocol)
+	Q_UNUSED(firstPort)
+	Q_UNUSED(lastPort)
+	Q_UNUSED(enabled)
+
+	return true;
+}
+
+
+
 bool LinuxNetworkFunctions::configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes )
 {
 	int optval;
@@ -30,6 +30,8 @@
 
 #include <QProcess>
 
+#include <functional>
+
 #include "WindowsCoreFunctions.h"
 #include "WindowsNetworkFunctions.h"
 
@@ -62,13 +64,16 @@ static void WindowsFirewallCleanup2( INetFwPolicy2* fwPolicy2 )
 
 static HRESULT WindowsFirewallAddApp2( INetFwPolicy2* fwPolicy2,
 									   const wchar_t* fwApplicationPath,
-									   const wchar_t* fwName )
+									   const wchar_t* fwName,
+									   NET_FW_IP_PROTOCOL fwProtocol,
+									   const wchar_t* fwLocalPorts )
 {
 	HRESULT hr = S_OK;
 	BSTR fwBstrRuleName = nullptr;
 	BSTR fwBstrApplicationPath = nullptr;
 	BSTR fwBstrRuleDescription = nullptr;
 	BSTR fwBstrRuleGrouping = nullptr;
+	BSTR fwBstrLocalPorts = nullptr;
 
 	INetFwRules *pFwRules = nullptr;
 	INetFwRule *pFwRule = nullptr;
@@ -92,21 +97,32 @@ static HRESULT WindowsFirewallAddApp2( INetFwPolicy2* fwPolicy2,
 	}
 
 	fwBstrRuleName = SysAllocString( fwName );
-	fwBstrApplicationPath = SysAllocString( fwApplicationPath );
 	fwBstrRuleDescription = SysAllocString( fwName );
 	fwBstrRuleGrouping = SysAllocString( fwName );
 
 	// Set the rule
 	pFwRule->put_Name( fwBstrRuleName );
-	pFwRule->put_ApplicationName( fwBstrApplicationPath );
 	pFwRule->put_Description( fwBstrRuleDescription );
 	pFwRule->put_Grouping( fwBstrRuleGrouping );
 
+	if( fwApplicationPath )
+	{
+		fwBstrApplicationPath = SysAllocString( fwApplicationPath );
+		pFwRule->put_ApplicationName( fwBstrApplicationPath );
+	}
+
 	pFwRule->put_Action( NET_FW_ACTION_ALLOW );
 	pFwRule->put_Enabled( VARIANT_TRUE );
-	pFwRule->put_Protocol( NET_FW_IP_PROTOCOL_TCP );
+	// local ports can only be set after the protocol
+	pFwRule->put_Protocol( fwProtocol );
 	pFwRule->put_Profiles( NET_FW_PROFILE2_ALL );
 
+	if( fwLocalPorts )
+	{
+		fwBstrLocalPorts = SysAllocString( fwLocalPorts );
+		pFwRule->put_LocalPorts( fwBstrLocalPorts );
+	}
+
 
 	// Add the application to the collection.
 	hr = pFwRules->Add( pFwRule );
@@ -122,6 +138,7 @@ cleanup:
 	SysFreeString( fwBstrApplicationPath );
 	SysFreeString( fwBstrRuleDescription );
 	SysFreeString( fwBstrRuleGrouping );
+	SysFreeString( fwBstrLocalPorts );
 
 	if( pFwRule != nullptr )
 	{
@@ -176,7 +193,8 @@ cleanup:
 
 
 
-static bool configureFirewallException( INetFwPolicy2* fwPolicy2, const wchar_t* fwApplicationPath, const wchar_t* fwName, bool enabled )
+static bool configureFirewallException( INetFwPolicy2* fwPolicy2, const wchar_t* fwApplicationPath, const wchar_t* fwName,
+										NET_FW_IP_PROTOCOL fwProtocol, const wchar_t* fwLocalPorts, bool enabled )
 {
 	// always remove firewall exception first
 	WindowsFirewallRemoveApp2( fwPolicy2, fwName );
@@ -184,7 +202,7 @@ static bool configureFirewallException( INetFwPolicy2* fwPolicy2, const wchar_t*
 	if( enabled )
 	{
 		// add service to the list of authorized applications
-		const auto hr = WindowsFirewallAddApp2( fwPolicy2, fwApplicationPath, fwName );
+		const auto hr = WindowsFirewallAddApp2( fwPolicy2, fwApplicationPath, fwName, fwProtocol, fwLocalPorts );
 		if( hr != S_OK )
 		{
 			// failed because firewall service not running / disabled?
@@ -206,18 +224,7 @@ static bool configureFirewallException( INetFwPolicy2* fwPolicy2, const wchar_t*
 
 
 
-bool WindowsNetworkFunctions::ping( const QString& hostAddress )
-{
-	QProcess pingProcess;
-	pingProcess.start( QStringLiteral("ping"), { QStringLiteral("-n"), QStringLiteral("1"), QStringLiteral("-w"), QString::number( PingTimeout ), hostAddress } );
-	pingProcess.waitForFinished( PingProcessTimeout );
-
-	return pingProcess.exitCode() == 0;
-}
-
-
-
-bool WindowsNetworkFunctions::configureFirewallException( const QString& applicationPath, const QString& description, bool enabled )
+static bool configureFirewall( const std::function<bool(INetFwPolicy2 *)>& configure )
 {
 	HRESULT hr = S_OK;
 
@@ -246,10 +253,7 @@ bool WindowsNetworkFunctions::configureFirewallException( const QString& applica
 		return false;
 	}
 
-	bool result = ::configureFirewallException( fwPolicy2,
-												WindowsCoreFunctions::toConstWCharArray( applicationPath ),
-												WindowsCoreFunctions::toConstWCharArray( description ),
-												enabled );
+	bool result = configure( fwPolicy2 );
 
 	WindowsFirewallCleanup2( fwPolicy2 );
 
@@ -264,6 +268,45 @@ bool WindowsNetworkFunctions::configureFirewallException( const QString& applica
 
 
 
+bool WindowsNetworkFunctions::ping( const QString& hostAddress )
+{
+	QProcess pingProcess;
+	pingProcess.start( QStringLiteral("ping"), { QStringLiteral("-n"), QStringLiteral("1"), QStringLiteral("-w"), QString::number( PingTimeout ), hostAddress } );
+	pingProcess.waitForFinished( PingProcessTimeout );
+
+	return pingProcess.exitCode() == 0;
+}
+
+
+
+bool WindowsNetworkFunctions::configureFirewallException( const QString& applicationPath, const QString& description, bool enabled )
+{
+	return configureFirewall( [&]( INetFwPolicy2* fwPolicy2 ) {
+		return ::configureFirewallException( fwPolicy2,
+											 WindowsCoreFunctions::toConstWCharArray( applicationPath ),
+											 WindowsCoreFunctions::toConstWCharArray( description ),
+											 NET_FW_IP_PROTOCOL_TCP, nullptr, enabled );
+	} );
+}
+
+
+
+bool WindowsNetworkFunctions::configureFirewallPortException( const QString& description, Protocol protocol,
+															  int firstPort, int lastPort, bool enabled )
+{
+	const auto localPorts = QStringLiteral("%1-%2").arg( firstPort ).arg( lastPort );
+
+	return configureFirewall( [&]( INetFwPolicy2* fwPolicy2 ) {
+		return ::configureFirewallException( fwPolicy2, nullptr,
+											 WindowsCoreFunctions::toConstWCharArray( description ),
+											 protocol == Protocol::UDP ? NET_FW_IP_PROTOCOL_UDP : NET_FW_IP_PROTOCOL_TCP,
+											 WindowsCoreFunctions::toConstWCharArray( localPorts ),
+											 enabled );
+	} );
+}
+
+
+
 bool WindowsNetworkFunctions::configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes )
 {
 	Q_UNUSED(probes)
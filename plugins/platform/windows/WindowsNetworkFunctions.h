@@ -33,6 +33,8 @@ class WindowsNetworkFunctions : public PlatformNetworkFunctions
 public:
 	bool ping( const QString& hostAddress ) override;
 	bool configureFirewallException( const QString& applicationPath, const QString& description, bool enabled ) override;
+	bool configureFirewallPortException( const QString& description, Protocol protocol,
+										 int firstPort, int lastPort, bool enabled ) override;
 
 	bool configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes ) override;
 
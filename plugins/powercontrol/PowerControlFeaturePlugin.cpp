@@ -23,7 +23,6 @@
  */
 
 #include <QMessageBox>
-#include <QNetworkInterface>
 #include <QProgressBar>
 #include <QProgressDialog>
 #include <QUdpSocket>
@@ -38,6 +37,7 @@
 #include "VeyonConfiguration.h"
 #include "VeyonMasterInterface.h"
 #include "VeyonServerInterface.h"
+#include "WakeOnLanScheduler.h"
 
 
 PowerControlFeaturePlugin::PowerControlFeaturePlugin( QObject* parent ) :
@@ -128,10 +128,7 @@ bool PowerControlFeaturePlugin::controlFeature( Feature::Uid featureUid,
 
 	if( featureUid == m_powerOnFeature.uid() )
 	{
-		for( const auto& controlInterface : computerControlInterfaces )
-		{
-			broadcastWOLPacket( controlInterface->computer().macAddress() );
-		}
+		wakeOnLanScheduler()->wake( computerControlInterfaces );
 	}
 	else if( featureUid == m_powerDownDelayedFeature.uid() )
 	{
@@ -156,7 +153,9 @@ bool PowerControlFeaturePlugin::startFeature( VeyonMasterInterface& master, cons
 {
 	if( feature == m_powerOnFeature )
 	{
-		return controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces );
+		const auto result = controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces );
+		showWakeOnLanProgress( master.mainWindow() );
+		return result;
 	}
 
 	if( feature == m_powerDownDelayedFeature )
@@ -315,65 +314,72 @@ bool PowerControlFeaturePlugin::confirmFeatureExecution( const Feature& feature,
 
 
 
-bool PowerControlFeaturePlugin::broadcastWOLPacket( QString macAddress )
+bool PowerControlFeaturePlugin::broadcastWOLPacket( const QString& macAddress )
 {
-	static constexpr size_t MAC_SIZE = 6;
-	std::array<uint, MAC_SIZE> mac{};
-
-	if( macAddress.isEmpty() )
+	const auto datagram = WakeOnLanScheduler::magicPacket( macAddress );
+	if( datagram.isEmpty() )
 	{
+		CommandLineIO::error( tr( "Invalid MAC address specified!" ) );
 		return false;
 	}
 
-	const auto originalMacAddress = macAddress;
-
-	// remove all possible delimiters
-	macAddress.replace( QLatin1Char(':'), QString() );
-	macAddress.replace( QLatin1Char('-'), QString() );
-	macAddress.replace( QLatin1Char('.'), QString() );
-
-	if( sscanf( macAddress.toUtf8().constData(),
-				"%2x%2x%2x%2x%2x%2x",
-				&mac[0],
-				&mac[1],
-				&mac[2],
-				&mac[3],
-				&mac[4],
-				&mac[5] ) != MAC_SIZE )
+	QUdpSocket udpSocket;
+
+	bool success = true;
+
+	const auto addresses = WakeOnLanScheduler::localBroadcastAddresses();
+	for( const auto& address : addresses )
 	{
-		CommandLineIO::error( tr( "Invalid MAC address specified!" ) );
-		vWarning() << "invalid MAC address" << originalMacAddress;
-		return false;
+		success &= ( udpSocket.writeDatagram( datagram, address, WakeOnLanScheduler::Port ) == datagram.size() );
 	}
 
-	QByteArray datagram( MAC_SIZE*17, static_cast<char>( 0xff ) );
+	return success;
+}
 
-	for( size_t i = 1; i < 17; ++i )
+
+
+WakeOnLanScheduler* PowerControlFeaturePlugin::wakeOnLanScheduler()
+{
+	if( m_wakeOnLanScheduler == nullptr )
 	{
-		for( size_t j = 0; j < MAC_SIZE; ++j )
-		{
-			datagram[uint(i*MAC_SIZE+j)] = static_cast<char>( mac.at(j) );
-		}
+		m_wakeOnLanScheduler = new WakeOnLanScheduler( this );
 	}
 
-	QUdpSocket udpSocket;
+	return m_wakeOnLanScheduler;
+}
 
-	bool success = ( udpSocket.writeDatagram( datagram, QHostAddress::Broadcast, 9 ) == datagram.size() );
 
-	const auto networkInterfaces = QNetworkInterface::allInterfaces();
-	for( const auto& networkInterface : networkInterfaces )
+
+void PowerControlFeaturePlugin::showWakeOnLanProgress( QWidget* parent )
+{
+	auto scheduler = wakeOnLanScheduler();
+	if( scheduler->isActive() == false || parent->findChild<QProgressDialog *>( QStringLiteral("WakeOnLanProgressDialog") ) )
 	{
-		const auto addressEntries = networkInterface.addressEntries();
-		for( const auto& addressEntry : addressEntries )
-		{
-			if( addressEntry.broadcast().isNull() == false )
-			{
-				success &= ( udpSocket.writeDatagram( datagram, addressEntry.broadcast(), 9 ) == datagram.size() );
-			}
-		}
+		return;
 	}
 
-	return success;
+	auto dialog = new QProgressDialog( parent );
+	dialog->setObjectName( QStringLiteral("WakeOnLanProgressDialog") );
+	dialog->setWindowTitle( m_powerOnFeature.displayName() );
+	dialog->setAttribute( Qt::WA_DeleteOnClose );
+	dialog->setAutoClose( false );
+	dialog->setAutoReset( false );
+	dialog->setMinimumDuration( 0 );
+
+	const auto update = [scheduler, dialog]() {
+		dialog->setMaximum( scheduler->totalCount() );
+		dialog->setValue( scheduler->onlineCount() );
+		dialog->setLabelText( tr( "Powering on %1 computers: %2 Wake-on-LAN packets sent, %3 computers online" ).
+							  arg( scheduler->totalCount() ).arg( scheduler->sentCount() ).arg( scheduler->onlineCount() ) );
+	};
+
+	update();
+
+	connect( scheduler, &WakeOnLanScheduler::progressChanged, dialog, update );
+	connect( scheduler, &WakeOnLanScheduler::finished, dialog, &QProgressDialog::close );
+	connect( dialog, &QProgressDialog::canceled, scheduler, &WakeOnLanScheduler::cancel );
+
+	dialog->show();
 }
 
 
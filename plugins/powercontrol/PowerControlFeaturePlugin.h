@@ -29,6 +29,8 @@
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
+class WakeOnLanScheduler;
+
 class PowerControlFeaturePlugin : public QObject,
 		PluginInterface,
 		CommandLineIO,
@@ -111,7 +113,9 @@ public Q_SLOTS:
 
 private:
 	bool confirmFeatureExecution( const Feature& feature, QWidget* parent );
-	static bool broadcastWOLPacket( QString macAddress );
+	static bool broadcastWOLPacket( const QString& macAddress );
+	WakeOnLanScheduler* wakeOnLanScheduler();
+	void showWakeOnLanProgress( QWidget* parent );
 
 	void confirmShutdown();
 	void displayShutdownTimeout( int shutdownTimeout );
@@ -127,4 +131,6 @@ private:
 	const Feature m_powerDownDelayedFeature;
 	const FeatureList m_features;
 
+	WakeOnLanScheduler* m_wakeOnLanScheduler{nullptr};
+
 };
@@ -0,0 +1,318 @@
+/*
+ * WakeOnLanScheduler.cpp - implementation of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <algorithm>
+
+#include <QNetworkInterface>
+
+#include "HostResolver.h"
+#include "VeyonConfiguration.h"
+#include "WakeOnLanScheduler.h"
+
+
+WakeOnLanScheduler::WakeOnLanScheduler( QObject* parent ) :
+	QObject( parent )
+{
+	m_waveTimer.setInterval( 1000 / WavesPerSecond );
+	m_stateCheckTimer.setInterval( StateCheckInterval );
+
+	m_clock.start();
+
+	connect( &m_waveTimer, &QTimer::timeout, this, &WakeOnLanScheduler::sendWave );
+	connect( &m_stateCheckTimer, &QTimer::timeout, this, &WakeOnLanScheduler::checkTargets );
+}
+
+
+
+void WakeOnLanScheduler::wake( const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	if( isActive() == false )
+	{
+		m_targets.clear();
+		m_queue.clear();
+		m_waveBudget = 0;
+		m_sentCount = 0;
+		m_onlineCount = 0;
+
+		const auto& config = VeyonCore::config();
+		m_hostsPerSecond = qMax( 1, config.wakeOnLanHostsPerSecond() );
+		m_retryCount = qMax( 0, config.wakeOnLanRetryCount() );
+		m_retryInterval = qMax( 1, config.wakeOnLanRetryInterval() ) * 1000;
+		m_subnetPrefixLength = qBound( 0, config.wakeOnLanSubnetPrefixLength(), 31 );
+
+		m_broadcastAddresses = localBroadcastAddresses();
+	}
+
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		const auto alreadyScheduled = std::any_of( m_targets.constBegin(), m_targets.constEnd(),
+												   [&controlInterface]( const Target& target ) {
+			return target.done == false && target.controlInterface == controlInterface;
+		} );
+		if( alreadyScheduled )
+		{
+			continue;
+		}
+
+		Target target;
+		target.controlInterface = controlInterface;
+		target.packet = magicPacket( controlInterface->computer().macAddress() );
+		if( target.packet.isEmpty() )
+		{
+			continue;
+		}
+
+		// resolve in advance so directed broadcasts do not block the waves
+		if( m_subnetPrefixLength > 0 )
+		{
+			target.ipAddress = VeyonCore::hostResolver().convert( controlInterface->computer().hostAddress(),
+																	HostAddress::Type::IpAddress );
+		}
+
+		target.queued = true;
+		m_queue.enqueue( m_targets.count() );
+		m_targets.append( target );
+	}
+
+	if( m_queue.isEmpty() == false )
+	{
+		if( m_waveTimer.isActive() == false )
+		{
+			m_waveTimer.start();
+		}
+
+		if( isActive() == false )
+		{
+			m_stateCheckTimer.start();
+		}
+	}
+
+	Q_EMIT progressChanged();
+
+	if( isActive() == false )
+	{
+		Q_EMIT finished();
+	}
+}
+
+
+
+void WakeOnLanScheduler::cancel()
+{
+	if( isActive() )
+	{
+		m_waveTimer.stop();
+		m_stateCheckTimer.stop();
+		m_queue.clear();
+
+		Q_EMIT finished();
+	}
+}
+
+
+
+QByteArray WakeOnLanScheduler::magicPacket( const QString& macAddress )
+{
+	static constexpr int MacSize = 6;
+	static constexpr int Repetitions = 16;
+
+	auto hexDigits = macAddress;
+
+	// remove all possible delimiters
+	hexDigits.remove( QLatin1Char(':') );
+	hexDigits.remove( QLatin1Char('-') );
+	hexDigits.remove( QLatin1Char('.') );
+
+	const auto mac = QByteArray::fromHex( hexDigits.toLatin1() );
+	if( hexDigits.size() != MacSize*2 || mac.size() != MacSize )
+	{
+		vWarning() << "invalid MAC address" << macAddress;
+		return {};
+	}
+
+	return QByteArray( MacSize, static_cast<char>( 0xff ) ) + mac.repeated( Repetitions );
+}
+
+
+
+QList<QHostAddress> WakeOnLanScheduler::localBroadcastAddresses()
+{
+	QList<QHostAddress> addresses{ QHostAddress::Broadcast };
+
+	const auto networkInterfaces = QNetworkInterface::allInterfaces();
+	for( const auto& networkInterface : networkInterfaces )
+	{
+		const auto addressEntries = networkInterface.addressEntries();
+		for( const auto& addressEntry : addressEntries )
+		{
+			if( addressEntry.broadcast().isNull() == false && addresses.contains( addressEntry.broadcast() ) == false )
+			{
+				addresses.append( addressEntry.broadcast() );
+			}
+		}
+	}
+
+	return addresses;
+}
+
+
+
+void WakeOnLanScheduler::sendWave()
+{
+	// distribute the hosts per second evenly across all waves
+	m_waveBudget += m_hostsPerSecond;
+	auto count = m_waveBudget / WavesPerSecond;
+	m_waveBudget %= WavesPerSecond;
+
+	while( count > 0 && m_queue.isEmpty() == false )
+	{
+		auto& target = m_targets[m_queue.dequeue()];
+		target.queued = false;
+
+		const auto controlInterface = target.controlInterface.toStrongRef();
+		if( controlInterface && controlInterface->state() == ComputerControlInterface::State::Connected )
+		{
+			continue;
+		}
+
+		send( target );
+		--count;
+	}
+
+	// the states of the targets are checked separately in larger intervals
+	if( m_queue.isEmpty() )
+	{
+		m_waveTimer.stop();
+	}
+
+	Q_EMIT progressChanged();
+}
+
+
+
+void WakeOnLanScheduler::send( Target& target )
+{
+	auto addresses = m_broadcastAddresses;
+
+	const auto directedBroadcast = directedBroadcastAddress( target );
+	if( directedBroadcast.isNull() == false && addresses.contains( directedBroadcast ) == false )
+	{
+		addresses.prepend( directedBroadcast );
+	}
+
+	for( const auto& address : qAsConst(addresses) )
+	{
+		if( m_socket.writeDatagram( target.packet, address, Port ) != target.packet.size() )
+		{
+			vWarning() << "failed to send Wake-on-LAN packet to" << address << m_socket.errorString();
+		}
+	}
+
+	if( target.attempts == 0 )
+	{
+		++m_sentCount;
+	}
+
+	++target.attempts;
+	target.retryTime = m_clock.elapsed() + m_retryInterval;
+}
+
+
+
+void WakeOnLanScheduler::checkTargets()
+{
+	auto pending = m_queue.isEmpty() == false;
+
+	for( int i = 0; i < m_targets.count(); ++i )
+	{
+		auto& target = m_targets[i];
+		if( target.done || target.queued )
+		{
+			pending |= target.queued;
+			continue;
+		}
+
+		const auto controlInterface = target.controlInterface.toStrongRef();
+		if( controlInterface.isNull() )
+		{
+			target.done = true;
+		}
+		else if( controlInterface->state() == ComputerControlInterface::State::Connected )
+		{
+			target.done = true;
+			++m_onlineCount;
+		}
+		else if( m_clock.elapsed() >= target.retryTime )
+		{
+			if( target.attempts <= m_retryCount )
+			{
+				target.queued = true;
+				m_queue.enqueue( i );
+				pending = true;
+
+				if( m_waveTimer.isActive() == false )
+				{
+					m_waveTimer.start();
+				}
+			}
+			else
+			{
+				target.done = true;
+			}
+		}
+		else
+		{
+			pending = true;
+		}
+	}
+
+	Q_EMIT progressChanged();
+
+	if( pending == false )
+	{
+		m_waveTimer.stop();
+		m_stateCheckTimer.stop();
+		Q_EMIT finished();
+	}
+}
+
+
+
+QHostAddress WakeOnLanScheduler::directedBroadcastAddress( const Target& target ) const
+{
+	if( m_subnetPrefixLength <= 0 || target.ipAddress.isFinished() == false || target.ipAddress.resultCount() == 0 )
+	{
+		return {};
+	}
+
+	const QHostAddress hostAddress( target.ipAddress.result() );
+	if( hostAddress.protocol() != QAbstractSocket::IPv4Protocol )
+	{
+		return {};
+	}
+
+	const auto hostMask = ~quint32(0) >> m_subnetPrefixLength;
+
+	return QHostAddress( hostAddress.toIPv4Address() | hostMask );
+}
@@ -0,0 +1,113 @@
+/*
+ * WakeOnLanScheduler.h - declaration of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHostAddress>
+#include <QQueue>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include "ComputerControlInterface.h"
+
+// sends Wake-on-LAN packets in paced waves through a single socket and resends them
+// to computers which do not come online within the configured retry interval
+class WakeOnLanScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr quint16 Port = 9;
+	static constexpr int WavesPerSecond = 4;
+	static constexpr int StateCheckInterval = 1000;
+
+	explicit WakeOnLanScheduler( QObject* parent = nullptr );
+	~WakeOnLanScheduler() override = default;
+
+	void wake( const ComputerControlInterfaceList& computerControlInterfaces );
+	void cancel();
+
+	bool isActive() const
+	{
+		return m_stateCheckTimer.isActive();
+	}
+
+	int totalCount() const
+	{
+		return m_targets.count();
+	}
+
+	int sentCount() const
+	{
+		return m_sentCount;
+	}
+
+	int onlineCount() const
+	{
+		return m_onlineCount;
+	}
+
+	static QByteArray magicPacket( const QString& macAddress );
+	static QList<QHostAddress> localBroadcastAddresses();
+
+Q_SIGNALS:
+	void progressChanged();
+	void finished();
+
+private:
+	struct Target
+	{
+		QWeakPointer<ComputerControlInterface> controlInterface;
+		QByteArray packet;
+		QFuture<QString> ipAddress;
+		qint64 retryTime{0}; // milliseconds on m_clock
+		int attempts{0};
+		bool queued{false};
+		bool done{false};
+	};
+
+	void sendWave();
+	void send( Target& target );
+	void checkTargets();
+	QHostAddress directedBroadcastAddress( const Target& target ) const;
+
+	QUdpSocket m_socket{this};
+	QTimer m_waveTimer{this};
+	QTimer m_stateCheckTimer{this};
+	QElapsedTimer m_clock{};
+	QList<QHostAddress> m_broadcastAddresses{};
+
+	QVector<Target> m_targets{};
+	QQueue<int> m_queue{};
+	int m_waveBudget{0};
+	int m_sentCount{0};
+	int m_onlineCount{0};
+
+	int m_hostsPerSecond{1};
+	int m_retryCount{0};
+	int m_retryInterval{0};
+	int m_subnetPrefixLength{0};
+
+} ;
@@ -22,7 +22,10 @@
  *
  */
 
+#include <QFutureWatcher>
 #include <QMessageBox>
+#include <QProgressDialog>
+#include <QtConcurrent>
 
 #include "ComputerControlInterface.h"
 #include "Screenshot.h"
@@ -65,10 +68,7 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 
 	if( hasFeature( featureUid ) && operation == Operation::Start )
 	{
-		for( const auto& controlInterface : computerControlInterfaces )
-		{
-			Screenshot().take( controlInterface );
-		}
+		takeScreenshots( computerControlInterfaces );
 
 		return true;
 	}
@@ -81,17 +81,78 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const Feature& feature,
 											const ComputerControlInterfaceList& computerControlInterfaces )
 {
-	if( controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces ) )
+	if( hasFeature( feature.uid() ) == false )
 	{
-		QMessageBox::information( master.mainWindow(),
+		return false;
+	}
+
+	const auto screenshotJobs = takeScreenshots( computerControlInterfaces );
+	const auto mainWindow = master.mainWindow();
+
+	const auto showResult = [=]( int count ) {
+		QMessageBox::information( mainWindow,
 								  tr( "Screenshots taken" ),
-								  tr( "Screenshot of %1 computer have been taken successfully." ).
-								  arg( computerControlInterfaces.count() ) );
+								  tr( "Screenshot of %1 computer have been taken successfully." ).arg( count ) );
+	};
 
+	if( screenshotJobs.isEmpty() )
+	{
+		showResult( 0 );
 		return true;
 	}
 
-	return false;
+	// report progress without blocking the UI while screenshots are being encoded and saved in background
+	auto progressDialog = new QProgressDialog( tr( "Saving screenshots..." ), {}, 0, screenshotJobs.count(), mainWindow );
+	progressDialog->setWindowTitle( tr( "Screenshot" ) );
+	progressDialog->setAttribute( Qt::WA_DeleteOnClose );
+	progressDialog->setAutoReset( false );
+	progressDialog->setAutoClose( false );
+	progressDialog->setMinimumDuration( ProgressDialogMinimumDuration );
+	progressDialog->setValue( 0 );
+
+	auto savedCount = QSharedPointer<int>::create( 0 );
+
+	for( const auto& screenshotJob : screenshotJobs )
+	{
+		auto watcher = new QFutureWatcher<bool>( progressDialog );
+		connect( watcher, &QFutureWatcher<bool>::finished, progressDialog, [=]() {
+			if( watcher->result() )
+			{
+				++(*savedCount);
+			}
+
+			progressDialog->setValue( progressDialog->value() + 1 );
+			if( progressDialog->value() >= progressDialog->maximum() )
+			{
+				progressDialog->close();
+				showResult( *savedCount );
+			}
+		} );
+		watcher->setFuture( screenshotJob );
+	}
+
+	return true;
+}
+
+
+
+QList<QFuture<bool>> ScreenshotFeaturePlugin::takeScreenshots( const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	QList<QFuture<bool>> screenshotJobs;
+	screenshotJobs.reserve( computerControlInterfaces.size() );
+
+	// grab all screens at once so all screenshots reflect the same point of time
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		auto screenshot = QSharedPointer<Screenshot>::create();
+		if( screenshot->capture( controlInterface ) )
+		{
+			// drawing the caption and encoding the image is expensive so do it in parallel
+			screenshotJobs.append( QtConcurrent::run( [screenshot]() { return screenshot->save(); } ) );
+		}
+	}
+
+	return screenshotJobs;
 }
 
 
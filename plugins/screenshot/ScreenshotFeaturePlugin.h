@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QFuture>
+
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
@@ -76,8 +78,12 @@ public:
 
 
 private:
+	static constexpr auto ProgressDialogMinimumDuration = 500;
+
 	void initUi();
 
+	QList<QFuture<bool>> takeScreenshots( const ComputerControlInterfaceList& computerControlInterfaces );
+
 	const Feature m_screenshotFeature;
 	const FeatureList m_features;
 
@@ -22,9 +22,611 @@
  *
  */
 
+#include "rfb/rfbproto.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QQueue>
+#include <QReadWriteLock>
+#include <QSortFilterProxyModel>
+#include <QStandardItemModel>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtEndian>
+
 #include "CommandLineIO.h"
 #include "AccessControlProvider.h"
+#include "AuthenticationManager.h"
+#include "CheckableItemProxyModel.h"
+#include "ComputerControlInterface.h"
+#include "DemoAuthentication.h"
+#include "DemoConfiguration.h"
+#include "DemoFramebufferSource.h"
+#include "DemoMulticastClient.h"
+#include "DemoMulticastProtocol.h"
+#include "DemoMulticastServer.h"
+#include "EnumHelper.h"
+#include "HostResolver.h"
+#include "NetworkObjectDirectory.h"
 #include "TestingCommandLinePlugin.h"
+#include "VeyonConfiguration.h"
+#include "VeyonConnection.h"
+#include "VncClientProtocol.h"
+#include "VncConnection.h"
+#include "VncProxyConnection.h"
+#include "VncProxyConnectionFactory.h"
+#include "VncProxyServer.h"
+#include "VncServerClient.h"
+#include "VncServerProtocol.h"
+
+
+class BenchmarkNetworkObjectDirectory : public NetworkObjectDirectory
+{
+public:
+	explicit BenchmarkNetworkObjectDirectory( QObject* parent ) :
+		NetworkObjectDirectory( parent )
+	{
+	}
+
+	void populate( int locationCount, int hostsPerLocation )
+	{
+		const NetworkObject rootObject( NetworkObject::Type::Root );
+
+		for( int l = 0; l < locationCount; ++l )
+		{
+			const NetworkObject location( NetworkObject::Type::Location, QStringLiteral("Location %1").arg( l ) );
+			addOrUpdateObject( location, rootObject );
+
+			for( int h = 0; h < hostsPerLocation; ++h )
+			{
+				addOrUpdateObject( NetworkObject( NetworkObject::Type::Host,
+												  QStringLiteral("Host %1-%2").arg( l ).arg( h ),
+												  { { NetworkObject::propertyKey( NetworkObject::Property::HostAddress ),
+													  QStringLiteral("10.%1.%2.%3").arg( l / 256 ).arg( l % 256 ).arg( h ) } },
+												  {}, location.uid() ),
+								   location );
+			}
+		}
+	}
+
+	void update() override
+	{
+	}
+
+};
+
+
+
+// minimal RFB server without authentication which changes a small block of pixels in fixed intervals
+// and sends raw encoded updates on request - continuous updates and fences are provided by the
+// VncProxyConnection in front of it the same way as in the Veyon server
+class BenchmarkFramebufferSource : public QObject
+{
+public:
+	static constexpr int FramebufferWidth = 640;
+	static constexpr int FramebufferHeight = 480;
+	static constexpr int BlockSize = 64;
+	static constexpr int FrameCount = 0x10000;
+
+	explicit BenchmarkFramebufferSource( int frameInterval, QObject* parent = nullptr ) :
+		QObject( parent ),
+		m_frameTimes( FrameCount, 0 )
+	{
+		m_clock.start();
+
+		connect( &m_server, &QTcpServer::newConnection, this, &BenchmarkFramebufferSource::acceptConnection );
+
+		m_frameTimer.setTimerType( Qt::PreciseTimer );
+		m_frameTimer.setInterval( frameInterval );
+		connect( &m_frameTimer, &QTimer::timeout, this, &BenchmarkFramebufferSource::produceFrame );
+	}
+
+	bool listen()
+	{
+		return m_server.listen( QHostAddress::LocalHost );
+	}
+
+	quint16 port() const
+	{
+		return m_server.serverPort();
+	}
+
+	qint64 elapsed() const
+	{
+		return m_clock.nsecsElapsed();
+	}
+
+	qint64 frameTime( int frame )
+	{
+		QMutexLocker locker( &m_frameTimesMutex );
+		return m_frameTimes.value( frame % FrameCount );
+	}
+
+	static int frameFromPixel( QRgb pixel )
+	{
+		return qRed( pixel ) | ( qGreen( pixel ) << 8 );
+	}
+
+private:
+	enum class Stage
+	{
+		Version,
+		Security,
+		ClientInit,
+		Running
+	};
+
+	void acceptConnection()
+	{
+		auto socket = m_server.nextPendingConnection();
+		if( m_socket )
+		{
+			delete socket;
+			return;
+		}
+
+		m_socket = socket;
+		m_socket->setParent( this );
+		m_socket->setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+
+		connect( m_socket, &QTcpSocket::readyRead, this, [this]() {
+			m_input += m_socket->readAll();
+			while( processInput() )
+			{
+			}
+		} );
+
+		m_socket->write( QByteArrayLiteral("RFB 003.008\n") );
+
+		m_frameTimer.start();
+	}
+
+	bool consume( int size )
+	{
+		if( m_input.size() < size )
+		{
+			return false;
+		}
+
+		m_message = m_input.left( size );
+		m_input.remove( 0, size );
+
+		return true;
+	}
+
+	bool processInput()
+	{
+		switch( m_stage )
+		{
+		case Stage::Version:
+			if( consume( sz_rfbProtocolVersionMsg ) )
+			{
+				// one security type: none
+				m_socket->write( QByteArray( "\x01\x01", 2 ) );
+				m_stage = Stage::Security;
+				return true;
+			}
+			return false;
+
+		case Stage::Security:
+			if( consume( 1 ) )
+			{
+				m_socket->write( QByteArray( 4, 0 ) );
+				m_stage = Stage::ClientInit;
+				return true;
+			}
+			return false;
+
+		case Stage::ClientInit:
+			if( consume( sz_rfbClientInitMsg ) )
+			{
+				sendServerInit();
+				m_stage = Stage::Running;
+				return true;
+			}
+			return false;
+
+		case Stage::Running:
+			return m_input.isEmpty() == false && processMessage();
+		}
+
+		return false;
+	}
+
+	bool processMessage()
+	{
+		const auto messageType = uint8_t( m_input.at( 0 ) );
+
+		switch( messageType )
+		{
+		case rfbSetPixelFormat:
+			return consume( sz_rfbSetPixelFormatMsg );
+
+		case rfbSetEncodings:
+			return m_input.size() >= sz_rfbSetEncodingsMsg &&
+					consume( sz_rfbSetEncodingsMsg +
+							 qFromBigEndian<uint16_t>( reinterpret_cast<const uchar *>( m_input.constData() ) + 2 ) * 4 );
+
+		case rfbFramebufferUpdateRequest:
+			if( consume( sz_rfbFramebufferUpdateRequestMsg ) )
+			{
+				if( m_message.at( 1 ) == 0 )
+				{
+					sendUpdate( QRect( 0, 0, FramebufferWidth, FramebufferHeight ) );
+				}
+				else
+				{
+					m_updateRequested = true;
+					sendPendingUpdate();
+				}
+				return true;
+			}
+			return false;
+
+		case rfbKeyEvent:
+			return consume( sz_rfbKeyEventMsg );
+
+		case rfbPointerEvent:
+			return consume( sz_rfbPointerEventMsg );
+
+		default:
+			vCritical() << "unknown message type" << int( messageType );
+			m_socket->close();
+			m_input.clear();
+			return false;
+		}
+	}
+
+	void sendServerInit()
+	{
+		const QByteArray name = QByteArrayLiteral("Benchmark");
+
+		QByteArray message( sz_rfbServerInitMsg, 0 );
+		auto data = reinterpret_cast<uchar *>( message.data() );
+		qToBigEndian<uint16_t>( FramebufferWidth, data );
+		qToBigEndian<uint16_t>( FramebufferHeight, data + 2 );
+		// pixel format: 32 bits per pixel, depth 24, little endian, true colour, 8 bits per sample
+		data[4] = 32;
+		data[5] = 24;
+		data[6] = 0;
+		data[7] = 1;
+		qToBigEndian<uint16_t>( 255, data + 8 );
+		qToBigEndian<uint16_t>( 255, data + 10 );
+		qToBigEndian<uint16_t>( 255, data + 12 );
+		data[14] = 16;
+		data[15] = 8;
+		data[16] = 0;
+		qToBigEndian<uint32_t>( uint32_t( name.size() ), data + 20 );
+
+		m_socket->write( message + name );
+	}
+
+	void produceFrame()
+	{
+		++m_frame;
+
+		m_frameTimesMutex.lock();
+		m_frameTimes[m_frame % FrameCount] = m_clock.nsecsElapsed();
+		m_frameTimesMutex.unlock();
+
+		m_frameChanged = true;
+		sendPendingUpdate();
+	}
+
+	void sendPendingUpdate()
+	{
+		if( m_frameChanged && m_updateRequested )
+		{
+			m_updateRequested = false;
+			sendUpdate( QRect( 0, 0, BlockSize, BlockSize ) );
+		}
+	}
+
+	void sendUpdate( const QRect& rect )
+	{
+		// raw encoded rectangle filled with the current frame number
+		QByteArray message( sz_rfbFramebufferUpdateMsg + sz_rfbFramebufferUpdateRectHeader, 0 );
+		auto data = reinterpret_cast<uchar *>( message.data() );
+		qToBigEndian<uint16_t>( 1, data + 2 );
+		qToBigEndian<uint16_t>( uint16_t( rect.x() ), data + 4 );
+		qToBigEndian<uint16_t>( uint16_t( rect.y() ), data + 6 );
+		qToBigEndian<uint16_t>( uint16_t( rect.width() ), data + 8 );
+		qToBigEndian<uint16_t>( uint16_t( rect.height() ), data + 10 );
+		qToBigEndian<uint32_t>( rfbEncodingRaw, data + 12 );
+
+		const auto pixel = qToLittleEndian<uint32_t>( qRgb( m_frame & 0xff, ( m_frame >> 8 ) & 0xff, 0x80 ) & 0xffffff );
+		QByteArray pixels( rect.width() * rect.height() * 4, 0 );
+		auto pixelData = reinterpret_cast<uint32_t *>( pixels.data() );
+		std::fill( pixelData, pixelData + rect.width() * rect.height(), pixel );
+
+		m_socket->write( message + pixels );
+
+		m_frameChanged = false;
+	}
+
+	QTcpServer m_server{};
+	QTcpSocket* m_socket{nullptr};
+	QElapsedTimer m_clock{};
+	QTimer m_frameTimer{};
+
+	QByteArray m_input{};
+	QByteArray m_message{};
+
+	Stage m_stage{Stage::Version};
+	bool m_updateRequested{false};
+	bool m_frameChanged{false};
+
+	int m_frame{0};
+	QMutex m_frameTimesMutex{};
+	QVector<qint64> m_frameTimes;
+
+};
+
+
+
+// server protocol which accepts the credentials initialized for the benchmarking process itself
+// and skips access control
+class BenchmarkVncServerProtocol : public VncServerProtocol
+{
+public:
+	BenchmarkVncServerProtocol( QTcpSocket* socket, VncServerClient* client ) :
+		VncServerProtocol( socket, client )
+	{
+	}
+
+protected:
+	AuthMethodUids supportedAuthMethodUids() const override
+	{
+		return { VeyonCore::authenticationManager().toUid( VeyonCore::authenticationManager().initializedPlugin() ) };
+	}
+
+	void processAuthenticationMessage( VariantArrayMessage& message ) override
+	{
+		client()->setAuthState( VeyonCore::authenticationManager().initializedPlugin()->performAuthentication( client(), message ) );
+	}
+
+	void performAccessControl() override
+	{
+		client()->setAccessControlState( VncServerClient::AccessControlState::Successful );
+	}
+
+};
+
+
+
+class BenchmarkVncProxyConnection : public VncProxyConnection
+{
+public:
+	BenchmarkVncProxyConnection( QTcpSocket* clientSocket, int vncServerPort, QObject* parent ) :
+		VncProxyConnection( clientSocket, vncServerPort, parent ),
+		m_serverProtocol( clientSocket, &m_serverClient ),
+		m_clientProtocol( vncServerSocket(), {} )
+	{
+	}
+
+protected:
+	VncClientProtocol& clientProtocol() override
+	{
+		return m_clientProtocol;
+	}
+
+	VncServerProtocol& serverProtocol() override
+	{
+		return m_serverProtocol;
+	}
+
+private:
+	VncServerClient m_serverClient{};
+
+	BenchmarkVncServerProtocol m_serverProtocol;
+	VncClientProtocol m_clientProtocol;
+
+};
+
+
+
+class BenchmarkVncProxyConnectionFactory : public VncProxyConnectionFactory
+{
+public:
+	VncProxyConnection* createVncProxyConnection( QTcpSocket* clientSocket,
+												  int vncServerPort,
+												  const Password& vncServerPassword,
+												  QObject* parent ) override
+	{
+		Q_UNUSED(vncServerPassword)
+
+		return new BenchmarkVncProxyConnection( clientSocket, vncServerPort, parent );
+	}
+
+};
+
+
+
+// TCP relay which delays all data in both directions by a configurable one-way latency
+// in order to simulate the network link between the VNC client and the proxy
+class BenchmarkLatencyRelay : public QObject
+{
+public:
+	BenchmarkLatencyRelay( quint16 targetPort, int latency, QObject* parent = nullptr ) :
+		QObject( parent ),
+		m_targetPort( targetPort ),
+		m_latency( latency )
+	{
+		m_clock.start();
+
+		connect( &m_server, &QTcpServer::newConnection, this, &BenchmarkLatencyRelay::acceptConnection );
+
+		m_pumpTimer.setTimerType( Qt::PreciseTimer );
+		m_pumpTimer.setInterval( 1 );
+		connect( &m_pumpTimer, &QTimer::timeout, this, &BenchmarkLatencyRelay::pump );
+	}
+
+	bool listen()
+	{
+		return m_server.listen( QHostAddress::LocalHost );
+	}
+
+	quint16 port() const
+	{
+		return m_server.serverPort();
+	}
+
+private:
+	using DelayedData = QQueue<QPair<qint64, QByteArray>>;
+
+	void acceptConnection()
+	{
+		auto socket = m_server.nextPendingConnection();
+		if( m_clientSocket )
+		{
+			delete socket;
+			return;
+		}
+
+		m_clientSocket = socket;
+		m_clientSocket->setParent( this );
+		m_clientSocket->setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+
+		m_serverSocket.setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+		m_serverSocket.connectToHost( QHostAddress::LocalHost, m_targetPort );
+
+		connect( m_clientSocket, &QTcpSocket::readyRead, this, [this]() {
+			m_toServer.enqueue( { m_clock.elapsed() + m_latency, m_clientSocket->readAll() } );
+		} );
+		connect( &m_serverSocket, &QTcpSocket::readyRead, this, [this]() {
+			m_toClient.enqueue( { m_clock.elapsed() + m_latency, m_serverSocket.readAll() } );
+		} );
+
+		m_pumpTimer.start();
+	}
+
+	void pump()
+	{
+		if( m_serverSocket.state() == QAbstractSocket::ConnectedState )
+		{
+			deliver( m_toServer, &m_serverSocket );
+		}
+
+		deliver( m_toClient, m_clientSocket );
+	}
+
+	void deliver( DelayedData& data, QTcpSocket* socket )
+	{
+		const auto now = m_clock.elapsed();
+
+		while( data.isEmpty() == false && data.head().first <= now )
+		{
+			socket->write( data.dequeue().second );
+		}
+	}
+
+	const quint16 m_targetPort;
+	const int m_latency;
+
+	QTcpServer m_server{};
+	QTcpSocket* m_clientSocket{nullptr};
+	QTcpSocket m_serverSocket{};
+	QElapsedTimer m_clock{};
+	QTimer m_pumpTimer{};
+
+	DelayedData m_toServer{};
+	DelayedData m_toClient{};
+
+};
+
+
+
+// framebuffer source of the multicast server in the demo multicast loopback test
+class LoopbackDemoFramebufferSource : public DemoFramebufferSource
+{
+public:
+	static constexpr int KeyFrame = 1;
+
+	explicit LoopbackDemoFramebufferSource( const DemoConfiguration& configuration ) :
+		m_configuration( configuration ),
+		m_serverInitMessage( sizeof(rfbServerInitMsg), 0 )
+	{
+	}
+
+	const DemoConfiguration& configuration() const override
+	{
+		return m_configuration;
+	}
+
+	const QByteArray& serverInitMessage() const override
+	{
+		return m_serverInitMessage;
+	}
+
+	void lockDataForRead() override
+	{
+		m_dataLock.lockForRead();
+	}
+
+	void unlockData() override
+	{
+		m_dataLock.unlock();
+	}
+
+	int keyFrame() const override
+	{
+		return KeyFrame;
+	}
+
+	const MessageList& framebufferUpdateMessages() const override
+	{
+		return m_messages;
+	}
+
+	void requestFullFramebufferUpdate() override
+	{
+	}
+
+	void appendMessage( const QByteArray& message )
+	{
+		m_dataLock.lockForWrite();
+		m_messages.append( message );
+		m_dataLock.unlock();
+	}
+
+private:
+	const DemoConfiguration& m_configuration;
+	const QByteArray m_serverInitMessage;
+
+	QReadWriteLock m_dataLock{};
+	MessageList m_messages{};
+
+};
+
+
+
+// hides the first top-level row on request the same way a filter of the computer tree does
+class ToggleFilterProxyModel : public QSortFilterProxyModel
+{
+public:
+	void setFirstRowHidden( bool hidden )
+	{
+		m_firstRowHidden = hidden;
+		invalidateFilter();
+	}
+
+protected:
+	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override
+	{
+		return m_firstRowHidden == false || sourceParent.isValid() || sourceRow > 0;
+	}
+
+private:
+	bool m_firstRowHidden{false};
+
+};
+
 
 
 TestingCommandLinePlugin::TestingCommandLinePlugin( QObject* parent ) :
@@ -34,6 +636,14 @@ TestingCommandLinePlugin::TestingCommandLinePlugin( QObject* parent ) :
 { QStringLiteral("authorizedgroups"), QStringLiteral( "check if specified user is in authorized groups [ACCESSING USER]" ) },
 { QStringLiteral("accesscontrolrules"), QStringLiteral( "process access control rules with arguments [ACCESSING USER] [ACCESSING COMPUTER] [LOCAL USER] [LOCAL COMPUTER] [CONNECTED USER] [AUTH METHOD UID]" ) },
 { QStringLiteral("isaccessdeniedbylocalstate"), QStringLiteral( "check if access would be denied by local state") },
+{ QStringLiteral("benchmarkconfiguration"), QStringLiteral( "benchmark reading configuration properties [ITERATIONS]") },
+{ QStringLiteral("benchmarknetworkobjectdirectory"), QStringLiteral( "benchmark populating and traversing a network object directory [LOCATIONS] [HOSTS PER LOCATION]") },
+{ QStringLiteral("benchmarkvncupdatelatency"), QStringLiteral( "benchmark latency of framebuffer updates forwarded by the VNC proxy with and without continuous updates [DURATION] [FRAME INTERVAL] [ONE-WAY LATENCY]") },
+{ QStringLiteral("vnctelemetry"), QStringLiteral( "monitor a computer in live mode and dump the collected connection telemetry as JSON [HOST] [DURATION]") },
+{ QStringLiteral("benchmarkencodinglevels"), QStringLiteral( "measure update durations and throughput of a computer with changing screen content for each VNC encoding level [HOST] [DURATION PER LEVEL]") },
+{ QStringLiteral("benchmarkhostresolver"), QStringLiteral( "convert the given host names or addresses to FQDNs repeatedly and dump the resolver statistics as JSON [ITERATIONS] [HOST]...") },
+{ QStringLiteral("demomulticastloopback"), QStringLiteral( "send framebuffer update messages through the demo multicast transport on the loopback interface and verify their reception [MESSAGES] [MESSAGE SIZE] [TIMEOUT]") },
+{ QStringLiteral("checkableitemfiltertoggle"), QStringLiteral( "check a group of a computer tree, hide and show it through a filter repeatedly and verify the check states stay consistent [TOGGLES]") },
 				} )
 {
 }
@@ -119,3 +729,544 @@ CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_isaccessd
 
 	return Successful;
 }
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_benchmarkconfiguration( const QStringList& arguments )
+{
+	const auto iterations = qMax( 1, arguments.value( 0, QStringLiteral("100000") ).toInt() );
+	const auto& config = VeyonCore::config();
+
+	// read the same set of properties as each VncConnection instance and FeatureManager do
+	QElapsedTimer timer;
+	timer.start();
+
+	int dummy = 0;
+	for( int i = 0; i < iterations; ++i )
+	{
+		dummy += config.vncConnectionThreadTerminationTimeout();
+		dummy += config.vncConnectionConnectTimeout();
+		dummy += config.vncConnectionReadTimeout();
+		dummy += config.vncConnectionRetryInterval();
+		dummy += config.vncConnectionMessageWaitTimeout();
+		dummy += config.vncConnectionFastFramebufferUpdateInterval();
+		dummy += config.vncConnectionFramebufferUpdateWatchdogTimeout();
+		dummy += config.vncConnectionSocketKeepaliveIdleTime();
+		dummy += config.vncConnectionSocketKeepaliveInterval();
+		dummy += config.disabledFeatures().count();
+	}
+
+	const auto elapsed = qMax<qint64>( 1, timer.nsecsElapsed() );
+	const auto reads = qint64(iterations) * 10;
+
+	printf( "[TEST]: BenchmarkConfiguration: %lld reads in %.1f ms (%.0f reads/s) [%d]\n",
+			static_cast<long long>( reads ), double(elapsed) / 1000000, double(reads) * 1000000000 / double(elapsed), dummy );
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_benchmarknetworkobjectdirectory( const QStringList& arguments )
+{
+	const auto locationCount = qMax( 1, arguments.value( 0, QStringLiteral("200") ).toInt() );
+	const auto hostsPerLocation = qMax( 1, arguments.value( 1, QStringLiteral("50") ).toInt() );
+
+	BenchmarkNetworkObjectDirectory directory( this );
+
+	QElapsedTimer timer;
+	timer.start();
+
+	directory.populate( locationCount, hostsPerLocation );
+
+	const auto populateTime = timer.elapsed();
+
+	// traverse the directory the same way NetworkObjectTreeModel does when
+	// resolving indexes and parents for each item
+	timer.restart();
+
+	int lookups = 0;
+	int errors = 0;
+
+	const auto rootId = directory.rootId();
+	for( int l = 0; l < directory.childCount( rootId ); ++l )
+	{
+		const auto locationId = directory.childId( rootId, l );
+		if( directory.parentId( locationId ) != rootId ||
+			directory.index( rootId, locationId ) != l ||
+			directory.object( rootId, locationId ).isValid() == false )
+		{
+			++errors;
+		}
+
+		for( int h = 0; h < directory.childCount( locationId ); ++h )
+		{
+			const auto hostId = directory.childId( locationId, h );
+			if( directory.parentId( hostId ) != locationId ||
+				directory.index( locationId, hostId ) != h ||
+				directory.object( locationId, hostId ).isValid() == false )
+			{
+				++errors;
+			}
+			lookups += 3;
+		}
+
+		lookups += 3;
+	}
+
+	const auto traversalTime = timer.elapsed();
+
+	// resolve the location of each host by its address the same way ComputerManager does
+	timer.restart();
+
+	int hostLookups = 0;
+
+	for( int l = 0; l < locationCount; ++l )
+	{
+		for( int h = 0; h < hostsPerLocation; ++h )
+		{
+			const auto hostIds = directory.hostObjectIds( QStringLiteral("10.%1.%2.%3").arg( l / 256 ).arg( l % 256 ).arg( h ) );
+			if( hostIds.isEmpty() ||
+				directory.object( rootId, directory.parentId( hostIds.first() ) ).name() != QStringLiteral("Location %1").arg( l ) )
+			{
+				++errors;
+			}
+			++hostLookups;
+		}
+	}
+
+	const auto hostLookupTime = timer.elapsed();
+
+	printf( "[TEST]: BenchmarkNetworkObjectDirectory: %d objects populated in %lld ms, "
+			"%d lookups in %lld ms, %d host lookups in %lld ms, %d errors\n",
+			locationCount * ( hostsPerLocation + 1 ), static_cast<long long>( populateTime ),
+			lookups, static_cast<long long>( traversalTime ),
+			hostLookups, static_cast<long long>( hostLookupTime ), errors );
+
+	return errors == 0 ? Successful : Failed;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_benchmarkvncupdatelatency( const QStringList& arguments )
+{
+	const auto duration = qMax( 1000, arguments.value( 0, QStringLiteral("5000") ).toInt() );
+	const auto frameInterval = qMax( 1, arguments.value( 1, QStringLiteral("20") ).toInt() );
+	const auto latency = qMax( 0, arguments.value( 2, QStringLiteral("10") ).toInt() );
+
+	if( VeyonCore::authenticationManager().initializeCredentials() == false )
+	{
+		printf( "[TEST]: BenchmarkVncUpdateLatency: could not initialize authentication credentials\n" );
+		return Failed;
+	}
+
+	auto result = Successful;
+
+	for( const auto continuousUpdates : { false, true } )
+	{
+		BenchmarkFramebufferSource source( frameInterval );
+		if( source.listen() == false )
+		{
+			printf( "[TEST]: BenchmarkVncUpdateLatency: could not start local VNC server\n" );
+			return Failed;
+		}
+
+		BenchmarkVncProxyConnectionFactory connectionFactory;
+		VncProxyServer proxyServer( QHostAddress::LocalHost, 0, &connectionFactory );
+		if( proxyServer.start( source.port(), {} ) == false )
+		{
+			printf( "[TEST]: BenchmarkVncUpdateLatency: could not start VNC proxy server\n" );
+			return Failed;
+		}
+
+		BenchmarkLatencyRelay relay( proxyServer.serverPort(), latency );
+		if( relay.listen() == false )
+		{
+			printf( "[TEST]: BenchmarkVncUpdateLatency: could not start latency relay\n" );
+			return Failed;
+		}
+
+		QMutex statisticsMutex;
+		int lastFrame = 0;
+		int frameCount = 0;
+		qint64 totalLatency = 0;
+		qint64 maximumLatency = 0;
+
+		VncConnection connection;
+		connection.setHost( QHostAddress( QHostAddress::LocalHost ).toString() );
+		connection.setPort( relay.port() );
+		// continuous updates are only enabled by the connection if no update interval is set
+		connection.setFramebufferUpdateInterval( continuousUpdates ? -1 : 1 );
+
+		VeyonConnection veyonConnection( &connection );
+
+		// evaluate updates in the connection thread right after they have been published
+		connect( &connection, &VncConnection::imageUpdated, this, [&]( int x, int y, int w, int h ) {
+			Q_UNUSED(w)
+			Q_UNUSED(h)
+			if( x != 0 || y != 0 )
+			{
+				return;
+			}
+
+			const auto frame = BenchmarkFramebufferSource::frameFromPixel( connection.image().pixel( 0, 0 ) );
+			const auto frameLatency = source.elapsed() - source.frameTime( frame );
+
+			QMutexLocker locker( &statisticsMutex );
+			if( frame > lastFrame )
+			{
+				lastFrame = frame;
+				++frameCount;
+				totalLatency += frameLatency;
+				maximumLatency = qMax( maximumLatency, frameLatency );
+			}
+		}, Qt::DirectConnection );
+
+		QEventLoop eventLoop;
+		QTimer::singleShot( duration, &eventLoop, &QEventLoop::quit );
+
+		connection.start();
+		eventLoop.exec();
+		connection.stop();
+		connection.wait();
+
+		QMutexLocker locker( &statisticsMutex );
+
+		printf( "[TEST]: BenchmarkVncUpdateLatency: %s: %d of %d frames received, "
+				"average latency %.1f ms, maximum latency %.1f ms\n",
+				continuousUpdates ? "continuous updates" : "update requests",
+				frameCount, duration / frameInterval,
+				frameCount > 0 ? double(totalLatency) / frameCount / 1000000 : 0.0,
+				double(maximumLatency) / 1000000 );
+
+		if( frameCount == 0 )
+		{
+			result = Failed;
+		}
+	}
+
+	return result;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_vnctelemetry( const QStringList& arguments )
+{
+	if( arguments.isEmpty() )
+	{
+		return NotEnoughArguments;
+	}
+
+	const auto host = arguments.value( 0 );
+	const auto duration = qMax( 1000, arguments.value( 1, QStringLiteral("10000") ).toInt() );
+
+	VncConnection::setTelemetryEnabled( true );
+
+	auto controlInterface = ComputerControlInterface::Pointer::create( Computer( {}, host, host ) );
+	controlInterface->start( {}, ComputerControlInterface::UpdateMode::Live );
+
+	QEventLoop eventLoop;
+	QTimer::singleShot( duration, &eventLoop, &QEventLoop::quit );
+	eventLoop.exec();
+
+	const auto telemetry = controlInterface->telemetry();
+
+	const QJsonObject dump{
+		{ QStringLiteral("name"), controlInterface->computer().name() },
+		{ QStringLiteral("host"), controlInterface->computer().hostAddress() },
+		{ QStringLiteral("state"), EnumHelper::toString( controlInterface->state() ) },
+		{ QStringLiteral("telemetry"), telemetry.toJson() }
+	};
+
+	controlInterface->stop();
+
+	VncConnection::setTelemetryEnabled( false );
+
+	printf( "[TEST]: VncTelemetry: %s\n", QJsonDocument( dump ).toJson().constData() );
+
+	return telemetry.connections > 0 ? Successful : Failed;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_benchmarkencodinglevels( const QStringList& arguments )
+{
+	if( arguments.isEmpty() )
+	{
+		return NotEnoughArguments;
+	}
+
+	const auto host = arguments.value( 0 );
+	const auto duration = qMax( 1000, arguments.value( 1, QStringLiteral("10000") ).toInt() );
+
+	QJsonArray results;
+	bool connected = false;
+
+	for( const auto level : { VncConnection::EncodingLevel::Lossless, VncConnection::EncodingLevel::Compressed,
+							  VncConnection::EncodingLevel::Lossy, VncConnection::EncodingLevel::LowQuality } )
+	{
+		auto vncConnection = new VncConnection();
+		vncConnection->setHost( host );
+		vncConnection->setQuality( VncConnection::Quality::Default );
+		vncConnection->setFixedEncodingLevel( level );
+
+		// performs authentication and destroys itself along with the VNC connection
+		new VeyonConnection( vncConnection );
+
+		vncConnection->start();
+
+		QEventLoop eventLoop;
+		QTimer::singleShot( duration, &eventLoop, &QEventLoop::quit );
+		eventLoop.exec();
+
+		const auto statistics = vncConnection->linkStatistics();
+		if( vncConnection->isConnected() )
+		{
+			connected = true;
+		}
+
+		results.append( QJsonObject{
+							{ QStringLiteral("encodingLevel"), EnumHelper::toString( level ) },
+							{ QStringLiteral("updates"), statistics.updateCount },
+							{ QStringLiteral("averageUpdateDuration"), statistics.averageUpdateDuration },
+							{ QStringLiteral("pixelsPerSecond"), statistics.throughput }
+						} );
+
+		vncConnection->stopAndDeleteLater();
+	}
+
+	printf( "[TEST]: BenchmarkEncodingLevels: %s\n", QJsonDocument( results ).toJson().constData() );
+
+	return connected ? Successful : Failed;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_benchmarkhostresolver( const QStringList& arguments )
+{
+	if( arguments.count() < 2 )
+	{
+		return NotEnoughArguments;
+	}
+
+	const auto iterations = qMax( 1, arguments.value( 0 ).toInt() );
+	const auto hosts = arguments.mid( 1 );
+
+	auto& resolver = VeyonCore::hostResolver();
+	resolver.clear();
+
+	QElapsedTimer timer;
+	timer.start();
+
+	// issue all lookups at once and wait for them afterwards
+	QList<QFuture<QString>> futures;
+	for( int i = 0; i < iterations; ++i )
+	{
+		for( const auto& host : hosts )
+		{
+			futures.append( resolver.convert( host, HostAddress::Type::FullyQualifiedDomainName ) );
+		}
+	}
+
+	for( auto& future : futures )
+	{
+		future.waitForFinished();
+	}
+
+	const auto elapsed = timer.nsecsElapsed();
+
+	printf( "[TEST]: BenchmarkHostResolver: %d conversions in %.1f ms\n%s\n",
+			futures.count(), double(elapsed) / 1000000,
+			QJsonDocument( resolver.statistics().toJson() ).toJson().constData() );
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_demomulticastloopback( const QStringList& arguments )
+{
+	const auto messageCount = qMax( 1, arguments.value( 0, QStringLiteral("200") ).toInt() );
+	const auto messageSize = qMax( 1, arguments.value( 1, QStringLiteral("65536") ).toInt() );
+	const auto timeout = qMax( 1000, arguments.value( 2, QStringLiteral("10000") ).toInt() );
+
+	DemoConfiguration configuration( &VeyonCore::config() );
+	DemoAuthentication authentication( uid() );
+	authentication.initializeCredentials();
+
+	const auto port = DemoMulticastProtocol::port( configuration, VeyonCore::config().demoServerPort() );
+
+	LoopbackDemoFramebufferSource source( configuration );
+	DemoMulticastServer server( source, authentication, configuration, port, nullptr );
+	DemoMulticastClient client( QHostAddress( QHostAddress::LocalHost ).toString(), port, authentication, configuration );
+
+	bool failed = false;
+
+	QEventLoop eventLoop;
+	connect( &client, &DemoMulticastClient::ready, &eventLoop, &QEventLoop::quit );
+	connect( &client, &DemoMulticastClient::failed, &eventLoop, [&]() {
+		failed = true;
+		eventLoop.quit();
+	} );
+
+	client.start();
+	eventLoop.exec();
+
+	if( failed )
+	{
+		printf( "[TEST]: DemoMulticastLoopback: multicast transport unavailable\n" );
+		return Failed;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	for( int i = 0; i < messageCount; ++i )
+	{
+		const QByteArray message( messageSize, char( i ) );
+		source.appendMessage( message );
+		server.sendFramebufferUpdateMessage( LoopbackDemoFramebufferSource::KeyFrame, i, message );
+	}
+
+	const auto receivedMessageCount = [&]() {
+		client.lockDataForRead();
+		const auto count = client.framebufferUpdateMessages().count();
+		client.unlockData();
+		return count;
+	};
+
+	QTimer pollTimer;
+	connect( &pollTimer, &QTimer::timeout, &eventLoop, [&]() {
+		if( receivedMessageCount() >= messageCount )
+		{
+			eventLoop.quit();
+		}
+	} );
+	pollTimer.start( 10 );
+
+	QTimer::singleShot( timeout, &eventLoop, &QEventLoop::quit );
+	eventLoop.exec();
+
+	const auto elapsed = timer.elapsed();
+
+	int intactMessageCount = 0;
+
+	client.lockDataForRead();
+	source.lockDataForRead();
+
+	const auto& receivedMessages = client.framebufferUpdateMessages();
+	const auto& sentMessages = source.framebufferUpdateMessages();
+
+	for( int i = 0; i < qMin( receivedMessages.count(), sentMessages.count() ); ++i )
+	{
+		if( receivedMessages[i] == sentMessages[i] )
+		{
+			++intactMessageCount;
+		}
+	}
+
+	source.unlockData();
+	client.unlockData();
+
+	printf( "[TEST]: DemoMulticastLoopback: %d of %d messages received intact in %d ms (%.1f MB/s)\n",
+			intactMessageCount, messageCount, int(elapsed),
+			double(intactMessageCount) * messageSize / 1024 / 1024 / qMax<qint64>( 1, elapsed ) * 1000 );
+
+	return intactMessageCount == messageCount ? Successful : Failed;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_checkableitemfiltertoggle( const QStringList& arguments )
+{
+	const auto toggleCount = qMax( 1, arguments.value( 0, QStringLiteral("10") ).toInt() );
+
+	static constexpr int UidRole = Qt::UserRole;
+
+	QStandardItemModel sourceModel;
+	const auto addItem = [&]( QStandardItem* parent, const QString& name ) {
+		auto item = new QStandardItem( name );
+		item->setData( QUuid::createUuid(), UidRole );
+		parent->appendRow( item );
+		return item;
+	};
+
+	for( int g = 0; g < 2; ++g )
+	{
+		auto group = addItem( sourceModel.invisibleRootItem(), QStringLiteral("Group %1").arg( g ) );
+		auto subGroup = addItem( group, QStringLiteral("Subgroup %1").arg( g ) );
+		for( int c = 0; c < 3; ++c )
+		{
+			addItem( subGroup, QStringLiteral("Computer %1-%2").arg( g ).arg( c ) );
+		}
+	}
+
+	ToggleFilterProxyModel filterModel;
+	filterModel.setSourceModel( &sourceModel );
+
+	CheckableItemProxyModel checkableModel( UidRole );
+	checkableModel.setSourceModel( &filterModel );
+
+	const auto checkState = [&]( const QModelIndex& index ) {
+		return checkableModel.data( index, Qt::CheckStateRole ).value<Qt::CheckState>();
+	};
+
+	// every item with children has to reflect the states of its children
+	std::function<bool(const QModelIndex&)> isConsistent = [&]( const QModelIndex& parent ) {
+		const auto childCount = checkableModel.rowCount( parent );
+		int checked = 0;
+		int unchecked = 0;
+		for( int i = 0; i < childCount; ++i )
+		{
+			const auto childIndex = checkableModel.index( i, 0, parent );
+			if( isConsistent( childIndex ) == false )
+			{
+				return false;
+			}
+			const auto childCheckState = checkState( childIndex );
+			checked += childCheckState == Qt::Checked ? 1 : 0;
+			unchecked += childCheckState == Qt::Unchecked ? 1 : 0;
+		}
+		if( parent.isValid() == false || childCount == 0 )
+		{
+			return true;
+		}
+		return checkState( parent ) == ( checked == childCount ? Qt::Checked :
+											 unchecked == childCount ? Qt::Unchecked : Qt::PartiallyChecked );
+	};
+
+	// leave the second group partially checked
+	const auto secondSubGroupIndex = checkableModel.index( 0, 0, checkableModel.index( 1, 0 ) );
+	checkableModel.setData( checkableModel.index( 0, 0, secondSubGroupIndex ), Qt::Checked, Qt::CheckStateRole );
+
+	int failedToggleCount = 0;
+
+	for( int i = 0; i < toggleCount; ++i )
+	{
+		checkableModel.setData( checkableModel.index( 0, 0 ), Qt::Checked, Qt::CheckStateRole );
+
+		// hiding the first group must drop the states of its whole subtree
+		filterModel.setFirstRowHidden( true );
+		const auto hiddenStatesValid = checkableModel.saveStates().count() == 1 && isConsistent( {} );
+
+		filterModel.setFirstRowHidden( false );
+		const auto shownStatesValid = checkableModel.saveStates().count() == 1 && isConsistent( {} ) &&
+									  checkState( checkableModel.index( 0, 0 ) ) == Qt::Unchecked &&
+									  checkState( checkableModel.index( 1, 0 ) ) == Qt::PartiallyChecked;
+
+		if( hiddenStatesValid == false || shownStatesValid == false )
+		{
+			++failedToggleCount;
+		}
+	}
+
+	printf( "[TEST]: CheckableItemFilterToggle: %d of %d filter toggles left consistent check states\n",
+			toggleCount - failedToggleCount, toggleCount );
+
+	return failedToggleCount == 0 ? Successful : Failed;
+}
+
+
+
+// the demo multicast transport is driven directly by the loopback test
+IMPLEMENT_CONFIG_PROXY(DemoConfiguration)
@@ -84,6 +84,14 @@ public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_authorizedgroups( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_accesscontrolrules( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_isaccessdeniedbylocalstate( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_benchmarkconfiguration( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_benchmarknetworkobjectdirectory( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_benchmarkvncupdatelatency( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_vnctelemetry( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_benchmarkencodinglevels( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_benchmarkhostresolver( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_demomulticastloopback( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_checkableitemfiltertoggle( const QStringList& arguments );
 
 private:
 	QMap<QString, QString> m_commands;
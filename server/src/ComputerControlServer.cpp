@@ -30,6 +30,7 @@
 #include "ComputerControlServer.h"
 #include "FeatureMessage.h"
 #include "HostAddress.h"
+#include "HostResolver.h"
 #include "VeyonConfiguration.h"
 #include "SystemTrayIcon.h"
 
@@ -43,7 +44,8 @@ ComputerControlServer::ComputerControlServer( QObject* parent ) :
 						  QHostAddress::LocalHost : QHostAddress::Any,
 					  VeyonCore::config().veyonServerPort() + VeyonCore::sessionId(),
 					  this,
-					  this )
+					  this ),
+	m_serverMetrics( *this, this )
 {
 	updateTrayIconToolTip();
 
@@ -57,6 +59,7 @@ ComputerControlServer::ComputerControlServer( QObject* parent ) :
 			 this, &ComputerControlServer::showAccessControlMessage );
 
 	connect( &m_vncProxyServer, &VncProxyServer::connectionClosed, this, &ComputerControlServer::updateTrayIconToolTip );
+	connect( &m_vncProxyServer, &VncProxyServer::connectionClosed, &m_serverMetrics, &ServerMetrics::addClosedConnection );
 }
 
 
@@ -80,6 +83,9 @@ bool ComputerControlServer::start()
 	m_vncServer.prepare();
 	m_vncServer.start();
 
+	// metrics are optional and must not prevent the server from running
+	m_serverMetrics.start();
+
 	return true;
 }
 
@@ -166,13 +172,14 @@ void ComputerControlServer::showAuthenticationMessage( VncServerClient* client )
 			{
 				m_failedAuthHosts += client->hostAddress();
 
-				const auto fqdn = HostAddress( client->hostAddress() ).tryConvert( HostAddress::Type::FullyQualifiedDomainName );
-
-				VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
-							tr( "Authentication error" ),
-							tr( "User \"%1\" at host \"%2\" attempted to access this computer "
-								"but could not authenticate successfully." ).arg( client->username(), fqdn ),
-							m_featureWorkerManager );
+				VeyonCore::hostResolver().tryConvert( client->hostAddress(), HostAddress::Type::FullyQualifiedDomainName, this,
+													  [this, username = client->username()]( const QString& fqdn ) {
+					VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
+								tr( "Authentication error" ),
+								tr( "User \"%1\" at host \"%2\" attempted to access this computer "
+									"but could not authenticate successfully." ).arg( username, fqdn ),
+								m_featureWorkerManager );
+				} );
 			}
 		}
 	}
@@ -189,13 +196,14 @@ void ComputerControlServer::showAccessControlMessage( VncServerClient* client )
 
 		if( VeyonCore::config().remoteConnectionNotificationsEnabled() )
 		{
-			const auto fqdn = HostAddress( client->hostAddress() ).tryConvert( HostAddress::Type::FullyQualifiedDomainName );
-
-			VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
-						tr( "Remote access" ),
-						tr( "User \"%1\" at host \"%2\" is now accessing this computer." ).
-						arg( client->username(), fqdn ),
-						m_featureWorkerManager );
+			VeyonCore::hostResolver().tryConvert( client->hostAddress(), HostAddress::Type::FullyQualifiedDomainName, this,
+												  [this, username = client->username()]( const QString& fqdn ) {
+				VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
+							tr( "Remote access" ),
+							tr( "User \"%1\" at host \"%2\" is now accessing this computer." ).
+							arg( username, fqdn ),
+							m_featureWorkerManager );
+			} );
 		}
 
 		updateTrayIconToolTip();
@@ -212,14 +220,15 @@ void ComputerControlServer::showAccessControlMessage( VncServerClient* client )
 			{
 				m_failedAccessControlHosts += client->hostAddress();
 
-				const auto fqdn = HostAddress( client->hostAddress() ).tryConvert( HostAddress::Type::FullyQualifiedDomainName );
-
-				VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
-							tr( "Access control error" ),
-							tr( "User \"%1\" at host \"%2\" attempted to access this computer "
-								"but has been blocked due to access control settings." ).
-							arg( client->username(), fqdn ),
-							m_featureWorkerManager );
+				VeyonCore::hostResolver().tryConvert( client->hostAddress(), HostAddress::Type::FullyQualifiedDomainName, this,
+													  [this, username = client->username()]( const QString& fqdn ) {
+					VeyonCore::builtinFeatures().systemTrayIcon().showMessage(
+								tr( "Access control error" ),
+								tr( "User \"%1\" at host \"%2\" attempted to access this computer "
+									"but has been blocked due to access control settings." ).
+								arg( username, fqdn ),
+								m_featureWorkerManager );
+				} );
 			}
 		}
 	}
@@ -233,11 +242,27 @@ void ComputerControlServer::updateTrayIconToolTip()
 													   HostAddress::localFQDN(),
 												QString::number( VeyonCore::config().veyonServerPort() + VeyonCore::sessionId() ) );
 
+	auto& hostResolver = VeyonCore::hostResolver();
+
 	QStringList clients;
 	for( const auto* client : m_vncProxyServer.clients() )
 	{
-		const auto clientAddress = HostAddress( client->proxyClientSocket()->peerAddress().toString() );
-		clients.append( clientAddress.tryConvert( HostAddress::Type::FullyQualifiedDomainName ) );
+		const auto clientAddress = client->proxyClientSocket()->peerAddress().toString();
+
+		QString fqdn;
+		if( hostResolver.lookupCache( clientAddress, HostAddress::Type::FullyQualifiedDomainName, &fqdn ) == false &&
+			m_pendingToolTipLookups.contains( clientAddress ) == false )
+		{
+			// show the plain address for now and update the tool tip once the name has been resolved
+			m_pendingToolTipLookups.insert( clientAddress );
+			hostResolver.tryConvert( clientAddress, HostAddress::Type::FullyQualifiedDomainName, this,
+									 [this, clientAddress]( const QString& ) {
+				m_pendingToolTipLookups.remove( clientAddress );
+				updateTrayIconToolTip();
+			} );
+		}
+
+		clients.append( fqdn.isEmpty() ? clientAddress : fqdn );
 	}
 
 	if( clients.isEmpty() == false )
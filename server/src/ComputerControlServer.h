@@ -25,12 +25,14 @@
 #pragma once
 
 #include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QStringList>
 
 #include "FeatureManager.h"
 #include "FeatureWorkerManager.h"
 #include "ServerAuthenticationManager.h"
 #include "ServerAccessControlManager.h"
+#include "ServerMetrics.h"
 #include "VeyonServerInterface.h"
 #include "VncProxyServer.h"
 #include "VncProxyConnectionFactory.h"
@@ -69,6 +71,16 @@ public:
 		return m_featureWorkerManager;
 	}
 
+	const FeatureManager& featureManager() const
+	{
+		return m_featureManager;
+	}
+
+	const VncProxyServer& vncProxyServer() const
+	{
+		return m_vncProxyServer;
+	}
+
 
 private:
 	void checkForIncompleteAuthentication( VncServerClient* client );
@@ -83,6 +95,9 @@ private:
 	QStringList m_failedAuthHosts{};
 	QStringList m_failedAccessControlHosts{};
 
+	// client addresses the tray icon tool tip is waiting to be resolved for
+	QSet<QString> m_pendingToolTipLookups{};
+
 	FeatureManager m_featureManager;
 	FeatureWorkerManager m_featureWorkerManager;
 
@@ -92,4 +107,6 @@ private:
 	VncServer m_vncServer{};
 	VncProxyServer m_vncProxyServer;
 
+	ServerMetrics m_serverMetrics;
+
 } ;
@@ -26,6 +26,7 @@
 #include "AccessControlProvider.h"
 #include "AuthenticationManager.h"
 #include "DesktopAccessDialog.h"
+#include "HostAddress.h"
 #include "VeyonConfiguration.h"
 
 
@@ -70,6 +71,7 @@ void ServerAccessControlManager::addClient( VncServerClient* client )
 void ServerAccessControlManager::removeClient( VncServerClient* client )
 {
 	m_clients.removeAll( client );
+	m_resolvingClients.remove( client );
 
 	// force all remaining clients to pass access control again as conditions might
 	// have changed (e.g. AccessControlRule::Condition::AccessFromAlreadyConnectedUser)
@@ -82,6 +84,12 @@ void ServerAccessControlManager::removeClient( VncServerClient* client )
 		prevClient->setAccessControlState( VncServerClient::AccessControlState::Init );
 		addClient( prevClient );
 
+		// keep the connection until access can be checked without blocking
+		if( m_resolvingClients.contains( prevClient ) )
+		{
+			continue;
+		}
+
 		if( prevClient->accessControlState() != VncServerClient::AccessControlState::Successful &&
 			prevClient->accessControlState() != VncServerClient::AccessControlState::Pending )
 		{
@@ -113,12 +121,34 @@ void ServerAccessControlManager::performAccessControl( VncServerClient* client )
 		break;
 	}
 
+	// DNS lookups required by access control rules must not block the event loop
+	// so check access again once they finished in the background
+	const auto finishLookups = [this, client]() { finishHostLookups( client ); };
+
+	if( AccessControlProvider::resolveComputer( client->hostAddress(), client, finishLookups ) == false ||
+		AccessControlProvider::resolveComputer( HostAddress::localFQDN(), client, finishLookups ) == false )
+	{
+		m_resolvingClients.insert( client );
+		client->setAccessControlState( VncServerClient::AccessControlState::Waiting );
+		Q_EMIT finished( client );
+		return;
+	}
+
+	QElapsedTimer accessControlTimer;
+	accessControlTimer.start();
+
 	const auto accessResult =
 			AccessControlProvider().checkAccess( client->username(),
 												 client->hostAddress(),
 												 connectedUsers(),
 												 client->authMethodUid() );
 
+	m_latency.addDuration( accessControlTimer.nsecsElapsed() );
+	if( accessResult == AccessControlProvider::Access::Deny )
+	{
+		++m_latency.failures;
+	}
+
 	switch( accessResult )
 	{
 	case AccessControlProvider::Access::Allow:
@@ -140,6 +170,35 @@ void ServerAccessControlManager::performAccessControl( VncServerClient* client )
 
 
 
+void ServerAccessControlManager::finishHostLookups( VncServerClient* client )
+{
+	if( m_resolvingClients.remove( client ) == false )
+	{
+		// already processed or client removed in the meantime
+		return;
+	}
+
+	client->setAccessControlState( VncServerClient::AccessControlState::Init );
+
+	if( client->protocolState() == VncServerProtocol::State::Running )
+	{
+		// access of an already connected client is checked again (see removeClient())
+		addClient( client );
+
+		if( client->accessControlState() != VncServerClient::AccessControlState::Successful &&
+			client->accessControlState() != VncServerClient::AccessControlState::Pending &&
+			m_resolvingClients.contains( client ) == false )
+		{
+			vDebug() << "closing connection as client does not pass access control any longer";
+			client->setProtocolState( VncServerProtocol::State::Close );
+		}
+	}
+
+	// otherwise the server protocol checks access again as soon as it processes the client
+}
+
+
+
 VncServerClient::AccessControlState ServerAccessControlManager::confirmDesktopAccess( VncServerClient* client )
 {
 	const HostUserPair hostUserPair( client->username(), client->hostAddress() );
@@ -24,7 +24,10 @@
 
 #pragma once
 
+#include <QSet>
+
 #include "DesktopAccessDialog.h"
+#include "ServerMetrics.h"
 #include "VncServerClient.h"
 
 class VariantArrayMessage;
@@ -40,6 +43,10 @@ public:
 	void addClient( VncServerClient* client );
 	void removeClient( VncServerClient* client );
 
+	const ServerMetrics::LatencySummary& latency() const
+	{
+		return m_latency;
+	}
 
 Q_SIGNALS:
 	void finished( VncServerClient* client );
@@ -48,6 +55,7 @@ private:
 	static constexpr int ClientWaitInterval = 1000;
 
 	void performAccessControl( VncServerClient* client );
+	void finishHostLookups( VncServerClient* client );
 	VncServerClient::AccessControlState confirmDesktopAccess( VncServerClient* client );
 	void finishDesktopAccessConfirmation( VncServerClient* client );
 
@@ -58,9 +66,15 @@ private:
 
 	VncServerClientList m_clients{};
 
+	// clients waiting for DNS lookups required for checking access
+	QSet<VncServerClient *> m_resolvingClients{};
+
 	using HostUserPair = QPair<QString, QString>;
 	using DesktopAccessChoiceMap = QMap<HostUserPair, DesktopAccessDialog::Choice>;
 
 	DesktopAccessChoiceMap m_desktopAccessChoices{};
 
+	// latency of access control rule processing (excluding user confirmation)
+	ServerMetrics::LatencySummary m_latency{};
+
 } ;
@@ -42,6 +42,9 @@ void ServerAuthenticationManager::processAuthenticationMessage( VncServerClient*
 			 << "host" << client->hostAddress()
 			 << "user" << client->username();
 
+	QElapsedTimer authenticationTimer;
+	authenticationTimer.start();
+
 	auto authPlugin = VeyonCore::authenticationManager().plugins().value( client->authMethodUid() );
 
 	if( authPlugin &&
@@ -54,9 +57,14 @@ void ServerAuthenticationManager::processAuthenticationMessage( VncServerClient*
 		client->setAuthState( VncServerClient::AuthState::Failed );
 	}
 
+	m_latency.addDuration( authenticationTimer.nsecsElapsed() );
+
 	switch( client->authState() )
 	{
 	case VncServerClient::AuthState::Failed:
+		++m_latency.failures;
+		Q_EMIT finished( client );
+		break;
 	case VncServerClient::AuthState::Successful:
 		Q_EMIT finished( client );
 		break;
@@ -27,6 +27,7 @@
 #include <QMutex>
 #include <QStringList>
 
+#include "ServerMetrics.h"
 #include "VncServerClient.h"
 
 class VariantArrayMessage;
@@ -46,8 +47,16 @@ public:
 	void processAuthenticationMessage( VncServerClient* client,
 									   VariantArrayMessage& message );
 
+	const ServerMetrics::LatencySummary& latency() const
+	{
+		return m_latency;
+	}
+
 
 Q_SIGNALS:
 	void finished( VncServerClient* client );
 
+private:
+	ServerMetrics::LatencySummary m_latency{};
+
 } ;
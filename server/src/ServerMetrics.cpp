@@ -0,0 +1,263 @@
+/*
+ * ServerMetrics.cpp - implementation of ServerMetrics class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "ComputerControlServer.h"
+#include "HostResolver.h"
+#include "ServerMetrics.h"
+#include "VeyonConfiguration.h"
+#include "VncProxyConnection.h"
+
+
+static QByteArray escapeLabelValue( const QString& value )
+{
+	auto escaped = value.toUtf8();
+	escaped.replace( '\\', QByteArrayLiteral("\\\\") );
+	escaped.replace( '"', QByteArrayLiteral("\\\"") );
+	escaped.replace( '\n', QByteArrayLiteral("\\n") );
+
+	return escaped;
+}
+
+
+
+static void appendMetricHeader( QByteArray& output, const char* name, const char* type, const char* help )
+{
+	output += QByteArrayLiteral("# HELP ") + name + ' ' + help + '\n';
+	output += QByteArrayLiteral("# TYPE ") + name + ' ' + type + '\n';
+}
+
+
+
+static void appendLatencySummary( QByteArray& output, const char* name, const char* help,
+								  const ServerMetrics::LatencySummary& latency )
+{
+	appendMetricHeader( output, name, "summary", help );
+	output += QByteArray(name) + QByteArrayLiteral("_sum ") + QByteArray::number( double(latency.duration) / 1e9 ) + '\n';
+	output += QByteArray(name) + QByteArrayLiteral("_count ") + QByteArray::number( latency.count ) + '\n';
+}
+
+
+
+ServerMetrics::ServerMetrics( ComputerControlServer& server, QObject* parent ) :
+	QObject( parent ),
+	m_server( server )
+{
+	connect( &m_tcpServer, &QTcpServer::newConnection, this, &ServerMetrics::acceptConnection );
+}
+
+
+
+bool ServerMetrics::start()
+{
+	if( VeyonCore::config().isMetricsExporterEnabled() == false )
+	{
+		return true;
+	}
+
+	const auto port = VeyonCore::config().metricsExporterPort() + VeyonCore::sessionId();
+
+	if( m_tcpServer.listen( QHostAddress::LocalHost, quint16(port) ) == false )
+	{
+		vCritical() << "can't listen on localhost port" << port;
+		return false;
+	}
+
+	vDebug() << "exporting metrics on localhost port" << port;
+
+	return true;
+}
+
+
+
+QByteArray ServerMetrics::metrics() const
+{
+	QByteArray output;
+
+	const auto& connections = m_server.vncProxyServer().clients();
+
+	appendMetricHeader( output, "veyon_server_info", "gauge", "Version of the Veyon Server" );
+	output += QByteArrayLiteral("veyon_server_info{version=\"") + escapeLabelValue( VeyonCore::versionString() ) +
+			  QByteArrayLiteral("\",session=\"") + QByteArray::number( VeyonCore::sessionId() ) + QByteArrayLiteral("\"} 1\n");
+
+	appendMetricHeader( output, "veyon_proxy_connections", "gauge", "Number of active VNC proxy connections" );
+	output += QByteArrayLiteral("veyon_proxy_connections ") + QByteArray::number( connections.count() ) + '\n';
+
+	appendMetricHeader( output, "veyon_proxy_connections_closed_total", "counter", "Number of closed VNC proxy connections" );
+	output += QByteArrayLiteral("veyon_proxy_connections_closed_total ") + QByteArray::number( m_closedConnectionCount ) + '\n';
+
+	qint64 bytesSentToClient = m_closedBytesSentToClient;
+	qint64 bytesSentToServer = m_closedBytesSentToServer;
+	qint64 framebufferUpdateCount = m_closedFramebufferUpdateCount;
+
+	QByteArray clientBytesSent;
+	QByteArray clientFramebufferUpdates;
+
+	for( const auto* connection : connections )
+	{
+		const auto socket = connection->proxyClientSocket();
+		const auto client = QByteArrayLiteral("{client=\"") +
+							escapeLabelValue( socket->peerAddress().toString() ) + ':' +
+							QByteArray::number( socket->peerPort() ) + '"';
+
+		clientBytesSent += QByteArrayLiteral("veyon_proxy_client_sent_bytes_total") + client +
+						   QByteArrayLiteral(",direction=\"client\"} ") + QByteArray::number( connection->bytesSentToClient() ) + '\n';
+		clientBytesSent += QByteArrayLiteral("veyon_proxy_client_sent_bytes_total") + client +
+						   QByteArrayLiteral(",direction=\"server\"} ") + QByteArray::number( connection->bytesSentToServer() ) + '\n';
+		clientFramebufferUpdates += QByteArrayLiteral("veyon_proxy_client_framebuffer_updates_total") + client +
+									QByteArrayLiteral("} ") + QByteArray::number( connection->framebufferUpdateCount() ) + '\n';
+
+		bytesSentToClient += connection->bytesSentToClient();
+		bytesSentToServer += connection->bytesSentToServer();
+		framebufferUpdateCount += connection->framebufferUpdateCount();
+	}
+
+	appendMetricHeader( output, "veyon_proxy_client_sent_bytes_total", "counter",
+						"Bytes sent by the VNC proxy per active connection to the client or the VNC server" );
+	output += clientBytesSent;
+
+	appendMetricHeader( output, "veyon_proxy_client_framebuffer_updates_total", "counter",
+						"Framebuffer updates forwarded from the VNC server per active connection" );
+	output += clientFramebufferUpdates;
+
+	appendMetricHeader( output, "veyon_proxy_sent_bytes_total", "counter",
+						"Bytes sent by the VNC proxy to clients or the VNC server" );
+	output += QByteArrayLiteral("veyon_proxy_sent_bytes_total{direction=\"client\"} ") + QByteArray::number( bytesSentToClient ) + '\n';
+	output += QByteArrayLiteral("veyon_proxy_sent_bytes_total{direction=\"server\"} ") + QByteArray::number( bytesSentToServer ) + '\n';
+
+	appendMetricHeader( output, "veyon_vnc_framebuffer_updates_total", "counter",
+						"Framebuffer updates sent by the VNC server" );
+	output += QByteArrayLiteral("veyon_vnc_framebuffer_updates_total ") + QByteArray::number( framebufferUpdateCount ) + '\n';
+
+	const auto& authenticationLatency = m_server.authenticationManager().latency();
+	appendLatencySummary( output, "veyon_authentication_duration_seconds",
+						  "Time spent for authenticating clients", authenticationLatency );
+	appendMetricHeader( output, "veyon_authentication_failures_total", "counter", "Number of failed authentications" );
+	output += QByteArrayLiteral("veyon_authentication_failures_total ") + QByteArray::number( authenticationLatency.failures ) + '\n';
+
+	const auto& accessControlLatency = m_server.accessControlManager().latency();
+	appendLatencySummary( output, "veyon_access_control_duration_seconds",
+						  "Time spent for processing access control", accessControlLatency );
+	appendMetricHeader( output, "veyon_access_control_denials_total", "counter", "Number of denied accesses" );
+	output += QByteArrayLiteral("veyon_access_control_denials_total ") + QByteArray::number( accessControlLatency.failures ) + '\n';
+
+	const auto hostResolverStatistics = VeyonCore::hostResolver().statistics();
+	LatencySummary hostLookupLatency;
+	hostLookupLatency.count = hostResolverStatistics.lookups;
+	hostLookupLatency.duration = hostResolverStatistics.lookupDuration;
+	appendLatencySummary( output, "veyon_host_lookup_duration_seconds",
+						  "Time spent for resolving host names and addresses", hostLookupLatency );
+	appendMetricHeader( output, "veyon_host_lookup_failures_total", "counter", "Number of failed host lookups" );
+	output += QByteArrayLiteral("veyon_host_lookup_failures_total ") + QByteArray::number( hostResolverStatistics.failures ) + '\n';
+	appendMetricHeader( output, "veyon_host_lookup_cache_hits_total", "counter", "Number of host conversions answered from the cache" );
+	output += QByteArrayLiteral("veyon_host_lookup_cache_hits_total{result=\"positive\"} ") +
+			  QByteArray::number( hostResolverStatistics.cacheHits - hostResolverStatistics.negativeCacheHits ) + '\n';
+	output += QByteArrayLiteral("veyon_host_lookup_cache_hits_total{result=\"negative\"} ") +
+			  QByteArray::number( hostResolverStatistics.negativeCacheHits ) + '\n';
+	appendMetricHeader( output, "veyon_host_lookups_pending", "gauge", "Number of host lookups in progress" );
+	output += QByteArrayLiteral("veyon_host_lookups_pending ") + QByteArray::number( hostResolverStatistics.pendingLookups ) + '\n';
+
+	const auto runningWorkers = m_server.featureWorkerManager().runningWorkers();
+
+	appendMetricHeader( output, "veyon_feature_workers", "gauge", "Number of running feature workers" );
+	output += QByteArrayLiteral("veyon_feature_workers ") + QByteArray::number( runningWorkers.count() ) + '\n';
+
+	appendMetricHeader( output, "veyon_feature_worker_running", "gauge", "Feature workers which are currently running" );
+	for( const auto& featureUid : runningWorkers )
+	{
+		output += QByteArrayLiteral("veyon_feature_worker_running{feature=\"") +
+				  escapeLabelValue( m_server.featureManager().feature( featureUid ).name() ) + QByteArrayLiteral("\"} 1\n");
+	}
+
+	return output;
+}
+
+
+
+void ServerMetrics::addClosedConnection( const VncProxyConnection* connection )
+{
+	++m_closedConnectionCount;
+	m_closedBytesSentToClient += connection->bytesSentToClient();
+	m_closedBytesSentToServer += connection->bytesSentToServer();
+	m_closedFramebufferUpdateCount += connection->framebufferUpdateCount();
+}
+
+
+
+void ServerMetrics::acceptConnection()
+{
+	while( m_tcpServer.hasPendingConnections() )
+	{
+		auto socket = m_tcpServer.nextPendingConnection();
+
+		connect( socket, &QTcpSocket::readyRead, this, [=]() { processRequest( socket ); } );
+		connect( socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater );
+
+		// do not let idle connections pile up
+		QTimer::singleShot( RequestTimeout, socket, [socket]() { socket->abort(); socket->deleteLater(); } );
+	}
+}
+
+
+
+void ServerMetrics::processRequest( QTcpSocket* socket )
+{
+	const auto request = socket->peek( MaximumRequestSize );
+	if( request.contains( QByteArrayLiteral("\r\n\r\n") ) == false )
+	{
+		if( request.size() >= MaximumRequestSize )
+		{
+			socket->abort();
+		}
+		return;
+	}
+
+	socket->readAll();
+
+	const auto requestLine = request.left( request.indexOf( '\r' ) ).split( ' ' );
+
+	QByteArray status = QByteArrayLiteral("200 OK");
+	QByteArray body;
+
+	if( requestLine.value( 0 ) != "GET" )
+	{
+		status = QByteArrayLiteral("405 Method Not Allowed");
+	}
+	else if( requestLine.value( 1 ) != "/metrics" )
+	{
+		status = QByteArrayLiteral("404 Not Found");
+	}
+	else
+	{
+		body = metrics();
+	}
+
+	socket->write( QByteArrayLiteral("HTTP/1.0 ") + status + QByteArrayLiteral("\r\n"
+				   "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+				   "Content-Length: ") + QByteArray::number( body.size() ) + QByteArrayLiteral("\r\n"
+				   "Connection: close\r\n\r\n") + body );
+	socket->disconnectFromHost();
+}
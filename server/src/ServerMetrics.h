@@ -0,0 +1,75 @@
+/*
+ * ServerMetrics.h - declaration of ServerMetrics class
+ *
+ * Copyright (c) 2020 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QTcpServer>
+
+class ComputerControlServer;
+class VncProxyConnection;
+
+// exports server metrics in the Prometheus text format via HTTP on localhost
+class ServerMetrics : public QObject
+{
+	Q_OBJECT
+public:
+	struct LatencySummary
+	{
+		qint64 count{0};
+		qint64 failures{0};
+		qint64 duration{0}; // nanoseconds
+
+		void addDuration( qint64 nanoseconds )
+		{
+			++count;
+			duration += nanoseconds;
+		}
+	};
+
+	explicit ServerMetrics( ComputerControlServer& server, QObject* parent = nullptr );
+	~ServerMetrics() override = default;
+
+	bool start();
+
+	QByteArray metrics() const;
+
+	void addClosedConnection( const VncProxyConnection* connection );
+
+private:
+	void acceptConnection();
+	void processRequest( QTcpSocket* socket );
+
+	static constexpr int MaximumRequestSize = 8192;
+	static constexpr int RequestTimeout = 5000;
+
+	ComputerControlServer& m_server;
+	QTcpServer m_tcpServer{this};
+
+	// counters of already closed proxy connections so exported totals never decrease
+	qint64 m_closedConnectionCount{0};
+	qint64 m_closedBytesSentToClient{0};
+	qint64 m_closedBytesSentToServer{0};
+	qint64 m_closedFramebufferUpdateCount{0};
+
+} ;
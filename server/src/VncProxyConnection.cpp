@@ -26,7 +26,10 @@
 #include <QHostAddress>
 #include <QTcpSocket>
 #include <QTimer>
+#include <QtEndian>
 
+#include "RfbExtensions.h"
+#include "TraceLog.h"
 #include "VncClientProtocol.h"
 #include "VncProxyConnection.h"
 #include "VncServerProtocol.h"
@@ -51,6 +54,9 @@ VncProxyConnection::VncProxyConnection( QTcpSocket* clientSocket,
 
 	connect( m_vncServerSocket, &QTcpSocket::disconnected, this, &VncProxyConnection::clientConnectionClosed );
 	connect( m_proxyClientSocket, &QTcpSocket::disconnected, this, &VncProxyConnection::serverConnectionClosed );
+
+	connect( m_proxyClientSocket, &QTcpSocket::bytesWritten, this, [this]( qint64 bytes ) { m_bytesSentToClient += bytes; } );
+	connect( m_vncServerSocket, &QTcpSocket::bytesWritten, this, [this]( qint64 bytes ) { m_bytesSentToServer += bytes; } );
 }
 
 
@@ -152,6 +158,7 @@ bool VncProxyConnection::forwardDataToClient( qint64 size )
 		const auto data = m_vncServerSocket->read( size ); // Flawfinder: ignore
 		if( data.size() == size )
 		{
+			TraceLog::record( TraceLog::Event::VncProxyForwardToClient, size, -1 );
 			return m_proxyClientSocket->write( data ) == size;
 		}
 	}
@@ -168,6 +175,7 @@ bool VncProxyConnection::forwardDataToServer( qint64 size )
 		const auto data = m_proxyClientSocket->read( size ); // Flawfinder: ignore
 		if( data.size() == size )
 		{
+			TraceLog::record( TraceLog::Event::VncProxyForwardToServer, size, data.isEmpty() ? -1 : quint8( data.at( 0 ) ) );
 			return m_vncServerSocket->write( data ) == size;
 		}
 	}
@@ -204,22 +212,16 @@ bool VncProxyConnection::receiveClientMessage()
 	switch( messageType )
 	{
 	case rfbSetEncodings:
-		if( socket->bytesAvailable() >= sz_rfbSetEncodingsMsg )
-		{
-			rfbSetEncodingsMsg setEncodingsMessage;
-			if( socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) == sz_rfbSetEncodingsMsg )
-			{
-				const auto nEncodings = qFromBigEndian(setEncodingsMessage.nEncodings);
-				if( nEncodings > MAX_ENCODINGS )
-				{
-					vCritical() << "received too many encodings from client";
-					socket->close();
-					return false;
-				}
-				return forwardDataToServer( sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t) );
-			}
-		}
-		break;
+		return receiveSetEncodingsMessage();
+
+	case rfbFramebufferUpdateRequest:
+		return receiveFramebufferUpdateRequestMessage();
+
+	case RfbExtensions::EnableContinuousUpdatesMessage:
+		return receiveEnableContinuousUpdatesMessage();
+
+	case RfbExtensions::FenceMessage:
+		return receiveFenceMessage();
 
 	default:
 		if( m_rfbClientToServerMessageSizes.contains( messageType ) == false )
@@ -241,10 +243,247 @@ bool VncProxyConnection::receiveServerMessage()
 {
 	if( clientProtocol().receiveMessage() )
 	{
+		TraceLog::record( TraceLog::Event::VncProxyForwardToClient, clientProtocol().lastMessage().size(),
+						  clientProtocol().lastMessageType() );
+
 		m_proxyClientSocket->write( clientProtocol().lastMessage() );
 
+		if( clientProtocol().lastMessageType() == rfbFramebufferUpdate )
+		{
+			++m_framebufferUpdateCount;
+			m_continuousUpdateRequested = false;
+
+			if( m_continuousUpdatesEnabled )
+			{
+				sendFenceRequest();
+				requestContinuousUpdate();
+			}
+		}
+
 		return true;
 	}
 
 	return false;
 }
+
+
+
+bool VncProxyConnection::receiveSetEncodingsMessage()
+{
+	auto socket = proxyClientSocket();
+
+	rfbSetEncodingsMsg setEncodingsMessage;
+	if( socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) != sz_rfbSetEncodingsMsg )
+	{
+		return false;
+	}
+
+	const auto nEncodings = qFromBigEndian(setEncodingsMessage.nEncodings);
+	if( nEncodings > MAX_ENCODINGS )
+	{
+		vCritical() << "received too many encodings from client";
+		socket->close();
+		return false;
+	}
+
+	const qint64 messageSize = sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t);
+	if( socket->bytesAvailable() < messageSize )
+	{
+		return false;
+	}
+
+	const auto message = socket->read( messageSize ); // Flawfinder: ignore
+	if( message.size() != messageSize )
+	{
+		return false;
+	}
+
+	// strip pseudo encodings of extensions implemented by the proxy itself so the VNC server
+	// never sends messages the proxy is not able to parse
+	QVector<uint32_t> encodings;
+	encodings.reserve( nEncodings );
+
+	bool continuousUpdatesRequested = false;
+	bool fenceRequested = false;
+
+	for( int i = 0; i < nEncodings; ++i )
+	{
+		const auto encoding = qFromBigEndian<uint32_t>( reinterpret_cast<const uchar *>( message.constData() ) +
+														sz_rfbSetEncodingsMsg + i * sizeof(uint32_t) );
+		switch( int32_t( encoding ) )
+		{
+		case RfbExtensions::EncodingContinuousUpdates:
+			continuousUpdatesRequested = true;
+			break;
+		case RfbExtensions::EncodingFence:
+			fenceRequested = true;
+			break;
+		default:
+			encodings.append( encoding );
+			break;
+		}
+	}
+
+	if( clientProtocol().setEncodings( encodings ) == false )
+	{
+		return false;
+	}
+
+	// announce support for continuous updates once - we rely on fences for flow control
+	if( continuousUpdatesRequested && fenceRequested && m_clientSupportsContinuousUpdates == false )
+	{
+		m_clientSupportsContinuousUpdates = true;
+		sendEndOfContinuousUpdates();
+	}
+
+	return true;
+}
+
+
+
+bool VncProxyConnection::receiveFramebufferUpdateRequestMessage()
+{
+	auto socket = proxyClientSocket();
+
+	rfbFramebufferUpdateRequestMsg updateRequest;
+	if( socket->peek( reinterpret_cast<char *>( &updateRequest ), sz_rfbFramebufferUpdateRequestMsg ) !=
+		sz_rfbFramebufferUpdateRequestMsg )
+	{
+		return false;
+	}
+
+	// incremental updates are requested by the proxy itself while continuous updates are enabled
+	if( m_continuousUpdatesEnabled && updateRequest.incremental )
+	{
+		return socket->read( sz_rfbFramebufferUpdateRequestMsg ).size() == sz_rfbFramebufferUpdateRequestMsg; // Flawfinder: ignore
+	}
+
+	return forwardDataToServer( sz_rfbFramebufferUpdateRequestMsg );
+}
+
+
+
+bool VncProxyConnection::receiveEnableContinuousUpdatesMessage()
+{
+	auto socket = proxyClientSocket();
+
+	if( socket->bytesAvailable() < RfbExtensions::EnableContinuousUpdatesMessageSize )
+	{
+		return false;
+	}
+
+	// the update area is ignored and updates always cover the whole framebuffer
+	const auto message = socket->read( RfbExtensions::EnableContinuousUpdatesMessageSize ); // Flawfinder: ignore
+	if( message.size() != RfbExtensions::EnableContinuousUpdatesMessageSize )
+	{
+		return false;
+	}
+
+	if( m_clientSupportsContinuousUpdates == false )
+	{
+		vCritical() << "client enabled continuous updates without announcing support";
+		socket->close();
+		return false;
+	}
+
+	m_continuousUpdatesEnabled = message.at( 1 ) != 0;
+
+	if( m_continuousUpdatesEnabled )
+	{
+		requestContinuousUpdate();
+	}
+	else
+	{
+		sendEndOfContinuousUpdates();
+	}
+
+	return true;
+}
+
+
+
+bool VncProxyConnection::receiveFenceMessage()
+{
+	auto socket = proxyClientSocket();
+
+	const auto header = socket->peek( RfbExtensions::FenceMessageHeaderSize );
+	if( header.size() != RfbExtensions::FenceMessageHeaderSize )
+	{
+		return false;
+	}
+
+	const auto payloadLength = int( uint8_t( header.at( RfbExtensions::FenceMessageHeaderSize - 1 ) ) );
+	if( payloadLength > RfbExtensions::FenceMaximumPayloadSize )
+	{
+		vCritical() << "invalid fence payload length" << payloadLength;
+		socket->close();
+		return false;
+	}
+
+	const auto messageSize = RfbExtensions::FenceMessageHeaderSize + payloadLength;
+	if( socket->bytesAvailable() < messageSize )
+	{
+		return false;
+	}
+
+	auto message = socket->read( messageSize ); // Flawfinder: ignore
+	if( message.size() != messageSize )
+	{
+		return false;
+	}
+
+	const auto flags = qFromBigEndian<uint32_t>( reinterpret_cast<const uchar *>( message.constData() ) + 4 );
+
+	if( flags & RfbExtensions::FenceFlagRequest )
+	{
+		// messages are forwarded to the client in order so the request can be answered immediately
+		qToBigEndian<uint32_t>( flags & RfbExtensions::FenceFlagsSupported & ~RfbExtensions::FenceFlagRequest,
+								reinterpret_cast<uchar *>( message.data() ) + 4 );
+		m_proxyClientSocket->write( message );
+	}
+	else if( m_pendingFenceCount > 0 )
+	{
+		// client has processed all updates sent before the fence
+		--m_pendingFenceCount;
+		requestContinuousUpdate();
+	}
+
+	return true;
+}
+
+
+
+void VncProxyConnection::sendEndOfContinuousUpdates()
+{
+	const char message = char( RfbExtensions::EndOfContinuousUpdatesMessage );
+	m_proxyClientSocket->write( &message, sizeof(message) );
+}
+
+
+
+void VncProxyConnection::sendFenceRequest()
+{
+	QByteArray message( RfbExtensions::FenceMessageHeaderSize, 0 );
+	message[0] = char( RfbExtensions::FenceMessage );
+	qToBigEndian<uint32_t>( RfbExtensions::FenceFlagRequest | RfbExtensions::FenceFlagBlockBefore,
+							reinterpret_cast<uchar *>( message.data() ) + 4 );
+
+	m_proxyClientSocket->write( message );
+
+	++m_pendingFenceCount;
+}
+
+
+
+void VncProxyConnection::requestContinuousUpdate()
+{
+	if( m_continuousUpdatesEnabled == false ||
+		m_continuousUpdateRequested ||
+		m_pendingFenceCount >= MaximumPendingFences )
+	{
+		return;
+	}
+
+	clientProtocol().requestFramebufferUpdate( true );
+	m_continuousUpdateRequested = true;
+}
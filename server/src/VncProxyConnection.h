@@ -51,6 +51,21 @@ public:
 		return m_vncServerSocket;
 	}
 
+	qint64 bytesSentToClient() const
+	{
+		return m_bytesSentToClient;
+	}
+
+	qint64 bytesSentToServer() const
+	{
+		return m_bytesSentToServer;
+	}
+
+	qint64 framebufferUpdateCount() const
+	{
+		return m_framebufferUpdateCount;
+	}
+
 protected Q_SLOTS:
 	void readFromClient();
 	void readFromServer();
@@ -69,7 +84,17 @@ protected:
 	virtual VncServerProtocol& serverProtocol() = 0;
 
 private:
+	bool receiveSetEncodingsMessage();
+	bool receiveFramebufferUpdateRequestMessage();
+	bool receiveEnableContinuousUpdatesMessage();
+	bool receiveFenceMessage();
+
+	void sendEndOfContinuousUpdates();
+	void sendFenceRequest();
+	void requestContinuousUpdate();
+
 	static constexpr int ProtocolRetryTime = 250;
+	static constexpr int MaximumPendingFences = 2;
 
 	const int m_vncServerPort;
 
@@ -78,6 +103,19 @@ private:
 
 	const QMap<int, int> m_rfbClientToServerMessageSizes;
 
+	// continuous updates: framebuffer updates are requested from the VNC server by the proxy itself
+	// as soon as the previous one has been forwarded while fences sent to the client limit the number
+	// of updates which have not been processed by the client yet
+	bool m_clientSupportsContinuousUpdates{false};
+	bool m_continuousUpdatesEnabled{false};
+	bool m_continuousUpdateRequested{false};
+	int m_pendingFenceCount{0};
+
+	// traffic counters for server metrics
+	qint64 m_bytesSentToClient{0};
+	qint64 m_bytesSentToServer{0};
+	qint64 m_framebufferUpdateCount{0};
+
 Q_SIGNALS:
 	void clientConnectionClosed();
 	void serverConnectionClosed();
@@ -87,6 +87,13 @@ void VncProxyServer::stop()
 
 
 
+quint16 VncProxyServer::serverPort() const
+{
+	return m_server ? m_server->serverPort() : 0;
+}
+
+
+
 void VncProxyServer::acceptConnection()
 {
 	auto clientSocket = m_server->nextPendingConnection();
@@ -113,7 +120,11 @@ void VncProxyServer::acceptConnection()
 
 void VncProxyServer::closeConnection( VncProxyConnection* connection )
 {
-	m_connections.removeAll( connection );
+	// connections are closed once by whichever side disconnects first
+	if( m_connections.removeAll( connection ) == 0 )
+	{
+		return;
+	}
 
 	Q_EMIT connectionClosed( connection );
 
@@ -49,6 +49,8 @@ public:
 	bool start( int vncServerPort, const Password& vncServerPassword );
 	void stop();
 
+	quint16 serverPort() const;
+
 	const VncProxyConnectionList& clients() const
 	{
 		return m_connections;
@@ -23,6 +23,7 @@
  */
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QHostAddress>
 
 #include "FeatureManager.h"
@@ -56,6 +57,17 @@ FeatureWorkerManagerConnection::FeatureWorkerManagerConnection( VeyonWorkerInter
 
 
 
+FeatureWorkerManagerConnection::FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
+																FeatureManager& featureManager,
+																FeatureWorkerManager::WorkerType standbyWorkerType,
+																QObject* parent ) :
+	FeatureWorkerManagerConnection( worker, featureManager, Feature::Uid(), parent )
+{
+	m_standbyWorkerType = standbyWorkerType;
+}
+
+
+
 bool FeatureWorkerManagerConnection::sendMessage( const FeatureMessage& message )
 {
 	return message.send( &m_socket );
@@ -84,7 +96,16 @@ void FeatureWorkerManagerConnection::sendInitMessage()
 
 	m_connectTimer.stop();
 
-	FeatureMessage( m_featureUid, FeatureMessage::InitCommand ).send( &m_socket );
+	FeatureMessage initMessage( m_featureUid, FeatureMessage::InitCommand );
+
+	if( m_featureUid.isNull() )
+	{
+		// announce ourselves as standby worker which gets assigned a feature later
+		initMessage.addArgument( FeatureWorkerManager::StandbyWorkerArgument::WorkerType,
+								 static_cast<int>( m_standbyWorkerType ) );
+	}
+
+	initMessage.send( &m_socket );
 }
 
 
@@ -97,7 +118,21 @@ void FeatureWorkerManagerConnection::receiveMessage()
 	{
 		if( featureMessage.receive( &m_socket ) )
 		{
+			if( m_featureUid.isNull() && featureMessage.command() == FeatureMessage::InitCommand )
+			{
+				vDebug() << "assigned to feature" << featureMessage.featureUid();
+				m_featureUid = featureMessage.featureUid();
+				Q_EMIT featureAssigned( m_featureUid );
+				continue;
+			}
+
+			QElapsedTimer handleTimer;
+			handleTimer.start();
+
 			m_featureManager.handleFeatureMessage( m_worker, featureMessage );
+
+			vDebug() << "handled message for feature" << featureMessage.featureUid()
+					 << "in" << handleTimer.elapsed() << "ms";
 		}
 	}
 }
@@ -28,6 +28,7 @@
 #include <QTimer>
 
 #include "Feature.h"
+#include "FeatureWorkerManager.h"
 
 class FeatureManager;
 class FeatureMessage;
@@ -41,10 +42,16 @@ public:
 									FeatureManager& featureManager,
 									Feature::Uid featureUid,
 									QObject* parent = nullptr );
-
+	FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
+									FeatureManager& featureManager,
+									FeatureWorkerManager::WorkerType standbyWorkerType,
+									QObject* parent = nullptr );
 
 	bool sendMessage( const FeatureMessage& message );
 
+Q_SIGNALS:
+	void featureAssigned( Feature::Uid featureUid );
+
 private:
 	static constexpr auto ConnectTimeout = 3000;
 
@@ -56,6 +63,7 @@ private:
 	FeatureManager& m_featureManager;
 	QTcpSocket m_socket;
 	Feature::Uid m_featureUid;
+	FeatureWorkerManager::WorkerType m_standbyWorkerType{FeatureWorkerManager::WorkerType::ManagedSystem};
 	QTimer m_connectTimer{this};
 
 } ;
@@ -34,6 +34,41 @@ VeyonWorker::VeyonWorker( const QString& featureUid, QObject* parent ) :
 	m_core( QCoreApplication::instance(),
 			VeyonCore::Component::Worker,
 			QStringLiteral( "FeatureWorker-" ) + VeyonCore::formattedUuid( featureUid ) )
+{
+	if( initFeature( featureUid ) == false )
+	{
+		qFatal( "Could not initialize worker for specified feature" );
+	}
+
+	m_workerManagerConnection = new FeatureWorkerManagerConnection( *this, m_featureManager, featureUid, this );
+}
+
+
+
+VeyonWorker::VeyonWorker( FeatureWorkerManager::WorkerType standbyWorkerType, QObject* parent ) :
+	QObject( parent ),
+	m_core( QCoreApplication::instance(),
+			VeyonCore::Component::Worker,
+			QStringLiteral( "FeatureWorker-Standby" ) )
+{
+	m_workerManagerConnection = new FeatureWorkerManagerConnection( *this, m_featureManager, standbyWorkerType, this );
+
+	connect( m_workerManagerConnection, &FeatureWorkerManagerConnection::featureAssigned,
+			 this, &VeyonWorker::assignFeature );
+
+	vInfo() << "Running standby worker";
+}
+
+
+
+bool VeyonWorker::sendFeatureMessageReply( const FeatureMessage& reply )
+{
+	return m_workerManagerConnection->sendMessage( reply );
+}
+
+
+
+bool VeyonWorker::initFeature( Feature::Uid featureUid )
 {
 	const Feature* workerFeature = nullptr;
 
@@ -47,22 +82,27 @@ VeyonWorker::VeyonWorker( const QString& featureUid, QObject* parent ) :
 
 	if( workerFeature == nullptr )
 	{
-		qFatal( "Could not find specified feature" );
+		vCritical() << "Could not find specified feature" << featureUid;
+		return false;
 	}
 
-	if( VeyonCore::config().disabledFeatures().contains( featureUid ) )
+	if( VeyonCore::config().disabledFeatures().contains( featureUid.toString() ) )
 	{
-		qFatal( "Specified feature is disabled by configuration!" );
+		vCritical() << "Specified feature is disabled by configuration!";
+		return false;
 	}
 
-	m_workerManagerConnection = new FeatureWorkerManagerConnection( *this, m_featureManager, featureUid, this );
-
 	vInfo() << "Running worker for feature" << workerFeature->name();
+
+	return true;
 }
 
 
 
-bool VeyonWorker::sendFeatureMessageReply( const FeatureMessage& reply )
+void VeyonWorker::assignFeature( Feature::Uid featureUid )
 {
-	return m_workerManagerConnection->sendMessage( reply );
+	if( initFeature( featureUid ) == false )
+	{
+		QCoreApplication::quit();
+	}
 }
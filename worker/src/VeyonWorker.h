@@ -25,6 +25,7 @@
 #pragma once
 
 #include "FeatureManager.h"
+#include "FeatureWorkerManager.h"
 #include "VeyonWorkerInterface.h"
 
 class FeatureWorkerManagerConnection;
@@ -34,6 +35,7 @@ class VeyonWorker : public QObject, VeyonWorkerInterface
 	Q_OBJECT
 public:
 	explicit VeyonWorker( const QString& featureUid, QObject* parent = nullptr );
+	explicit VeyonWorker( FeatureWorkerManager::WorkerType standbyWorkerType, QObject* parent = nullptr );
 
 	bool sendFeatureMessageReply( const FeatureMessage& reply ) override;
 
@@ -43,6 +45,9 @@ public:
 	}
 
 private:
+	bool initFeature( Feature::Uid featureUid );
+	void assignFeature( Feature::Uid featureUid );
+
 	VeyonCore m_core;
 	FeatureManager m_featureManager{};
 	FeatureWorkerManagerConnection* m_workerManagerConnection{nullptr};